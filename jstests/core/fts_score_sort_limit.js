@@ -0,0 +1,132 @@
+// Cannot implicitly shard accessed collections because of extra shard key index in sharded
+// collection.
+// @tags: [assumes_no_implicit_index_creation]
+
+// A $text query sorted by the text score and limited to k documents only reads as much of the
+// index as the top k need. Check that it returns the same documents with the same scores as the
+// unlimited query.
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");
+
+    const coll = db.fts_score_sort_limit;
+    coll.drop();
+
+    // The frequencies of the terms vary independently of each other and of the length of the
+    // document, so that the documents scoring highest for one term are not those scoring highest
+    // for another. Pruning then leaves candidates that were only seen for some of the terms.
+    const nDocs = 300;
+    let bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < nDocs; ++i) {
+        let words = [];
+        for (let j = 0; j < i % 7; ++j) {
+            words.push("alpha");
+        }
+        for (let j = 0; j < (i * 3) % 11; ++j) {
+            words.push("beta");
+        }
+        if (i % 5 === 0) {
+            words.push("gamma");
+        }
+        for (let j = 0; j < (i * 7) % 13; ++j) {
+            words.push("filler");
+        }
+        bulk.insert({_id: i, category: i % 3, rank: i % 10, tag: i % 4, body: words.join(" ")});
+    }
+    assert.writeOK(bulk.execute());
+    assert.commandWorked(coll.createIndex({body: "text"}));
+
+    // Returns the documents matching 'filter' with their scores, best first, evaluated in full.
+    function fullResults(filter) {
+        return coll.find(filter, {score: {$meta: "textScore"}})
+            .sort({score: {$meta: "textScore"}})
+            .toArray();
+    }
+
+    // The scores of a document's terms may be added up in a different order, so they can differ
+    // in the last bits.
+    function assertSameScore(actual, expected, msg) {
+        assert.lte(Math.abs(actual - expected), 1e-9 * Math.abs(expected), msg);
+    }
+
+    // Runs 'filter' with 'skip' and 'limit' and checks it against the unlimited query: the scores
+    // must be the same, and so must the documents except where several have the same score.
+    function assertSameAsFullEvaluation(filter, skip, limit) {
+        const full = fullResults(filter);
+        const fullScores = {};
+        full.forEach(doc => fullScores[doc._id] = doc.score);
+
+        const expected = full.slice(skip, skip + limit);
+        const results = coll.find(filter, {score: {$meta: "textScore"}})
+                            .sort({score: {$meta: "textScore"}})
+                            .skip(skip)
+                            .limit(limit)
+                            .toArray();
+        assert.eq(results.length, expected.length, tojson(results));
+        for (let i = 0; i < results.length; ++i) {
+            assertSameScore(results[i].score, expected[i].score, tojson(results));
+            assertSameScore(results[i].score, fullScores[results[i]._id], tojson(results[i]));
+        }
+        return results;
+    }
+
+    // Returns the TEXT_OR stage of the execution of 'filter' with 'skip' and 'limit'.
+    function getTextOrStage(filter, skip, limit) {
+        const explain = coll.find(filter, {score: {$meta: "textScore"}})
+                            .sort({score: {$meta: "textScore"}})
+                            .skip(skip)
+                            .limit(limit)
+                            .explain("executionStats");
+        const stage = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+        assert.neq(stage, null, tojson(explain));
+        return stage;
+    }
+
+    // A single term.
+    assertSameAsFullEvaluation({$text: {$search: "alpha"}}, 0, 5);
+
+    // Several terms, so that some candidates are scored from the document itself.
+    const multiTerm = {$text: {$search: "alpha beta gamma"}};
+    for (let limit of [1, 5, 20]) {
+        assertSameAsFullEvaluation(multiTerm, 0, limit);
+    }
+    assert.eq(getTextOrStage(multiTerm, 0, 5).topK, 5);
+
+    // With a skip, the top skip + limit documents are kept.
+    assertSameAsFullEvaluation(multiTerm, 10, 5);
+    assertSameAsFullEvaluation(multiTerm, 3, 1);
+    assert.eq(getTextOrStage(multiTerm, 10, 5).topK, 15);
+
+    // Fewer matches than the limit, with and without a skip past them.
+    const rare = {$text: {$search: "gamma"}};
+    const nRare = fullResults(rare).length;
+    assert.eq(nRare, nDocs / 5);
+    assert.eq(assertSameAsFullEvaluation(rare, 0, nRare + 10).length, nRare);
+    assert.eq(assertSameAsFullEvaluation(rare, nRare - 2, 10).length, 2);
+    assert.eq(assertSameAsFullEvaluation(rare, nRare + 1, 10).length, 0);
+
+    // A predicate on a field outside of the index is applied above the TEXT stage, which then
+    // returns all of its documents.
+    assertSameAsFullEvaluation({$text: {$search: "alpha beta"}, tag: 1}, 0, 5);
+    assertSameAsFullEvaluation({$text: {$search: "alpha beta"}, tag: 1}, 4, 5);
+
+    // A compound text index: the equality on the prefix bounds the index scans, and the
+    // predicate on the suffix is applied to the index keys by TEXT_OR.
+    assert.commandWorked(coll.dropIndexes());
+    assert.commandWorked(coll.createIndex({category: 1, body: "text", rank: 1}));
+
+    const prefixOnly = {category: 1, $text: {$search: "alpha beta gamma"}};
+    assertSameAsFullEvaluation(prefixOnly, 0, 5);
+    assertSameAsFullEvaluation(prefixOnly, 5, 5);
+    assert.eq(getTextOrStage(prefixOnly, 0, 5).topK, 5);
+
+    const withSuffix = {category: 2, rank: {$gte: 5}, $text: {$search: "alpha beta gamma"}};
+    for (let doc of fullResults(withSuffix)) {
+        assert.eq(doc.category, 2, tojson(doc));
+        assert.gte(doc.rank, 5, tojson(doc));
+    }
+    assertSameAsFullEvaluation(withSuffix, 0, 5);
+    assertSameAsFullEvaluation(withSuffix, 2, 3);
+    assert.eq(getTextOrStage(withSuffix, 0, 5).topK, 5);
+})();
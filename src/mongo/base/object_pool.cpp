@@ -0,0 +1,73 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/base/object_pool.h"
+
+#include <boost/core/demangle.hpp>
+
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+namespace {
+
+struct ObjectPoolRegistry {
+    stdx::mutex mutex;
+    std::vector<const ObjectPoolStats*> pools;
+};
+
+ObjectPoolRegistry& registry() {
+    // Leaked, like the stats it points to, so that threads exiting during shutdown can still
+    // publish their counters.
+    static ObjectPoolRegistry* registry = new ObjectPoolRegistry();
+    return *registry;
+}
+
+}  // namespace
+
+ObjectPoolStats::ObjectPoolStats(const std::type_info& type)
+    : _name(boost::core::demangle(type.name())) {
+    auto& reg = registry();
+    stdx::lock_guard<stdx::mutex> lk(reg.mutex);
+    reg.pools.push_back(this);
+}
+
+void ObjectPoolStats::append(BSONObjBuilder* bob) const {
+    BSONObjBuilder section(bob->subobjStart(_name));
+    section.appendNumber("hits", hits.load());
+    section.appendNumber("depotHits", depotHits.load());
+    section.appendNumber("misses", misses.load());
+    section.appendNumber("returned", returned.load());
+    section.appendNumber("depotReturned", depotReturned.load());
+    section.appendNumber("discarded", discarded.load());
+    section.appendNumber("trimmed", trimmed.load());
+    section.appendNumber("pooledObjects", pooledObjects.load());
+    section.appendNumber("pooledBytes", pooledBytes.load());
+    section.doneFast();
+}
+
+void ObjectPoolStats::appendAll(BSONObjBuilder* bob) {
+    auto& reg = registry();
+    stdx::lock_guard<stdx::mutex> lk(reg.mutex);
+    for (auto stats : reg.pools) {
+        stats->append(bob);
+    }
+}
+
+}  // namespace mongo
@@ -1,17 +1,89 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
-#include <stack>
+#include <string>
+#include <typeinfo>
 #include <vector>
 
 #include "mongo/db/modules/eloq/tx_service/include/circular_queue.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
 
 namespace mongo {
+class BSONObjBuilder;
+
 template <typename T>
 void deinit(T* ptr) {}
 
+/**
+ * Limits that bound how much memory ObjectPool<T> keeps idle. Specialize ObjectPoolTraits for
+ * a type (deriving from DefaultObjectPoolTraits) before its first use to change them.
+ */
+struct DefaultObjectPoolTraits {
+    // Maximum number of idle objects a thread keeps.
+    static constexpr size_t kMaxPoolSize = 256;
+    // Maximum memory, as reported by retainedBytes(), of the idle objects a thread keeps.
+    static constexpr size_t kMaxPoolBytes = 4 * 1024 * 1024;
+    // Objects retaining more than this are freed rather than pooled.
+    static constexpr size_t kMaxObjectBytes = 256 * 1024;
+    // Capacity of the process-wide depot. Objects that do not fit into the pool of the thread
+    // releasing them are parked there and handed out to threads whose pool is empty, which keeps
+    // types that are usually freed on another thread (or ThreadGroup) than the one that created
+    // them from piling up on one side. Zero disables the depot.
+    static constexpr size_t kMaxDepotSize = 0;
+};
+
+template <typename T>
+struct ObjectPoolTraits : DefaultObjectPoolTraits {
+    /**
+     * Memory held by an idle object, including anything it keeps allocated after deinit().
+     */
+    static size_t retainedBytes(const T& obj) {
+        return sizeof(T);
+    }
+};
+
+/**
+ * Process-wide counters of one ObjectPool<T> instantiation. Threads accumulate their counts
+ * locally and publish them periodically, so the values can lag slightly behind.
+ */
+class ObjectPoolStats {
+public:
+    explicit ObjectPoolStats(const std::type_info& type);
+
+    ObjectPoolStats(const ObjectPoolStats&) = delete;
+    ObjectPoolStats& operator=(const ObjectPoolStats&) = delete;
+
+    const std::string& name() const {
+        return _name;
+    }
+
+    void append(BSONObjBuilder* bob) const;
+
+    /**
+     * Appends the counters of every pool that has been used so far, keyed by type name.
+     */
+    static void appendAll(BSONObjBuilder* bob);
+
+    AtomicInt64 hits;           // served from the calling thread's pool
+    AtomicInt64 depotHits;      // served from the depot
+    AtomicInt64 misses;         // newly allocated
+    AtomicInt64 returned;       // kept in the releasing thread's pool
+    AtomicInt64 depotReturned;  // parked in the depot
+    AtomicInt64 discarded;      // freed on release because every pool was full
+    AtomicInt64 trimmed;        // freed because they stayed idle for a whole trim interval
+    AtomicInt64 pooledObjects;
+    AtomicInt64 pooledBytes;
+
+private:
+    const std::string _name;
+};
+
 template <typename T>
 class ObjectPool {
+    using Traits = ObjectPoolTraits<T>;
+
 public:
     ObjectPool() = default;
     ~ObjectPool() = default;
@@ -21,8 +93,7 @@ public:
     class Deleter {
     public:
         void operator()(T* ptr) {
-            deinit(ptr);
-            _localPool.Enqueue(std::unique_ptr<T>(ptr));
+            _release(ptr);
         }
     };
 
@@ -32,51 +103,23 @@ public:
     */
     template <typename Base>
     static void PolyDeleter(Base* ptr) {
-        T* dptr = static_cast<T*>(ptr);
-        deinit(dptr);
-        _localPool.Enqueue(std::unique_ptr<T>(dptr));
+        _release(static_cast<T*>(ptr));
     }
 
     template <typename... Args>
     static std::unique_ptr<T, Deleter> newObject(Args&&... args) {
-        T* ptr{nullptr};
-
-        if (_localPool.Size() == 0) {
-            ptr = new T(std::forward<Args>(args)...);
-        } else {
-            ptr = _localPool.Peek().release();
-            _localPool.Dequeue();
-            ptr->reset(std::forward<Args>(args)...);
-        }
-        return std::unique_ptr<T, Deleter>(ptr);
+        return std::unique_ptr<T, Deleter>(_acquire(std::forward<Args>(args)...));
     }
 
     template <typename Base, typename... Args>
     static std::unique_ptr<Base, void (*)(Base*)> newObject(Args&&... args) {
-        T* ptr{nullptr};
-
-        if (_localPool.Size() == 0) {
-            ptr = new T(std::forward<Args>(args)...);
-        } else {
-            ptr = _localPool.Peek().release();
-            _localPool.Dequeue();
-            ptr->reset(std::forward<Args>(args)...);
-        }
-        return std::unique_ptr<Base, void (*)(Base*)>(ptr, &PolyDeleter<Base>);
+        return std::unique_ptr<Base, void (*)(Base*)>(_acquire(std::forward<Args>(args)...),
+                                                      &PolyDeleter<Base>);
     }
 
     template <typename... Args>
     static std::shared_ptr<T> newObjectSharedPointer(Args&&... args) {
-        T* ptr{nullptr};
-
-        if (_localPool.Size() == 0) {
-            ptr = new T(std::forward<Args>(args)...);
-        } else {
-            ptr = _localPool.Peek().release();
-            _localPool.Dequeue();
-            ptr->reset(std::forward<Args>(args)...);
-        }
-        return std::shared_ptr<T>(ptr, Deleter());
+        return std::shared_ptr<T>(_acquire(std::forward<Args>(args)...), Deleter());
     }
 
     /*
@@ -87,16 +130,7 @@ public:
     */
     template <typename... Args>
     static T* newObjectRawPointer(Args&&... args) {
-        T* ptr{nullptr};
-
-        if (_localPool.Size() == 0) {
-            ptr = new T(std::forward<Args>(args)...);
-        } else {
-            ptr = _localPool.Peek().release();
-            _localPool.Dequeue();
-            ptr->reset(std::forward<Args>(args)...);
-        }
-        return ptr;
+        return _acquire(std::forward<Args>(args)...);
     }
 
     /*
@@ -104,129 +138,204 @@ public:
       need call this function to recycle object manually.
     */
     static void recycleObject(T* ptr) {
-        deinit(ptr);
-        _localPool.Enqueue(std::unique_ptr<T>(ptr));
+        _release(ptr);
     }
 
     static size_t poolSize() {
-        return _localPool.Size();
+        return _localPool.objects.Size();
+    }
+
+    /**
+     * Frees every object pooled by the calling thread and publishes its counters.
+     */
+    static void clearLocalPool() {
+        _localPool.clear();
+        _localPool.flushStats();
+    }
+
+    static ObjectPoolStats& stats() {
+        // Intentionally leaked: thread-local pools publish into it during thread exit.
+        static ObjectPoolStats* stats = new ObjectPoolStats(typeid(T));
+        return *stats;
     }
 
+    // Every kMaintenanceInterval operations a thread publishes its counters and frees half of
+    // the objects that stayed idle since the previous maintenance.
+    static constexpr uint32_t kMaintenanceInterval{1024};
+
 private:
-    static constexpr size_t kDefaultCapacity{32};
-    static thread_local CircularQueue<std::unique_ptr<T>> _localPool;
+    struct Entry {
+        std::unique_ptr<T> object;
+        size_t bytes;
+    };
+
+    struct LocalPool {
+        ~LocalPool() {
+            clear();
+            flushStats();
+        }
+
+        T* pop() {
+            auto& entry = objects.Peek();
+            T* ptr = entry.object.release();
+            bytes -= entry.bytes;
+            pooledBytesDelta -= entry.bytes;
+            --pooledObjectsDelta;
+            objects.Dequeue();
+            lowWater = std::min(lowWater, objects.Size());
+            return ptr;
+        }
+
+        void push(T* ptr, size_t objectBytes) {
+            objects.Enqueue(Entry{std::unique_ptr<T>(ptr), objectBytes});
+            bytes += objectBytes;
+            pooledBytesDelta += objectBytes;
+            ++pooledObjectsDelta;
+        }
+
+        void trim(size_t count) {
+            for (size_t i = 0; i < count && objects.Size() > 0; ++i) {
+                delete pop();
+                ++trimmed;
+            }
+        }
+
+        void clear() {
+            trim(objects.Size());
+            lowWater = 0;
+            ops = 0;
+        }
+
+        void tick() {
+            if (++ops < kMaintenanceInterval) {
+                return;
+            }
+            ops = 0;
+            trim(lowWater / 2);
+            lowWater = objects.Size();
+            flushStats();
+        }
+
+        void flushStats() {
+            auto& s = stats();
+            auto publish = [](AtomicInt64& counter, long long& local) {
+                if (local) {
+                    counter.fetchAndAdd(local);
+                    local = 0;
+                }
+            };
+            publish(s.hits, hits);
+            publish(s.depotHits, depotHits);
+            publish(s.misses, misses);
+            publish(s.returned, returned);
+            publish(s.depotReturned, depotReturned);
+            publish(s.discarded, discarded);
+            publish(s.trimmed, trimmed);
+            publish(s.pooledObjects, pooledObjectsDelta);
+            publish(s.pooledBytes, pooledBytesDelta);
+        }
+
+        CircularQueue<Entry> objects;
+        size_t bytes{0};
+        // Smallest pool size seen since the last maintenance; that many objects went unused.
+        size_t lowWater{0};
+        uint32_t ops{0};
+
+        long long hits{0};
+        long long depotHits{0};
+        long long misses{0};
+        long long returned{0};
+        long long depotReturned{0};
+        long long discarded{0};
+        long long trimmed{0};
+        long long pooledObjectsDelta{0};
+        long long pooledBytesDelta{0};
+    };
+
+    struct Depot {
+        stdx::mutex mutex;
+        std::vector<std::unique_ptr<T>> objects;
+    };
+
+    static Depot& _depot() {
+        static Depot* depot = new Depot();
+        return *depot;
+    }
+
+    static T* _takeFromDepot() {
+        if (Traits::kMaxDepotSize == 0) {
+            return nullptr;
+        }
+        auto& depot = _depot();
+        stdx::lock_guard<stdx::mutex> lk(depot.mutex);
+        if (depot.objects.empty()) {
+            return nullptr;
+        }
+        T* ptr = depot.objects.back().release();
+        depot.objects.pop_back();
+        return ptr;
+    }
+
+    static bool _returnToDepot(T* ptr) {
+        if (Traits::kMaxDepotSize == 0) {
+            return false;
+        }
+        auto& depot = _depot();
+        stdx::lock_guard<stdx::mutex> lk(depot.mutex);
+        if (depot.objects.size() >= Traits::kMaxDepotSize) {
+            return false;
+        }
+        depot.objects.emplace_back(ptr);
+        return true;
+    }
+
+    template <typename... Args>
+    static T* _acquire(Args&&... args) {
+        auto& pool = _localPool;
+        T* ptr{nullptr};
+
+        if (pool.objects.Size() > 0) {
+            ptr = pool.pop();
+            ++pool.hits;
+        } else if ((ptr = _takeFromDepot())) {
+            ++pool.depotHits;
+        } else {
+            ++pool.misses;
+        }
+        pool.tick();
+
+        if (!ptr) {
+            return new T(std::forward<Args>(args)...);
+        }
+        ptr->reset(std::forward<Args>(args)...);
+        return ptr;
+    }
+
+    static void _release(T* ptr) {
+        deinit(ptr);
+
+        auto& pool = _localPool;
+        const size_t bytes = Traits::retainedBytes(*ptr);
+        if (bytes > Traits::kMaxObjectBytes) {
+            delete ptr;
+            ++pool.discarded;
+        } else if (pool.objects.Size() < Traits::kMaxPoolSize &&
+                   pool.bytes + bytes <= Traits::kMaxPoolBytes) {
+            pool.push(ptr, bytes);
+            ++pool.returned;
+        } else if (_returnToDepot(ptr)) {
+            ++pool.depotReturned;
+        } else {
+            delete ptr;
+            ++pool.discarded;
+        }
+        pool.tick();
+    }
+
+    static thread_local LocalPool _localPool;
 };
 
 template <typename T>
-thread_local CircularQueue<std::unique_ptr<T>> ObjectPool<T>::_localPool = {};
+thread_local typename ObjectPool<T>::LocalPool ObjectPool<T>::_localPool = {};
 
 }  // namespace mongo
-
-
-// namespace mongo {
-// template <typename T>
-// class ObjectPool {
-// public:
-//     ObjectPool() = default;
-//     ~ObjectPool() = default;
-//     ObjectPool(const ObjectPool&) = delete;
-//     ObjectPool(ObjectPool&&) = delete;
-
-//     class Deleter {
-//     public:
-//         void operator()(T* ptr) {
-//             _localPool.push(std::unique_ptr<T>(ptr));
-//         }
-//     };
-
-//     /*
-//       Implicitly convert type for classes which need a polymorphism Deleter.
-//       For example, RecoveryUnit and EloqRecoveryUnit
-//     */
-//     template <typename Base>
-//     static void PolyDeleter(Base* ptr) {
-//         _localPool.push(std::unique_ptr<T>(static_cast<T*>(ptr)));
-//     }
-
-//     template <typename... Args>
-//     static std::unique_ptr<T, Deleter> newObject(Args&&... args) {
-//         T* ptr{nullptr};
-
-//         if (_localPool.empty()) {
-//             ptr = new T(std::forward<Args>(args)...);
-//         } else {
-//             ptr = _localPool.top().release();
-//             _localPool.pop();
-//             ptr->reset(std::forward<Args>(args)...);
-//         }
-//         return std::unique_ptr<T, Deleter>(ptr);
-//     }
-
-//     template <typename Base, typename... Args>
-//     static std::unique_ptr<Base, void (*)(Base*)> newObject(Args&&... args) {
-//         T* ptr{nullptr};
-
-//         if (_localPool.empty()) {
-//             ptr = new T(std::forward<Args>(args)...);
-//         } else {
-//             ptr = _localPool.top().release();
-//             _localPool.pop();
-//             ptr->reset(std::forward<Args>(args)...);
-//         }
-//         return std::unique_ptr<Base, void (*)(Base*)>(ptr, &PolyDeleter<Base>);
-//     }
-
-//     template <typename... Args>
-//     static std::shared_ptr<T> newObjectSharedPointer(Args&&... args) {
-//         T* ptr{nullptr};
-
-//         if (_localPool.empty()) {
-//             ptr = new T(std::forward<Args>(args)...);
-//         } else {
-//             ptr = _localPool.top().release();
-//             _localPool.pop();
-//             ptr->reset(std::forward<Args>(args)...);
-//         }
-//         return std::shared_ptr<T>(ptr, Deleter());
-//     }
-
-//     /*
-//       Some Mongo classes have owned custom deleter.
-//       We could modify their custom to reuse Object
-//       instead of returning std::unique_ptr<T, Deleter> when creation.
-//       For example, PlanExecutor
-//     */
-//     template <typename... Args>
-//     static T* newObjectRawPointer(Args&&... args) {
-//         T* ptr{nullptr};
-
-//         if (_localPool.empty()) {
-//             ptr = new T(std::forward<Args>(args)...);
-//         } else {
-//             ptr = _localPool.top().release();
-//             _localPool.pop();
-//             ptr->reset(std::forward<Args>(args)...);
-//         }
-//         return ptr;
-//     }
-
-//     /*
-//       Only class that allocate call newObjectRawPointer
-//       need call this function to recycle object manually.
-//     */
-//     static void recycleObject(T* ptr) {
-//         _localPool.push(std::unique_ptr<T>(ptr));
-//     }
-
-// private:
-//     static constexpr size_t kDefaultCapacity{32};
-//     static thread_local std::stack<std::unique_ptr<T>, std::vector<std::unique_ptr<T>>>
-//     _localPool;
-// };
-
-// template <typename T>
-// thread_local std::stack<std::unique_ptr<T>, std::vector<std::unique_ptr<T>>>
-// ObjectPool<T>::_localPool = {};
-
-
-// }  // namespace mongo
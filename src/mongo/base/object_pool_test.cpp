@@ -0,0 +1,219 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/base/object_pool.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+
+struct PooledWidget {
+    explicit PooledWidget(int v) : value(v) {}
+    void reset(int v) {
+        value = v;
+    }
+    int value;
+};
+
+struct SmallPoolWidget : PooledWidget {
+    using PooledWidget::PooledWidget;
+};
+
+struct SizedWidget : PooledWidget {
+    SizedWidget(int v, size_t retained) : PooledWidget(v), retained(retained) {}
+    void reset(int v, size_t r) {
+        value = v;
+        retained = r;
+    }
+    size_t retained;
+};
+
+struct DepotWidget : PooledWidget {
+    using PooledWidget::PooledWidget;
+};
+
+struct TrimWidget : PooledWidget {
+    using PooledWidget::PooledWidget;
+};
+
+template <>
+struct ObjectPoolTraits<SmallPoolWidget> : DefaultObjectPoolTraits {
+    static constexpr size_t kMaxPoolSize = 2;
+    static size_t retainedBytes(const SmallPoolWidget&) {
+        return sizeof(SmallPoolWidget);
+    }
+};
+
+template <>
+struct ObjectPoolTraits<SizedWidget> : DefaultObjectPoolTraits {
+    static constexpr size_t kMaxPoolBytes = 1000;
+    static constexpr size_t kMaxObjectBytes = 600;
+    static size_t retainedBytes(const SizedWidget& widget) {
+        return widget.retained;
+    }
+};
+
+template <>
+struct ObjectPoolTraits<DepotWidget> : DefaultObjectPoolTraits {
+    static constexpr size_t kMaxPoolSize = 1;
+    static constexpr size_t kMaxDepotSize = 1;
+    static size_t retainedBytes(const DepotWidget&) {
+        return sizeof(DepotWidget);
+    }
+};
+
+namespace {
+
+TEST(ObjectPoolTest, ReusesReleasedObjects) {
+    using Pool = ObjectPool<PooledWidget>;
+    Pool::clearLocalPool();
+    auto before = Pool::stats().hits.load();
+
+    PooledWidget* first;
+    {
+        auto widget = Pool::newObject(1);
+        first = widget.get();
+    }
+    ASSERT_EQ(Pool::poolSize(), 1U);
+
+    auto widget = Pool::newObject(2);
+    ASSERT_EQ(widget.get(), first);
+    ASSERT_EQ(widget->value, 2);
+    ASSERT_EQ(Pool::poolSize(), 0U);
+
+    Pool::clearLocalPool();
+    ASSERT_EQ(Pool::stats().hits.load() - before, 1);
+}
+
+TEST(ObjectPoolTest, PoolSizeIsCapped) {
+    using Pool = ObjectPool<SmallPoolWidget>;
+    Pool::clearLocalPool();
+    auto before = Pool::stats().discarded.load();
+
+    {
+        auto a = Pool::newObject(1);
+        auto b = Pool::newObject(2);
+        auto c = Pool::newObject(3);
+    }
+    ASSERT_EQ(Pool::poolSize(), 2U);
+
+    Pool::clearLocalPool();
+    ASSERT_EQ(Pool::stats().discarded.load() - before, 1);
+    ASSERT_EQ(Pool::stats().pooledObjects.load(), 0);
+}
+
+TEST(ObjectPoolTest, PoolBytesAreCapped) {
+    using Pool = ObjectPool<SizedWidget>;
+    Pool::clearLocalPool();
+
+    // Larger than kMaxObjectBytes: never pooled.
+    Pool::recycleObject(Pool::newObjectRawPointer(1, size_t(700)));
+    ASSERT_EQ(Pool::poolSize(), 0U);
+
+    Pool::recycleObject(Pool::newObjectRawPointer(2, size_t(500)));
+    ASSERT_EQ(Pool::poolSize(), 1U);
+
+    // Would exceed kMaxPoolBytes.
+    auto a = Pool::newObjectRawPointer(3, size_t(400));
+    auto b = Pool::newObjectRawPointer(4, size_t(600));
+    Pool::recycleObject(a);
+    Pool::recycleObject(b);
+    ASSERT_EQ(Pool::poolSize(), 1U);
+
+    Pool::clearLocalPool();
+    ASSERT_EQ(Pool::stats().pooledBytes.load(), 0);
+}
+
+TEST(ObjectPoolTest, SurplusMovesThroughDepot) {
+    using Pool = ObjectPool<DepotWidget>;
+    Pool::clearLocalPool();
+    auto beforeDepotHits = Pool::stats().depotHits.load();
+    auto beforeDepotReturned = Pool::stats().depotReturned.load();
+
+    // The first object stays in this thread's pool, the second one goes to the depot.
+    {
+        auto a = Pool::newObject(1);
+        auto b = Pool::newObject(2);
+    }
+    ASSERT_EQ(Pool::poolSize(), 1U);
+
+    DepotWidget* fromOtherThread = nullptr;
+    stdx::thread([&] {
+        fromOtherThread = Pool::newObjectRawPointer(3);
+        Pool::clearLocalPool();
+    }).join();
+    ASSERT_EQ(fromOtherThread->value, 3);
+
+    Pool::recycleObject(fromOtherThread);
+    Pool::clearLocalPool();
+    ASSERT_EQ(Pool::stats().depotHits.load() - beforeDepotHits, 1);
+    ASSERT_EQ(Pool::stats().depotReturned.load() - beforeDepotReturned, 2);
+}
+
+TEST(ObjectPoolTest, IdleObjectsAreTrimmed) {
+    using Pool = ObjectPool<TrimWidget>;
+    Pool::clearLocalPool();
+    const size_t kObjects = 100;
+
+    std::vector<TrimWidget*> widgets;
+    for (size_t i = 0; i < kObjects; ++i) {
+        widgets.push_back(Pool::newObjectRawPointer(int(i)));
+    }
+    for (auto widget : widgets) {
+        Pool::recycleObject(widget);
+    }
+
+    auto before = Pool::stats().trimmed.load();
+
+    // Finish the first maintenance interval; nothing has been idle for a whole interval yet.
+    const size_t firstPairs = (Pool::kMaintenanceInterval - 2 * kObjects) / 2;
+    for (size_t i = 0; i < firstPairs; ++i) {
+        Pool::recycleObject(Pool::newObjectRawPointer(0));
+    }
+    ASSERT_EQ(Pool::poolSize(), kObjects);
+
+    // Only one object is in use at a time during the second interval, so half of the other 99
+    // are freed when it ends.
+    for (size_t i = 0; i < Pool::kMaintenanceInterval / 2; ++i) {
+        Pool::recycleObject(Pool::newObjectRawPointer(0));
+    }
+    ASSERT_EQ(Pool::poolSize(), kObjects - (kObjects - 1) / 2);
+    ASSERT_EQ(Pool::stats().trimmed.load() - before, static_cast<long long>((kObjects - 1) / 2));
+
+    Pool::clearLocalPool();
+}
+
+TEST(ObjectPoolTest, StatsAreReportedByTypeName) {
+    ObjectPool<PooledWidget>::recycleObject(ObjectPool<PooledWidget>::newObjectRawPointer(1));
+    ObjectPool<PooledWidget>::clearLocalPool();
+
+    BSONObjBuilder bob;
+    ObjectPoolStats::appendAll(&bob);
+    auto obj = bob.obj();
+    ASSERT_EQ(ObjectPool<PooledWidget>::stats().name(), "mongo::PooledWidget");
+    ASSERT_TRUE(obj.hasField("mongo::PooledWidget")) << obj;
+    ASSERT_GT(obj["mongo::PooledWidget"]["misses"].numberLong(), 0) << obj;
+}
+
+}  // namespace
+}  // namespace mongo
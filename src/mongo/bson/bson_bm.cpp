@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/bson/bson_validate.h"
+#include "mongo/bson/bsonobj_field_index.h"
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Builds a document with 'numFields' fields of mixed types, like those of an insert-heavy
+ * workload.
+ */
+BSONObj makeDocument(int numFields) {
+    BSONObjBuilder bob;
+    bob.append("_id", OID::gen());
+    for (int i = 1; i < numFields; ++i) {
+        const std::string name = "field_" + std::to_string(i);
+        switch (i % 4) {
+            case 0:
+                bob.append(name, i);
+                break;
+            case 1:
+                bob.append(name, "value of " + name);
+                break;
+            case 2:
+                bob.append(name, i * 0.5);
+                break;
+            case 3:
+                bob.append(name, BSON("nested" << i << "flag" << true));
+                break;
+        }
+    }
+    return bob.obj();
+}
+
+std::vector<std::string> fieldNames(const BSONObj& obj) {
+    std::vector<std::string> names;
+    for (auto&& elem : obj) {
+        names.push_back(elem.fieldName());
+    }
+    return names;
+}
+
+void BM_validateBSON(benchmark::State& state) {
+    const BSONObj obj = makeDocument(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+    }
+    state.SetBytesProcessed(state.iterations() * obj.objsize());
+}
+
+// Looks up every field of the document with BSONObj::getField().
+void BM_getFieldLinear(benchmark::State& state) {
+    const BSONObj obj = makeDocument(state.range(0));
+    const auto names = fieldNames(obj);
+    for (auto _ : state) {
+        for (const auto& name : names) {
+            benchmark::DoNotOptimize(obj.getField(name));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+// Looks up every field of the document through a BSONObjFieldIndex, including building it.
+void BM_getFieldIndexed(benchmark::State& state) {
+    const BSONObj obj = makeDocument(state.range(0));
+    const auto names = fieldNames(obj);
+    for (auto _ : state) {
+        BSONObjFieldIndex index(obj);
+        for (const auto& name : names) {
+            benchmark::DoNotOptimize(index.getField(name));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+BENCHMARK(BM_validateBSON)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK(BM_getFieldLinear)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK(BM_getFieldIndexed)->RangeMultiplier(4)->Range(4, 1024);
+
+}  // namespace
+}  // namespace mongo
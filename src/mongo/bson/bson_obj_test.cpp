@@ -27,6 +27,7 @@
 
 #include "mongo/bson/bsonelement_comparator.h"
 #include "mongo/bson/bsonobj_comparator.h"
+#include "mongo/bson/bsonobj_field_index.h"
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/bson/unordered_fields_bsonobj_comparator.h"
@@ -675,4 +676,41 @@ TEST(BSONObj, addField) {
     ASSERT_BSONOBJ_EQ(obj, BSON("a" << 1 << "b" << 2));
 }
 
+TEST(BSONObjFieldIndex, FindsEveryField) {
+    BSONObjBuilder bob;
+    for (int i = 0; i < 100; ++i) {
+        bob.append("f" + std::to_string(i), i);
+    }
+    BSONObj obj = bob.obj();
+
+    BSONObjFieldIndex index(obj);
+    ASSERT_EQ(index.nFields(), 100);
+    for (int i = 0; i < 100; ++i) {
+        const std::string name = "f" + std::to_string(i);
+        ASSERT_EQ(index.getField(name).rawdata(), obj.getField(name).rawdata());
+    }
+}
+
+TEST(BSONObjFieldIndex, MissingFieldIsEOO) {
+    BSONObj obj = BSON("a" << 1 << "b" << 2);
+    BSONObjFieldIndex index(obj);
+    ASSERT(index.getField("c").eoo());
+    ASSERT(index.getField("").eoo());
+    ASSERT(index.getField("ab").eoo());
+}
+
+TEST(BSONObjFieldIndex, DuplicateNamesReturnFirstField) {
+    BSONObj obj = BSON("a" << 1 << "b" << 2 << "a" << 3);
+    BSONObjFieldIndex index(obj);
+    ASSERT_EQ(index.nFields(), 3);
+    ASSERT_EQ(index.getField("a").numberInt(), 1);
+}
+
+TEST(BSONObjFieldIndex, EmptyObject) {
+    BSONObj obj;
+    BSONObjFieldIndex index(obj);
+    ASSERT_EQ(index.nFields(), 0);
+    ASSERT(index.getField("a").eoo());
+}
+
 }  // unnamed namespace
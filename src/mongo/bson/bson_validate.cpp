@@ -27,9 +27,14 @@
  *    then also delete it in the license file.
  */
 
+#include <boost/container/small_vector.hpp>
 #include <cstring>
 #include <limits>
-#include <vector>
+
+#if defined(_M_AMD64) || defined(__amd64__)
+#include <emmintrin.h>
+#define MONGO_BSON_VALIDATE_SSE2
+#endif
 
 #include "mongo/base/data_view.h"
 #include "mongo/bson/bson_depth.h"
@@ -37,6 +42,7 @@
 #include "mongo/bson/oid.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/platform/bits.h"
 #include "mongo/platform/decimal128.h"
 
 namespace mongo {
@@ -67,6 +73,29 @@ Status NOINLINE_DECL makeError(StringData baseMsg, BSONElement idElem, StringDat
     return Status(ErrorCodes::InvalidBSON, msg);
 }
 
+/**
+ * Returns the offset of the first NUL among the 'len' bytes at 'data', or 'len' if there is none.
+ *
+ * Most c-strings in BSON are field names shorter than 16 bytes, so when SSE2 is available the first
+ * 16 bytes are checked inline, which avoids the setup cost of memchr() for them.
+ */
+inline uint64_t findNul(const char* data, uint64_t len) {
+    uint64_t offset = 0;
+#ifdef MONGO_BSON_VALIDATE_SSE2
+    const uint64_t kChunkSize = sizeof(__m128i);
+    if (len >= kChunkSize) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        const uint32_t nulMask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_setzero_si128()));
+        if (nulMask) {
+            return countTrailingZeros64(nulMask);
+        }
+        offset = kChunkSize;
+    }
+#endif
+    const void* nul = memchr(data + offset, 0, len - offset);
+    return nul ? static_cast<uint64_t>(static_cast<const char*>(nul) - data) : len;
+}
+
 class Buffer {
 public:
     Buffer(const char* buffer, uint64_t maxLength, BSONVersion version)
@@ -89,10 +118,9 @@ public:
      * reading, if it exists. Otherwise, it should be empty.
      */
     Status readCString(StringData elemName, StringData* out) {
-        const void* x = memchr(_buffer + _position, 0, _maxLength - _position);
-        if (!x)
+        const uint64_t len = findNul(_buffer + _position, _maxLength - _position);
+        if (len == _maxLength - _position)
             return makeError("no end of c-string", _idElem, elemName);
-        uint64_t len = static_cast<uint64_t>(static_cast<const char*>(x) - (_buffer + _position));
 
         StringData data(_buffer + _position, len);
         _position += len + 1;
@@ -122,14 +150,12 @@ public:
             *out = StringData(_buffer + _position, sz);
         }
 
-        if (!skip(sz - 1))
+        // Check the length and the terminating NUL at once rather than reading up to the NUL.
+        if (static_cast<uint64_t>(sz) > _maxLength - _position)
             return makeError("invalid bson", _idElem, elemName);
 
-        char c;
-        if (!readNumber<char>(&c))
-            return makeError("invalid bson", _idElem, elemName);
-
-        if (c != 0)
+        _position += sz;
+        if (_buffer[_position - 1] != 0)
             return makeError("not null terminated string", _idElem, elemName);
 
         return Status::OK();
@@ -308,8 +334,8 @@ Status validateElementInfo(Buffer* buffer,
 }
 
 Status validateBSONIterative(Buffer* buffer) {
-    std::vector<ValidationObjectFrame> frames;
-    frames.reserve(16);
+    // Documents are rarely nested deeper than this, so their frames need no allocation.
+    boost::container::small_vector<ValidationObjectFrame, 16> frames;
     ValidationObjectFrame* curr = NULL;
     ValidationState::State state = ValidationState::BeginObj;
 
@@ -354,4 +354,34 @@ TEST(BSONValidateBool, BoolValuesAreValidated) {
     }
 }
 
+TEST(BSONValidateFast, FieldNamesOfEveryLength) {
+    // Covers field names shorter than, as long as and longer than one vector of bytes.
+    for (int len = 0; len < 40; ++len) {
+        const std::string name(len, 'f');
+        const BSONObj x = BSON(name << 1 << "_id" << 2);
+        ASSERT_OK(validateBSON(x.objdata(), x.objsize(), BSONVersion::kLatest));
+    }
+}
+
+TEST(BSONValidateFast, FieldNameRunningPastBuffer) {
+    for (int len = 0; len < 40; ++len) {
+        BufBuilder bb;
+        bb.appendNum(0);
+        bb.appendChar(NumberInt);
+        bb.appendStr(std::string(len, 'f'), /*withNUL*/ false);
+        ASSERT_NOT_OK(validateBSON(bb.buf(), bb.len(), BSONVersion::kLatest));
+    }
+}
+
+TEST(BSONValidateFast, StringLengthRunningPastBuffer) {
+    const BSONObj x = BSON("x"
+                           << "abc");
+    // Leave out the string's terminating NUL and what follows it.
+    const int truncatedSize = x.objsize() - 2;
+    const Status status = validateBSON(x.objdata(), truncatedSize, BSONVersion::kLatest);
+    ASSERT_NOT_OK(status);
+    ASSERT_EQUALS(status.reason(),
+                  "invalid bson in element with field name 'x' in object with unknown _id");
+}
+
 }  // namespace
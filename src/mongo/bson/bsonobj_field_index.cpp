@@ -0,0 +1,72 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobj_field_index.h"
+
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+BSONObjFieldIndex::BSONObjFieldIndex(const BSONObj& obj) : _objdata(obj.objdata()) {
+    _nFields = obj.nFields();
+
+    size_t numSlots = 4;
+    while (numSlots <= 2 * static_cast<size_t>(_nFields)) {
+        numSlots *= 2;
+    }
+    _slots.resize(numSlots, Slot{0, 0});
+    const size_t mask = numSlots - 1;
+
+    for (auto&& elem : obj) {
+        const StringData name = elem.fieldNameStringData();
+        const uint32_t hash = StringMapTraits::hash(name);
+        size_t i = hash & mask;
+        bool duplicate = false;
+        while (_slots[i].offset != 0) {
+            if (_slots[i].hash == hash &&
+                BSONElement(_objdata + _slots[i].offset).fieldNameStringData() == name) {
+                duplicate = true;
+                break;
+            }
+            i = (i + 1) & mask;
+        }
+        // Keep the first of several fields with the same name, as getField() finds it.
+        if (!duplicate) {
+            _slots[i] = Slot{hash, static_cast<uint32_t>(elem.rawdata() - _objdata)};
+        }
+    }
+}
+
+BSONElement BSONObjFieldIndex::getField(StringData name) const {
+    const uint32_t hash = StringMapTraits::hash(name);
+    const size_t mask = _slots.size() - 1;
+    for (size_t i = hash & mask; _slots[i].offset != 0; i = (i + 1) & mask) {
+        if (_slots[i].hash != hash) {
+            continue;
+        }
+        BSONElement elem(_objdata + _slots[i].offset);
+        if (elem.fieldNameStringData() == name) {
+            return elem;
+        }
+    }
+    return BSONElement();
+}
+
+}  // namespace mongo
@@ -0,0 +1,66 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+/**
+ * A hash index of the top-level fields of a BSONObj, for callers that look up many fields of the
+ * same wide object. BSONObj::getField() and BSONObj::nFields() scan the object each time; here
+ * one scan builds the index and each lookup then costs a hash probe.
+ *
+ * The index points into the object, which must outlive it and stay unchanged.
+ */
+class BSONObjFieldIndex {
+public:
+    explicit BSONObjFieldIndex(const BSONObj& obj);
+
+    /**
+     * Returns the first element named 'name', or an EOO element if there is none, like
+     * BSONObj::getField().
+     */
+    BSONElement getField(StringData name) const;
+
+    int nFields() const {
+        return _nFields;
+    }
+
+private:
+    struct Slot {
+        uint32_t hash;
+        // Offset of the element from the start of the object. Elements start after the length
+        // prefix, so zero marks an empty slot.
+        uint32_t offset;
+    };
+
+    const char* const _objdata;
+    int _nFields = 0;
+    // Open addressing with linear probing. The number of slots is a power of two and more than
+    // twice the number of fields.
+    std::vector<Slot> _slots;
+};
+
+}  // namespace mongo
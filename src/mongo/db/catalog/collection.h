@@ -31,6 +31,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
@@ -259,7 +260,8 @@ public:
                                         bool enforceQuota,
                                         bool indexesAffected,
                                         OpDebug* opDebug,
-                                        OplogUpdateEntryArgs* args) = 0;
+                                        OplogUpdateEntryArgs* args,
+                                        const std::vector<std::string>* modifiedPaths) = 0;
 
         virtual bool updateWithDamagesSupported() const = 0;
 
@@ -536,6 +538,8 @@ public:
      * Sets 'args.updatedDoc' to the updated version of the document with damages applied, on
      * success.
      * 'opDebug' Optional argument. When not null, will be used to record operation statistics.
+     * 'modifiedPaths' Optional argument. When not null, lists the paths the update modified, as
+     * reported by UpdateDriver::modifiedPaths(); indexes none of them might affect are skipped.
      * @return the post update location of the doc (may or may not be the same as oldLocation)
      */
     inline RecordId updateDocument(OperationContext* const opCtx,
@@ -545,9 +549,17 @@ public:
                                    const bool enforceQuota,
                                    const bool indexesAffected,
                                    OpDebug* const opDebug,
-                                   OplogUpdateEntryArgs* const args) {
-        return this->_impl().updateDocument(
-            opCtx, oldLocation, oldDoc, newDoc, enforceQuota, indexesAffected, opDebug, args);
+                                   OplogUpdateEntryArgs* const args,
+                                   const std::vector<std::string>* modifiedPaths = nullptr) {
+        return this->_impl().updateDocument(opCtx,
+                                            oldLocation,
+                                            oldDoc,
+                                            newDoc,
+                                            enforceQuota,
+                                            indexesAffected,
+                                            opDebug,
+                                            args,
+                                            modifiedPaths);
     }
 
     inline bool updateWithDamagesSupported() const {
@@ -47,6 +47,7 @@
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/catalog/index_consistency.h"
 #include "mongo/db/catalog/index_create.h"
+#include "mongo/db/catalog/index_update_filter.h"
 #include "mongo/db/catalog/namespace_uuid_cache.h"
 #include "mongo/db/catalog/uuid_catalog.h"
 #include "mongo/db/clientcursor.h"
@@ -617,7 +618,8 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
                                         bool enforceQuota,
                                         bool indexesAffected,
                                         OpDebug* opDebug,
-                                        OplogUpdateEntryArgs* args) {
+                                        OplogUpdateEntryArgs* args,
+                                        const std::vector<std::string>* modifiedPaths) {
     {
         auto status = checkValidation(opCtx, newDoc);
         if (!status.isOK()) {
@@ -665,14 +667,19 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
                   str::stream() << "Cannot change the size of a document in a capped collection: "
                                 << oldSize << " != " << newDoc.objsize());
 
-    // At the end of this step, we will have a map of UpdateTickets, one per index, which
-    // represent the index updates needed to be done, based on the changes between oldDoc and
-    // newDoc.
+    // At the end of this step, we will have a map of UpdateTickets, one per index whose keys the
+    // update may change, which represent the index updates needed to be done, based on the
+    // changes between oldDoc and newDoc. Indexes none of the modified paths might affect get no
+    // ticket: their keys are unchanged, so only the record itself needs to be written.
+    IndexUpdateFilter indexUpdateFilter(this, infoCache(), indexesAffected, modifiedPaths);
     OwnedPointerMap<IndexDescriptor*, UpdateTicket> updateTickets;
     if (indexesAffected) {
         IndexCatalog::IndexIterator ii = _indexCatalog.getIndexIterator(opCtx, true);
         while (ii.more()) {
             IndexDescriptor* descriptor = ii.next();
+            if (!indexUpdateFilter.indexKeysMayChange(opCtx, descriptor->indexName())) {
+                continue;
+            }
             IndexCatalogEntry* entry = ii.catalogEntry(descriptor);
             IndexAccessMethod* iam = ii.accessMethod(descriptor);
 
@@ -692,8 +699,12 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
 
     args->preImageDoc = oldDoc.value().getOwned();
 
-    Status updateStatus = _recordStore->updateRecord(
-        opCtx, oldLocation, newDoc.objdata(), newDoc.objsize(), _enforceQuota(enforceQuota), this);
+    Status updateStatus = _recordStore->updateRecord(opCtx,
+                                                     oldLocation,
+                                                     newDoc.objdata(),
+                                                     newDoc.objsize(),
+                                                     _enforceQuota(enforceQuota),
+                                                     &indexUpdateFilter);
 
     if (updateStatus == ErrorCodes::NeedsDocumentMove) {
         return uassertStatusOK(_updateDocumentWithMove(
@@ -706,12 +717,15 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
         IndexCatalog::IndexIterator ii = _indexCatalog.getIndexIterator(opCtx, true);
         while (ii.more()) {
             IndexDescriptor* descriptor = ii.next();
+            auto ticket = updateTickets.mutableMap().find(descriptor);
+            if (ticket == updateTickets.mutableMap().end()) {
+                continue;
+            }
             IndexAccessMethod* iam = ii.accessMethod(descriptor);
 
             int64_t keysInserted;
             int64_t keysDeleted;
-            uassertStatusOK(iam->update(
-                opCtx, *updateTickets.mutableMap()[descriptor], &keysInserted, &keysDeleted));
+            uassertStatusOK(iam->update(opCtx, *ticket->second, &keysInserted, &keysDeleted));
             if (opDebug) {
                 opDebug->additiveMetrics.incrementKeysInserted(keysInserted);
                 opDebug->additiveMetrics.incrementKeysDeleted(keysDeleted);
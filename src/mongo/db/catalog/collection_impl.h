@@ -211,6 +211,8 @@ public:
      * Sets 'args.updatedDoc' to the updated version of the document with damages applied, on
      * success.
      * 'opDebug' Optional argument. When not null, will be used to record operation statistics.
+     * 'modifiedPaths' Optional argument. When not null, indexes that none of the modified paths
+     * might affect keep their keys and are not updated.
      * @return the post update location of the doc (may or may not be the same as oldLocation)
      */
     RecordId updateDocument(OperationContext* opCtx,
@@ -220,7 +222,8 @@ public:
                             bool enforceQuota,
                             bool indexesAffected,
                             OpDebug* opDebug,
-                            OplogUpdateEntryArgs* args) final;
+                            OplogUpdateEntryArgs* args,
+                            const std::vector<std::string>* modifiedPaths) final;
 
     bool updateWithDamagesSupported() const final;
 
@@ -56,6 +56,9 @@ public:
 
         virtual const UpdateIndexData& getIndexKeys(OperationContext* opCtx) const = 0;
 
+        virtual const UpdateIndexData* getIndexKeysForIndex(OperationContext* opCtx,
+                                                            StringData indexName) const = 0;
+
         virtual CollectionIndexUsageMap getIndexUsageStats() const = 0;
 
         virtual void init(OperationContext* opCtx) = 0;
@@ -110,6 +113,15 @@ public:
         return this->_impl().getIndexKeys(opCtx);
     }
 
+    /**
+     * Like getIndexKeys(), but restricted to the paths of the index named 'indexName', including
+     * those of its partial filter. Returns nullptr if there is no such index.
+     */
+    inline const UpdateIndexData* getIndexKeysForIndex(OperationContext* const opCtx,
+                                                       const StringData indexName) const {
+        return this->_impl().getIndexKeysForIndex(opCtx, indexName);
+    }
+
     /**
      * Returns cached index usage statistics for this collection.  The map returned will contain
      * entry for each index in the collection along with both a usage counter and a timestamp
@@ -78,8 +78,65 @@ const UpdateIndexData& CollectionInfoCacheImpl::getIndexKeys(OperationContext* o
     return _indexedPaths;
 }
 
+namespace {
+/**
+ * Registers with 'indexedPaths' every path whose modification may change the keys 'descriptor'
+ * generates, or whether a document belongs to it at all given its partial 'filter'.
+ */
+void addIndexedPaths(const IndexDescriptor* descriptor,
+                     const MatchExpression* filter,
+                     UpdateIndexData* indexedPaths) {
+    if (descriptor->getAccessMethodName() != IndexNames::TEXT) {
+        BSONObjIterator j(descriptor->keyPattern());
+        while (j.more()) {
+            BSONElement e = j.next();
+            indexedPaths->addPath(e.fieldName());
+        }
+    } else {
+        fts::FTSSpec ftsSpec(descriptor->infoObj());
+
+        if (ftsSpec.wildcard()) {
+            indexedPaths->allPathsIndexed();
+        } else {
+            for (size_t i = 0; i < ftsSpec.numExtraBefore(); ++i) {
+                indexedPaths->addPath(ftsSpec.extraBefore(i));
+            }
+            for (fts::Weights::const_iterator it = ftsSpec.weights().begin();
+                 it != ftsSpec.weights().end();
+                 ++it) {
+                indexedPaths->addPath(it->first);
+            }
+            for (size_t i = 0; i < ftsSpec.numExtraAfter(); ++i) {
+                indexedPaths->addPath(ftsSpec.extraAfter(i));
+            }
+            // Any update to a path containing "language" as a component could change the
+            // language of a subdocument.  Add the override field as a path component.
+            indexedPaths->addPathComponent(ftsSpec.languageOverrideField());
+        }
+    }
+
+    // handle partial indexes
+    if (filter) {
+        stdx::unordered_set<std::string> paths;
+        QueryPlannerIXSelect::getFields(filter, "", &paths);
+        for (auto it = paths.begin(); it != paths.end(); ++it) {
+            indexedPaths->addPath(*it);
+        }
+    }
+}
+}  // namespace
+
+const UpdateIndexData* CollectionInfoCacheImpl::getIndexKeysForIndex(OperationContext* opCtx,
+                                                                     StringData indexName) const {
+    dassert(opCtx->lockState()->isCollectionLockedForMode(_collection->ns().ns(), MODE_IS));
+    invariant(_keysComputed);
+    auto it = _indexedPathsByIndex.find(indexName);
+    return it == _indexedPathsByIndex.end() ? nullptr : &it->second;
+}
+
 void CollectionInfoCacheImpl::computeIndexKeys(OperationContext* opCtx) {
     _indexedPaths.clear();
+    _indexedPathsByIndex.clear();
 
     bool hadTTLIndex = _hasTTLIndex;
     _hasTTLIndex = false;
@@ -88,50 +145,15 @@ void CollectionInfoCacheImpl::computeIndexKeys(OperationContext* opCtx) {
     while (i.more()) {
         IndexDescriptor* descriptor = i.next();
 
-        if (descriptor->getAccessMethodName() != IndexNames::TEXT) {
-            BSONObj key = descriptor->keyPattern();
-            const BSONObj& infoObj = descriptor->infoObj();
-            if (infoObj.hasField("expireAfterSeconds")) {
-                _hasTTLIndex = true;
-            }
-            BSONObjIterator j(key);
-            while (j.more()) {
-                BSONElement e = j.next();
-                _indexedPaths.addPath(e.fieldName());
-            }
-        } else {
-            fts::FTSSpec ftsSpec(descriptor->infoObj());
-
-            if (ftsSpec.wildcard()) {
-                _indexedPaths.allPathsIndexed();
-            } else {
-                for (size_t i = 0; i < ftsSpec.numExtraBefore(); ++i) {
-                    _indexedPaths.addPath(ftsSpec.extraBefore(i));
-                }
-                for (fts::Weights::const_iterator it = ftsSpec.weights().begin();
-                     it != ftsSpec.weights().end();
-                     ++it) {
-                    _indexedPaths.addPath(it->first);
-                }
-                for (size_t i = 0; i < ftsSpec.numExtraAfter(); ++i) {
-                    _indexedPaths.addPath(ftsSpec.extraAfter(i));
-                }
-                // Any update to a path containing "language" as a component could change the
-                // language of a subdocument.  Add the override field as a path component.
-                _indexedPaths.addPathComponent(ftsSpec.languageOverrideField());
-            }
+        if (descriptor->getAccessMethodName() != IndexNames::TEXT &&
+            descriptor->infoObj().hasField("expireAfterSeconds")) {
+            _hasTTLIndex = true;
         }
 
-        // handle partial indexes
         const IndexCatalogEntry* entry = i.catalogEntry(descriptor);
         const MatchExpression* filter = entry->getFilterExpression();
-        if (filter) {
-            stdx::unordered_set<std::string> paths;
-            QueryPlannerIXSelect::getFields(filter, "", &paths);
-            for (auto it = paths.begin(); it != paths.end(); ++it) {
-                _indexedPaths.addPath(*it);
-            }
-        }
+        addIndexedPaths(descriptor, filter, &_indexedPaths);
+        addIndexedPaths(descriptor, filter, &_indexedPathsByIndex[descriptor->indexName()]);
     }
 
     TTLCollectionCache& ttlCollectionCache = TTLCollectionCache::get(getGlobalServiceContext());
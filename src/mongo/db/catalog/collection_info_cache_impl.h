@@ -35,6 +35,7 @@
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/query_settings.h"
 #include "mongo/db/update_index_data.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -67,6 +68,9 @@ public:
     */
     const UpdateIndexData& getIndexKeys(OperationContext* opCtx) const;
 
+    const UpdateIndexData* getIndexKeysForIndex(OperationContext* opCtx,
+                                                StringData indexName) const;
+
     /**
      * Returns cached index usage statistics for this collection.  The map returned will contain
      * entry for each index in the collection along with both a usage counter and a timestamp
@@ -124,6 +128,7 @@ private:
     // ---  index keys cache
     bool _keysComputed;
     UpdateIndexData _indexedPaths;
+    StringMap<UpdateIndexData> _indexedPathsByIndex;
 
     // A cache for query plans.
     std::unique_ptr<PlanCache> _planCache;
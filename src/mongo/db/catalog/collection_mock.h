@@ -176,7 +176,8 @@ public:
                             bool enforceQuota,
                             bool indexesAffected,
                             OpDebug* opDebug,
-                            OplogUpdateEntryArgs* args) {
+                            OplogUpdateEntryArgs* args,
+                            const std::vector<std::string>* modifiedPaths) {
         std::abort();
     }
 
@@ -31,6 +31,7 @@
 #include "mongo/db/catalog/capped_utils.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog_entry.h"
+#include "mongo/db/catalog/index_update_filter.h"
 #include "mongo/db/client.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -238,4 +239,28 @@ TEST_F(CollectionTest, AsynchronouslyNotifyCappedWaitersIfNeeded) {
     thread.join();
     ASSERT_EQ(notifier->getVersion(), thisVersion);
 }
+
+TEST_F(CollectionTest, IndexUpdateFilterKeepsIndexesUnknownToInfoCache) {
+    NamespaceString nss("test.t");
+    ASSERT_OK(_storage->createCollection(_opCtx, nss, CollectionOptions()));
+
+    AutoGetCollectionForRead autoColl(_opCtx, nss);
+    const CollectionInfoCache* infoCache = autoColl.getCollection()->infoCache();
+
+    // An update of "a" that no committed index is affected by leaves the _id index alone. An
+    // index that a storage engine is building from an uncommitted schema is not in the info
+    // cache, and must still be told about the update.
+    const std::vector<std::string> modifiedPaths{"a"};
+    IndexUpdateFilter unaffected(nullptr, infoCache, false, &modifiedPaths);
+    ASSERT_FALSE(unaffected.indexKeysMayChange(_opCtx, "_id_"));
+    ASSERT_TRUE(unaffected.indexKeysMayChange(_opCtx, "a_1"));
+
+    IndexUpdateFilter affected(nullptr, infoCache, true, &modifiedPaths);
+    ASSERT_FALSE(affected.indexKeysMayChange(_opCtx, "_id_"));
+    ASSERT_TRUE(affected.indexKeysMayChange(_opCtx, "a_1"));
+
+    // Without the modified paths, every index may change.
+    IndexUpdateFilter unknownPaths(nullptr, infoCache, true, nullptr);
+    ASSERT_TRUE(unknownPaths.indexKeysMayChange(_opCtx, "_id_"));
+}
 }  // namespace
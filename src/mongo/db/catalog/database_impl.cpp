@@ -59,6 +59,7 @@
 #include "mongo/db/op_observer.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
+#include "mongo/db/query/plan_cache_store.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/server_options.h"
@@ -762,6 +763,8 @@ Status DatabaseImpl::_finishDropCollection(OperationContext* opCtx,
     if (status.isOK()) {
         _clearCollectionCache(
             opCtx, fullns.toStringData(), "collection dropped", /*collectionGoingAway*/ true);
+        // A later collection with the same name must not restore plans cached for this one.
+        PlanCacheStore::get()->removeAll(fullns.ns());
     }
     return status;
 }
@@ -867,6 +870,11 @@ Status DatabaseImpl::renameCollection(OperationContext* opCtx,
     }
 
     Status s = _dbEntry->renameCollection(opCtx, fromNS, toNS, stayTemp);
+    if (s.isOK()) {
+        // Persisted plans are keyed by namespace, so neither name may keep the ones it had.
+        PlanCacheStore::get()->removeAll(fromNS);
+        PlanCacheStore::get()->removeAll(toNS);
+    }
     // opCtx->recoveryUnit()->registerChange(new AddCollectionChange(opCtx, this, toNS));
     // _collections[toNS] = _getOrCreateCollectionInstance(opCtx, toNSS);
 
@@ -0,0 +1,73 @@
+/*-
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/index_update_filter.h"
+
+#include <algorithm>
+
+#include "mongo/db/catalog/collection_info_cache.h"
+#include "mongo/db/update_index_data.h"
+
+namespace mongo {
+
+IndexUpdateFilter::IndexUpdateFilter(UpdateNotifier* collection,
+                                     const CollectionInfoCache* infoCache,
+                                     bool indexesAffected,
+                                     const std::vector<std::string>* modifiedPaths)
+    : _collection(collection),
+      _infoCache(infoCache),
+      _indexesAffected(indexesAffected),
+      _modifiedPaths(modifiedPaths) {}
+
+Status IndexUpdateFilter::recordStoreGoingToUpdateInPlace(OperationContext* opCtx,
+                                                          const RecordId& loc) {
+    return _collection->recordStoreGoingToUpdateInPlace(opCtx, loc);
+}
+
+bool IndexUpdateFilter::indexKeysMayChange(OperationContext* opCtx, StringData indexName) const {
+    // The info cache is built from the committed catalog, so it must be asked first: an index the
+    // update was not checked against must be kept up to date.
+    const UpdateIndexData* indexedPaths = _infoCache->getIndexKeysForIndex(opCtx, indexName);
+    if (!indexedPaths) {
+        return true;
+    }
+    if (!_indexesAffected) {
+        return false;
+    }
+    if (!_modifiedPaths) {
+        return true;
+    }
+    return std::any_of(
+        _modifiedPaths->begin(), _modifiedPaths->end(), [&](const std::string& path) {
+            return indexedPaths->mightBeIndexed(path);
+        });
+}
+
+}  // namespace mongo
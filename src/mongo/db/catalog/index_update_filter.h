@@ -0,0 +1,75 @@
+/*
+*    Copyright (C) 2018 MongoDB Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*    As a special exception, the copyright holders give permission to link the
+*    code of portions of this program with the OpenSSL library under certain
+*    conditions as described in each individual source file and distribute
+*    linked combinations including the program with the OpenSSL library. You
+*    must comply with the GNU Affero General Public License in all respects for
+*    all of the code used other than as permitted herein. If you modify file(s)
+*    with this exception, you may extend this exception to your version of the
+*    file(s), but you are not obligated to do so. If you do not wish to do so,
+*    delete this exception statement from your version. If you delete this
+*    exception statement from all source files in the program, then also delete
+*    it in the license file.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/db/storage/record_store.h"
+
+namespace mongo {
+
+class CollectionInfoCache;
+class OperationContext;
+
+/**
+ * Decides, for a single call to Collection::updateDocument(), which indexes the update may change
+ * the keys of, and passes that on to the record store along with the collection's in-place update
+ * notifications.
+ */
+class IndexUpdateFilter final : public UpdateNotifier {
+public:
+    /**
+     * 'indexesAffected' is whether the update may change the keys of any index known to
+     * 'infoCache', and 'modifiedPaths' lists the paths it changes, or is nullptr if those are not
+     * known. 'collection' receives the in-place update notifications.
+     */
+    IndexUpdateFilter(UpdateNotifier* collection,
+                      const CollectionInfoCache* infoCache,
+                      bool indexesAffected,
+                      const std::vector<std::string>* modifiedPaths);
+
+    Status recordStoreGoingToUpdateInPlace(OperationContext* opCtx, const RecordId& loc) final;
+
+    /**
+     * An index 'infoCache' does not know of, such as one a storage engine is still building from
+     * a schema that is not committed yet, always may change: 'indexesAffected' says nothing about
+     * it.
+     */
+    bool indexKeysMayChange(OperationContext* opCtx, StringData indexName) const final;
+
+private:
+    UpdateNotifier* const _collection;
+    const CollectionInfoCache* const _infoCache;
+    const bool _indexesAffected;
+    const std::vector<std::string>* const _modifiedPaths;
+};
+
+}  // namespace mongo
@@ -48,6 +48,7 @@
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/plan_cache_store.h"
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/util/log.h"
 
@@ -94,6 +95,7 @@ MONGO_INITIALIZER_WITH_PREREQUISITES(SetupPlanCacheCommands, MONGO_NO_PREREQUISI
     // the ActionType construction will be completed first.
     new PlanCacheListQueryShapes();
     new PlanCacheClear();
+    new PlanCachePin();
     new PlanCacheListPlans();
 
     return Status::OK();
@@ -345,12 +347,66 @@ Status PlanCacheClear::clear(OperationContext* opCtx,
     }
 
     planCache->clear();
+    PlanCacheStore::get()->removeAll(ns);
 
     LOG(1) << ns << ": cleared plan cache";
 
     return Status::OK();
 }
 
+PlanCachePin::PlanCachePin()
+    : PlanCacheCommand("planCachePin",
+                       "Pins or unpins the cached plan of a query shape.",
+                       ActionType::planCacheWrite) {}
+
+Status PlanCachePin::runPlanCacheCommand(OperationContext* opCtx,
+                                         const std::string& ns,
+                                         const BSONObj& cmdObj,
+                                         BSONObjBuilder* bob) {
+    AutoGetCollectionForReadCommand ctx(opCtx, NamespaceString(ns));
+
+    PlanCache* planCache;
+    Status status = getPlanCache(opCtx, ctx.getCollection(), ns, &planCache);
+    if (!status.isOK()) {
+        return status;
+    }
+    return pin(opCtx, planCache, ns, cmdObj);
+}
+
+// static
+Status PlanCachePin::pin(OperationContext* opCtx,
+                         PlanCache* planCache,
+                         const std::string& ns,
+                         const BSONObj& cmdObj) {
+    invariant(planCache);
+
+    bool pinned = true;
+    if (auto pinnedElt = cmdObj["pinned"]) {
+        if (!pinnedElt.isBoolean()) {
+            return Status(ErrorCodes::BadValue, "optional field pinned must be a boolean");
+        }
+        pinned = pinnedElt.boolean();
+    }
+
+    auto statusWithCQ = PlanCacheCommand::canonicalize(opCtx, ns, cmdObj);
+    if (!statusWithCQ.isOK()) {
+        return statusWithCQ.getStatus();
+    }
+    auto cq = std::move(statusWithCQ.getValue());
+
+    Status result = planCache->setPinned(*cq, pinned);
+    if (!result.isOK()) {
+        return result;
+    }
+
+    LOG(1) << ns << ": " << (pinned ? "pinned" : "unpinned") << " plan cache entry - "
+           << redact(cq->getQueryObj()) << "(sort: " << cq->getQueryRequest().getSort()
+           << "; projection: " << cq->getQueryRequest().getProj()
+           << "; collation: " << cq->getQueryRequest().getCollation() << ")";
+
+    return Status::OK();
+}
+
 PlanCacheListPlans::PlanCacheListPlans()
     : PlanCacheCommand("planCacheListPlans",
                        "Displays the cached plans for a query shape.",
@@ -446,6 +502,7 @@ Status PlanCacheListPlans::list(OperationContext* opCtx,
 
     // Append the time the entry was inserted into the plan cache.
     bob->append("timeOfCreation", entry->timeOfCreation);
+    bob->append("pinned", entry->pinned);
 
     return Status::OK();
 }
@@ -149,6 +149,35 @@ public:
                         const BSONObj& cmdObj);
 };
 
+/**
+ * planCachePin
+ *
+ * {
+ *     planCachePin: <collection>,
+ *     query: <query>,
+ *     sort: <sort>,
+ *     projection: <projection>,
+ *     pinned: <bool, defaults to true>
+ * }
+ *
+ */
+class PlanCachePin : public PlanCacheCommand {
+public:
+    PlanCachePin();
+    virtual Status runPlanCacheCommand(OperationContext* opCtx,
+                                       const std::string& ns,
+                                       const BSONObj& cmdObj,
+                                       BSONObjBuilder* bob);
+
+    /**
+     * Pins or unpins the cached plan of a query shape, which must be in the cache.
+     */
+    static Status pin(OperationContext* opCtx,
+                      PlanCache* planCache,
+                      const std::string& ns,
+                      const BSONObj& cmdObj);
+};
+
 /**
  * planCacheListPlans
  *
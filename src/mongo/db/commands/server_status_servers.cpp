@@ -30,6 +30,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/base/object_pool.h"
 #include "mongo/config.h"
 #include "mongo/db/commands/server_status.h"
 #include "mongo/transport/message_compressor_registry.h"
@@ -37,6 +38,7 @@
 #include "mongo/util/net/hostname_canonicalization.h"
 #include "mongo/util/net/socket_utils.h"
 #include "mongo/util/net/ssl_manager.h"
+#include "mongo/util/shared_buffer_pool.h"
 
 namespace mongo {
 
@@ -82,6 +84,7 @@ public:
         BSONObjBuilder b;
         networkCounter.append(b);
         appendMessageCompressionStats(&b);
+        SharedBufferPool::appendStats(&b);
         auto executor = opCtx->getServiceContext()->getServiceExecutor();
         if (executor)
             executor->appendStats(&b);
@@ -91,6 +94,21 @@ public:
 
 } network;
 
+class ObjectPools : public ServerStatusSection {
+public:
+    ObjectPools() : ServerStatusSection("objectPools") {}
+    virtual bool includeByDefault() const {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElement) const {
+        BSONObjBuilder b;
+        ObjectPoolStats::appendAll(&b);
+        return b.obj();
+    }
+
+} objectPools;
+
 #ifdef MONGO_CONFIG_SSL
 class Security : public ServerStatusSection {
 public:
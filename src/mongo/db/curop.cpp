@@ -273,6 +273,13 @@ void CurOp::reportCurrentOpForClient(OperationContext* opCtx,
         }
 
         CurOp::get(clientOpCtx)->reportState(infoBuilder, truncateOps);
+
+        if (serverGlobalParams.enableCoroutine) {
+            const auto& waitStats = clientOpCtx->coroutineWaitStats();
+            infoBuilder->append("storageWaitMicros", waitStats.storageWaitMicros());
+            infoBuilder->append("queueWaitMicros", waitStats.queueWaitMicros());
+            infoBuilder->append("txCommitMicros", waitStats.txCommitMicros());
+        }
     }
 }
 
@@ -398,6 +405,13 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
     _end = curTimeMicros64();
     _debug.executionTimeMicros = durationCount<Microseconds>(elapsedTimeExcludingPauses());
 
+    if (serverGlobalParams.enableCoroutine && !_parent) {
+        const auto& waitStats = opCtx->coroutineWaitStats();
+        _debug.storageWaitMicros = waitStats.storageWaitMicros();
+        _debug.queueWaitMicros = waitStats.queueWaitMicros();
+        _debug.txCommitMicros = waitStats.txCommitMicros();
+    }
+
     const bool shouldSample =
         client->getPrng().nextCanonicalDouble() < serverGlobalParams.sampleRate;
 
@@ -556,6 +570,9 @@ void OpDebug::reset() {
     nreturned = -1;
     responseLength = -1;
     nShards = -1;
+    storageWaitMicros = -1;
+    queueWaitMicros = -1;
+    txCommitMicros = -1;
     additiveMetrics.reset();
 }
 
@@ -636,6 +653,9 @@ string OpDebug::report(Client* client,
 
     s << " numYields:" << curop.numYields();
     OPDEBUG_TOSTRING_HELP(nreturned);
+    OPDEBUG_TOSTRING_HELP(storageWaitMicros);
+    OPDEBUG_TOSTRING_HELP(queueWaitMicros);
+    OPDEBUG_TOSTRING_HELP(txCommitMicros);
 
     if (!errInfo.isOK()) {
         s << " ok:" << 0;
@@ -717,6 +737,9 @@ void OpDebug::append(const CurOp& curop,
 
     b.appendNumber("numYield", curop.numYields());
     OPDEBUG_APPEND_NUMBER(nreturned);
+    OPDEBUG_APPEND_NUMBER(storageWaitMicros);
+    OPDEBUG_APPEND_NUMBER(queueWaitMicros);
+    OPDEBUG_APPEND_NUMBER(txCommitMicros);
 
     {
         BSONObjBuilder locks(b.subobjStart("locks"));
@@ -188,6 +188,12 @@ public:
     // Details of any error (whether from an exception or a command returning failure).
     Status errInfo = Status::OK();
 
+    // Time the operation's coroutine spent suspended, see CoroutineWaitStats. Only reported when
+    // the coroutine service executor is in use.
+    long long storageWaitMicros{-1};
+    long long queueWaitMicros{-1};
+    long long txCommitMicros{-1};
+
     // response info
     long long executionTimeMicros{0};
     long long nreturned{-1};
@@ -418,7 +418,6 @@ CursorManager::CursorManager(NamespaceString nss)
     : _nss(std::move(nss)),
       _collectionCacheRuntimeId(_nss.isEmpty() ? 0
                                                : globalCursorIdCache->registerCursorManager(_nss)),
-      _random(stdx::make_unique<PseudoRandom>(globalCursorIdCache->nextSeed())),
       _registeredPlanExecutors(),
       _cursorMap(stdx::make_unique<Partitioned<stdx::unordered_map<CursorId, ClientCursor*>>>()) {}
 
@@ -547,6 +546,15 @@ std::size_t CursorManager::timeoutCursors(OperationContext* opCtx, Date_t now) {
 
 namespace {
 static AtomicUInt32 registeredPlanExecutorId;
+
+/**
+ * Returns the calling thread's cursor id generator. Keeping one generator per thread lets
+ * concurrent cursor registrations proceed without sharing a mutex-protected generator.
+ */
+PseudoRandom& cursorIdRandom() {
+    thread_local PseudoRandom random(globalCursorIdCache->nextSeed());
+    return random;
+}
 }  // namespace
 
 Partitioned<stdx::unordered_set<PlanExecutor*>>::PartitionId CursorManager::registerExecutor(
@@ -566,33 +574,43 @@ void CursorManager::deregisterExecutor(PlanExecutor* exec) {
 StatusWith<ClientCursorPin> CursorManager::pinCursor(OperationContext* opCtx,
                                                      CursorId id,
                                                      AuthCheck checkSessionAuth) {
-    auto lockedPartition = _cursorMap->lockOnePartition(id);
-    auto it = lockedPartition->find(id);
-    if (it == lockedPartition->end()) {
-        return {ErrorCodes::CursorNotFound, str::stream() << "cursor id " << id << " not found"};
-    }
+    ClientCursor* cursor;
+    {
+        auto lockedPartition = _cursorMap->lockOnePartition(id);
+        auto it = lockedPartition->find(id);
+        if (it == lockedPartition->end()) {
+            return {ErrorCodes::CursorNotFound,
+                    str::stream() << "cursor id " << id << " not found"};
+        }
 
-    ClientCursor* cursor = it->second;
-    uassert(ErrorCodes::CursorInUse,
-            str::stream() << "cursor id " << id << " is already in use",
-            !cursor->_operationUsingCursor);
-    if (cursor->getExecutor()->isMarkedAsKilled()) {
-        // This cursor was killed while it was idle.
-        Status error = cursor->getExecutor()->getKillStatus();
-        deregisterAndDestroyCursor(std::move(lockedPartition),
-                                   opCtx,
-                                   std::unique_ptr<ClientCursor, ClientCursor::Deleter>(cursor));
-        return error;
-    }
-
-    if (checkSessionAuth == kCheckSession) {
-        auto cursorPrivilegeStatus = checkCursorSessionPrivilege(opCtx, cursor->getSessionId());
-        if (!cursorPrivilegeStatus.isOK()) {
-            return cursorPrivilegeStatus;
+        cursor = it->second;
+        uassert(ErrorCodes::CursorInUse,
+                str::stream() << "cursor id " << id << " is already in use",
+                !cursor->_operationUsingCursor);
+        if (cursor->getExecutor()->isMarkedAsKilled()) {
+            // This cursor was killed while it was idle.
+            Status error = cursor->getExecutor()->getKillStatus();
+            deregisterAndDestroyCursor(
+                std::move(lockedPartition),
+                opCtx,
+                std::unique_ptr<ClientCursor, ClientCursor::Deleter>(cursor));
+            return error;
         }
+
+        if (checkSessionAuth == kCheckSession) {
+            auto cursorPrivilegeStatus = checkCursorSessionPrivilege(opCtx, cursor->getSessionId());
+            if (!cursorPrivilegeStatus.isOK()) {
+                return cursorPrivilegeStatus;
+            }
+        }
+
+        cursor->_operationUsingCursor = opCtx;
     }
 
-    cursor->_operationUsingCursor = opCtx;
+    // Once pinned, the cursor can no longer be destroyed or timed out by anyone else, so the
+    // partition lock is not held while talking to the logical session cache. If vivifying fails,
+    // the pin hands the cursor back to this manager on destruction.
+    ClientCursorPin pin(opCtx, cursor);
 
     // We use pinning of a cursor as a proxy for active, user-initiated use of a cursor.  Therefor,
     // we pass down to the logical session cache and vivify the record (updating last use).
@@ -604,7 +622,7 @@ StatusWith<ClientCursorPin> CursorManager::pinCursor(OperationContext* opCtx,
         }
     }
 
-    return ClientCursorPin(opCtx, cursor);
+    return std::move(pin);
 }
 
 void CursorManager::unpin(OperationContext* opCtx,
@@ -685,28 +703,20 @@ size_t CursorManager::numCursors() const {
     return _cursorMap->size();
 }
 
-CursorId CursorManager::allocateCursorId_inlock() {
-    for (int i = 0; i < 10000; i++) {
-        // The leading two bits of a CursorId are used to determine if the cursor is registered on
-        // the global cursor manager.
-        CursorId id;
-        if (isGlobalManager()) {
-            // This is the global cursor manager, so generate a random number and make sure the
-            // first two bits are 01.
-            uint64_t mask = 0x3FFFFFFFFFFFFFFF;
-            uint64_t bitToSet = 1ULL << 62;
-            id = ((_random->nextInt64() & mask) | bitToSet);
-        } else {
-            // The first 2 bits are 0, the next 30 bits are the collection identifier, the next 32
-            // bits are random.
-            uint32_t myPart = static_cast<uint32_t>(_random->nextInt32());
-            id = cursorIdFromParts(_collectionCacheRuntimeId, myPart);
-        }
-        auto partition = _cursorMap->lockOnePartition(id);
-        if (partition->count(id) == 0)
-            return id;
+CursorId CursorManager::generateCursorId() const {
+    // The leading two bits of a CursorId are used to determine if the cursor is registered on
+    // the global cursor manager.
+    if (isGlobalManager()) {
+        // This is the global cursor manager, so generate a random number and make sure the
+        // first two bits are 01.
+        uint64_t mask = 0x3FFFFFFFFFFFFFFF;
+        uint64_t bitToSet = 1ULL << 62;
+        return ((cursorIdRandom().nextInt64() & mask) | bitToSet);
     }
-    fassertFailed(17360);
+    // The first 2 bits are 0, the next 30 bits are the collection identifier, the next 32
+    // bits are random.
+    uint32_t myPart = static_cast<uint32_t>(cursorIdRandom().nextInt32());
+    return cursorIdFromParts(_collectionCacheRuntimeId, myPart);
 }
 
 ClientCursorPin CursorManager::registerCursor(OperationContext* opCtx,
@@ -721,23 +731,26 @@ ClientCursorPin CursorManager::registerCursor(OperationContext* opCtx,
     cursorParams.exec.get_deleter().dismissDisposal();
     cursorParams.exec->unsetRegistered();
 
-    // Note we must hold the registration lock from now until insertion into '_cursorMap' to ensure
-    // we don't insert two cursors with the same cursor id.
-    stdx::lock_guard<SimpleMutex> lock(_registrationLock);
-    CursorId cursorId = allocateCursorId_inlock();
-    std::unique_ptr<ClientCursor, ClientCursor::Deleter> clientCursor(
-        new ClientCursor(std::move(cursorParams), this, cursorId, opCtx, now));
-
     // Register this cursor for lookup by transaction.
     if (opCtx->getLogicalSessionId() && opCtx->getTxnNumber()) {
         invariant(opCtx->getLogicalSessionId());
     }
 
-    // Transfer ownership of the cursor to '_cursorMap'.
-    auto partition = _cursorMap->lockOnePartition(cursorId);
-    ClientCursor* unownedCursor = clientCursor.release();
-    partition->emplace(cursorId, unownedCursor);
-    return ClientCursorPin(opCtx, unownedCursor);
+    for (int i = 0; i < 10000; i++) {
+        // The id is checked for uniqueness and the cursor inserted under the same partition lock,
+        // so no two cursors can end up with the same id.
+        CursorId cursorId = generateCursorId();
+        auto partition = _cursorMap->lockOnePartition(cursorId);
+        if (partition->count(cursorId) != 0)
+            continue;
+
+        // Transfer ownership of the cursor to '_cursorMap'.
+        ClientCursor* unownedCursor =
+            new ClientCursor(std::move(cursorParams), this, cursorId, opCtx, now);
+        partition->emplace(cursorId, unownedCursor);
+        return ClientCursorPin(opCtx, unownedCursor);
+    }
+    fassertFailed(17360);
 }
 
 void CursorManager::deregisterCursor(ClientCursor* cursor) {
@@ -47,7 +47,6 @@
 namespace mongo {
 
 class OperationContext;
-class PseudoRandom;
 class PlanExecutor;
 
 /**
@@ -256,7 +255,7 @@ private:
         std::size_t operator()(const PlanExecutor* exec, std::size_t nPartitions);
     };
 
-    CursorId allocateCursorId_inlock();
+    CursorId generateCursorId() const;
 
     ClientCursorPin _registerCursor(
         OperationContext* opCtx, std::unique_ptr<ClientCursor, ClientCursor::Deleter> clientCursor);
@@ -289,18 +288,15 @@ private:
     // There are several mutexes at work to protect concurrent access to data structures managed by
     // this cursor manager. The two registration data structures '_registeredPlanExecutors' and
     // '_cursorMap' are partitioned to decrease contention, and each partition of the structure is
-    // protected by its own mutex. Separately, there is a '_registrationLock' which protects
-    // concurrent access to '_random' for cursor id generation, and must be held from cursor id
-    // generation until insertion into '_cursorMap'. If you ever need to acquire more than one of
-    // these mutexes at once, you must follow the following rules:
-    // - '_registrationLock' must be acquired first, if at all.
-    // - Mutex(es) for '_registeredPlanExecutors' must be acquired next.
+    // protected by its own mutex. Cursor ids are drawn from a per-thread generator and checked for
+    // uniqueness under the '_cursorMap' partition mutex they are inserted under, so registering a
+    // cursor takes no manager-wide mutex. If you ever need to acquire more than one of these
+    // mutexes at once, you must follow the following rules:
+    // - Mutex(es) for '_registeredPlanExecutors' must be acquired first.
     // - Mutex(es) for '_cursorMap' must be acquired next.
     // - If you need to access multiple partitions within '_registeredPlanExecutors' or '_cursorMap'
     //   at once, you must acquire the mutexes for those partitions in ascending order, or use the
     //   partition helpers to acquire mutexes for all partitions.
-    mutable SimpleMutex _registrationLock;
-    std::unique_ptr<PseudoRandom> _random;
     Partitioned<stdx::unordered_set<PlanExecutor*>, kNumPartitions, PlanExecutorPartitioner>
         _registeredPlanExecutors;
     std::unique_ptr<Partitioned<stdx::unordered_map<CursorId, ClientCursor*>, kNumPartitions>>
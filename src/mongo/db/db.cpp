@@ -95,6 +95,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/periodic_runner_job_abort_expired_transactions.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/query/plan_cache_store.h"
 #include "mongo/db/repair_database_and_check_version.h"
 #include "mongo/db/repl/drop_pending_collection_reaper.h"
 #include "mongo/db/repl/oplog.h"
@@ -334,6 +335,16 @@ ExitCode _initAndListen(int listenPort) {
         }
         serviceContext->setTransportLayer(std::move(tl));
     }
+    // Load the persisted plan cache entries before any collection creates its plan cache.
+    if (!storageGlobalParams.readOnly) {
+        Status status = PlanCacheStore::get()->open(
+            (boost::filesystem::path(storageGlobalParams.dbpath) / PlanCacheStore::kFileName)
+                .string());
+        if (!status.isOK()) {
+            warning() << "Failed to load the persisted plan cache: " << status;
+        }
+    }
+
     initializeStorageEngine(serviceContext, StorageEngineInitFlags::kNone);
 
 #ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
@@ -951,6 +962,11 @@ void shutdownTask() {
 
     HealthLog::get(serviceContext).shutdown();
 
+    Status planCacheStatus = PlanCacheStore::get()->flush();
+    if (!planCacheStatus.isOK()) {
+        warning() << "Failed to persist the plan cache: " << planCacheStatus;
+    }
+
     // We should always be able to acquire the global lock at shutdown.
     //
     // TODO: This call chain uses the locker directly, because we do not want to start an
@@ -60,13 +60,15 @@ CachedPlanStage::CachedPlanStage(OperationContext* opCtx,
                                  CanonicalQuery* cq,
                                  const QueryPlannerParams& params,
                                  size_t decisionWorks,
-                                 PlanStage* root)
+                                 PlanStage* root,
+                                 bool pinned)
     : PlanStage(kStageType, opCtx),
       _collection(collection),
       _ws(ws),
       _canonicalQuery(cq),
       _plannerParams(params),
-      _decisionWorks(decisionWorks) {
+      _decisionWorks(decisionWorks),
+      _pinned(pinned) {
     invariant(_collection);
     _children.emplace_back(root);
 }
@@ -162,8 +164,18 @@ Status CachedPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
         }
     }
 
-    // If we're here, the trial period took more than 'maxWorksBeforeReplan' work cycles. This
-    // plan is taking too long, so we replan from scratch.
+    // If we're here, the trial period took more than 'maxWorksBeforeReplan' work cycles. A pinned
+    // plan keeps running; the feedback lets the cache evict it if this happens repeatedly.
+    if (_pinned) {
+        LOG(1) << "Execution of pinned cached plan required " << maxWorksBeforeReplan
+               << " works, but was originally cached with only " << _decisionWorks
+               << " works. Not replanning query: " << redact(_canonicalQuery->toStringShort())
+               << " plan summary: " << Explain::getPlanSummary(child().get());
+        updatePlanCache();
+        return Status::OK();
+    }
+
+    // Otherwise this plan is taking too long, so we replan from scratch.
     LOG(1) << "Execution of cached plan required " << maxWorksBeforeReplan
            << " works, but was originally cached with only " << _decisionWorks
            << " works. Evicting cache entry and replanning query: "
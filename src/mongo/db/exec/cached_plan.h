@@ -59,7 +59,8 @@ public:
                     CanonicalQuery* cq,
                     const QueryPlannerParams& params,
                     size_t decisionWorks,
-                    PlanStage* root);
+                    PlanStage* root,
+                    bool pinned = false);
 
     bool isEOF() final;
 
@@ -84,6 +85,8 @@ public:
      * Feedback from the trial period is passed to the plan cache. If the performance is lower
      * than expected, the old plan is evicted and a new plan is selected from scratch (again
      * yielding according to 'yieldPolicy'). Otherwise, the cached plan is run.
+     *
+     * A pinned plan is always run; the plan cache decides from the feedback whether to evict it.
      */
     Status pickBestPlan(PlanYieldPolicy* yieldPolicy);
 
@@ -131,6 +134,9 @@ private:
     // cached.
     size_t _decisionWorks;
 
+    // Whether the cached plan is pinned, see PlanCacheEntry::pinned.
+    const bool _pinned;
+
     // If we fall back to re-planning the query, and there is just one resulting query solution,
     // that solution is owned here.
     std::unique_ptr<QuerySolution> _replannedQs;
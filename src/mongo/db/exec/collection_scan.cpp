@@ -36,6 +36,7 @@
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
+#include "mongo/db/exec/top_k_threshold.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/repl/optime.h"
@@ -62,6 +63,7 @@ CollectionScan::CollectionScan(OperationContext* opCtx,
     : PlanStage(kStageType, opCtx),
       _workingSet(workingSet),
       _filter(filter),
+      _compiledFilter(CompiledFilter::compile(filter)),
       _params(params),
       _isDead(false),
       _wsidForFetch(_workingSet->allocate()) {
@@ -191,6 +193,12 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         }
     }
 
+    if (_topKThreshold && _topKThreshold->excludes(record->data.toBson())) {
+        ++_specificStats.docsTested;
+        ++_specificStats.docsSkippedByThreshold;
+        return PlanStage::NEED_TIME;
+    }
+
     WorkingSetID id = _workingSet->allocate();
     WorkingSetMember* member = _workingSet->get(id);
     member->recordId = record->id;
@@ -200,6 +208,13 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
     return returnIfMatches(member, id, out);
 }
 
+void CollectionScan::setTopKThreshold(const TopKThreshold* threshold) {
+    if (_params.tailable || _params.stopApplyingFilterAfterFirstMatch || _endCondition) {
+        return;
+    }
+    _topKThreshold = threshold;
+}
+
 Status CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
     auto tsElem = record.data.toBson()[repl::OpTime::kTimestampFieldName];
     if (tsElem.type() != BSONType::bsonTimestamp) {
@@ -218,9 +233,10 @@ PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
                                                       WorkingSetID* out) {
     ++_specificStats.docsTested;
 
-    if (Filter::passes(member, _filter)) {
+    if (Filter::passes(member, _filter, _compiledFilter.get())) {
         if (_params.stopApplyingFilterAfterFirstMatch) {
             _filter = nullptr;
+            _compiledFilter.reset();
         }
         *out = memberID;
         return PlanStage::ADVANCED;
@@ -32,6 +32,7 @@
 
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/matcher/compiled_filter.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
 
@@ -41,6 +42,7 @@ struct Record;
 class SeekableRecordCursor;
 class WorkingSet;
 class OperationContext;
+class TopKThreshold;
 
 /**
  * Scans over a collection, starting at the RecordId provided in params and continuing until
@@ -72,6 +74,13 @@ public:
         return _latestOplogEntryTimestamp;
     }
 
+    /**
+     * Drops the documents 'threshold' excludes before they are checked against the filter. The
+     * threshold is owned by the SortStage consuming this scan. Ignored by scans that must see
+     * every document, such as tailable and oplog replay scans.
+     */
+    void setTopKThreshold(const TopKThreshold* threshold);
+
     std::unique_ptr<PlanStageStats> getStats() final;
 
     const SpecificStats* getSpecificStats() const final;
@@ -98,6 +107,12 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // '_filter' compiled into a flat program, or null if it has an unsupported shape.
+    std::unique_ptr<CompiledFilter> _compiledFilter;
+
+    // Not owned. Null unless a SortStage with a limit consumes this scan.
+    const TopKThreshold* _topKThreshold = nullptr;
+
     // If a document does not pass '_filter' but passes '_endCondition', stop scanning and return
     // IS_EOF.
     BSONObj _endConditionBSON;
@@ -1079,7 +1079,15 @@ StatusWith<NearStage::CoveredInterval*>  //
     scanParams.bounds.fields[s2FieldPosition].intervals.clear();
     std::unique_ptr<S2Region> region(buildS2Region(_currBounds));
 
-    std::vector<S2CellId> cover = ExpressionMapping::get2dsphereCovering(*region);
+    // The annulus alone determines the region, so repeated searches around the same point share
+    // the coverings of their first intervals.
+    BSONObj regionKey = BSON("center" << BSON_ARRAY(_currBounds.center().x
+                                                    << _currBounds.center().y)
+                                      << "inner"
+                                      << _currBounds.getInner()
+                                      << "outer"
+                                      << _currBounds.getOuter());
+    std::vector<S2CellId> cover = ExpressionMapping::get2dsphereCovering(*region, regionKey);
 
     // Generate a covering that does not intersect with any previous coverings
     S2CellUnion coverUnion;
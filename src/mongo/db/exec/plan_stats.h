@@ -193,7 +193,7 @@ struct CachedPlanStats : public SpecificStats {
 };
 
 struct CollectionScanStats : public SpecificStats {
-    CollectionScanStats() : docsTested(0), direction(1) {}
+    CollectionScanStats() : docsTested(0), docsSkippedByThreshold(0), direction(1) {}
 
     SpecificStats* clone() const final {
         CollectionScanStats* specific = new CollectionScanStats(*this);
@@ -203,6 +203,10 @@ struct CollectionScanStats : public SpecificStats {
     // How many documents did we check against our filter?
     size_t docsTested;
 
+    // How many of the documents tested were dropped by the top-k threshold of the SortStage
+    // consuming the scan, without being checked against the filter.
+    size_t docsSkippedByThreshold;
+
     // >0 if we're traversing the collection forwards. <0 if we're traversing it
     // backwards.
     int direction;
@@ -682,6 +686,9 @@ struct TextOrStats : public SpecificStats {
     }
 
     size_t fetches;
+
+    // The number of highest scoring documents the stage was asked for, or zero for all of them.
+    size_t topK = 0;
 };
 
 }  // namespace mongo
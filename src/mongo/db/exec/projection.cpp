@@ -63,6 +63,12 @@ ProjectionStage::ProjectionStage(OperationContext* opCtx,
     if (ProjectionStageParams::NO_FAST_PATH == _projImpl) {
         _exec.reset(
             new ProjectionExec(opCtx, params.projObj, params.fullExpression, params.collator));
+
+        // Dotted inclusions and exclusions don't need the general executor when the member holds
+        // a document.
+        if (SimpleProjectionExec::supports(_projObj)) {
+            _simpleExec = make_unique<SimpleProjectionExec>(_projObj);
+        }
     } else {
         // We shouldn't need the full expression if we're fast-pathing.
         invariant(NULL == params.fullExpression);
@@ -99,6 +105,9 @@ ProjectionStage::ProjectionStage(OperationContext* opCtx,
         } else {
             invariant(ProjectionStageParams::SIMPLE_DOC == params.projImpl);
         }
+
+        // Used for SIMPLE_DOC, and for COVERED_ONE_INDEX when the member holds a document.
+        _simpleExec = make_unique<SimpleProjectionExec>(_projObj);
     }
 }
 
@@ -126,29 +135,8 @@ void ProjectionStage::getSimpleInclusionFields(const BSONObj& projObj, FieldSet*
     }
 }
 
-// static
-void ProjectionStage::transformSimpleInclusion(const BSONObj& in,
-                                               const FieldSet& includedFields,
-                                               BSONObjBuilder& bob) {
-    // Look at every field in the source document and see if we're including it.
-    BSONObjIterator inputIt(in);
-    while (inputIt.more()) {
-        BSONElement elt = inputIt.next();
-        auto fieldIt = includedFields.find(elt.fieldNameStringData());
-        if (includedFields.end() != fieldIt) {
-            // If so, add it to the builder.
-            bob.append(elt);
-        }
-    }
-}
-
 Status ProjectionStage::transform(WorkingSetMember* member) {
-    // The default no-fast-path case.
-    if (ProjectionStageParams::NO_FAST_PATH == _projImpl) {
-        return _exec->transform(member);
-    }
-
-    BSONObjBuilder bob;
+    BSONObj projected;
 
     // Note that even if our fast path analysis is bug-free something that is
     // covered might be invalidated and just be an obj.  In this case we just go
@@ -156,18 +144,19 @@ Status ProjectionStage::transform(WorkingSetMember* member) {
     // is not available.
     //
     // SIMPLE_DOC implies that we expect an object so it's kind of redundant.
-    if ((ProjectionStageParams::SIMPLE_DOC == _projImpl) || member->hasObj()) {
-        // If we got here because of SIMPLE_DOC the planner shouldn't have messed up.
-        invariant(member->hasObj());
-
-        // Apply the SIMPLE_DOC projection.
-        transformSimpleInclusion(member->obj.value(), _includedFields, bob);
+    if (_simpleExec && member->hasObj()) {
+        projected = _simpleExec->transform(member->obj.value());
+    } else if (ProjectionStageParams::NO_FAST_PATH == _projImpl) {
+        // The default no-fast-path case.
+        return _exec->transform(member);
     } else {
+        // If we got here because of SIMPLE_DOC the planner messed up.
         invariant(ProjectionStageParams::COVERED_ONE_INDEX == _projImpl);
         // We're pulling data out of the key.
         invariant(1 == member->keyData.size());
         size_t keyIndex = 0;
 
+        BSONObjBuilder bob;
         // Look at every key element...
         BSONObjIterator keyIterator(member->keyData[0].keyData);
         while (keyIterator.more()) {
@@ -179,11 +168,12 @@ Status ProjectionStage::transform(WorkingSetMember* member) {
             }
             ++keyIndex;
         }
+        projected = bob.obj();
     }
 
     member->keyData.clear();
     member->recordId = RecordId();
-    member->obj = Snapshotted<BSONObj>(SnapshotId(), bob.obj());
+    member->obj = Snapshotted<BSONObj>(SnapshotId(), projected);
     member->transitionToOwnedObj();
     return Status::OK();
 }
@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/exec/projection_exec.h"
+#include "mongo/db/exec/simple_projection_exec.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
@@ -100,16 +101,6 @@ public:
      */
     static void getSimpleInclusionFields(const BSONObj& projObj, FieldSet* includedFields);
 
-    /**
-     * Applies a simple inclusion projection to 'in', including
-     * only the fields specified by 'includedFields'.
-     *
-     * The resulting document is constructed using 'bob'.
-     */
-    static void transformSimpleInclusion(const BSONObj& in,
-                                         const FieldSet& includedFields,
-                                         BSONObjBuilder& bob);
-
     static const char* kStageType;
 
 private:
@@ -117,6 +108,9 @@ private:
 
     std::unique_ptr<ProjectionExec> _exec;
 
+    // Applies the projection to members holding a document, if it is simple enough.
+    std::unique_ptr<SimpleProjectionExec> _simpleExec;
+
     // _ws is not owned by us.
     WorkingSet* _ws;
 
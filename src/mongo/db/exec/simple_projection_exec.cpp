@@ -0,0 +1,155 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/simple_projection_exec.h"
+
+#include <algorithm>
+
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+namespace {
+
+// Smallest initial builder size; also the BSONObjBuilder default.
+const int kMinBuilderSize = 512;
+
+}  // namespace
+
+// static
+bool SimpleProjectionExec::supports(const BSONObj& spec) {
+    for (auto&& elem : spec) {
+        if (elem.type() == Object || elem.type() == Array) {
+            return false;
+        }
+        // Rules out positional projections as well as unexpected operators.
+        if (mongoutils::str::contains(elem.fieldName(), '$')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SimpleProjectionExec::SimpleProjectionExec(const BSONObj& spec) : _nodes(1) {
+    for (auto&& elem : spec) {
+        if (mongoutils::str::equals(elem.fieldName(), "_id") && !elem.trueValue()) {
+            _includeId = false;
+        } else {
+            add(0, elem.fieldNameStringData(), elem.trueValue());
+        }
+    }
+}
+
+void SimpleProjectionExec::add(size_t node, StringData path, bool include) {
+    // Mirrors ProjectionExec::add().
+    if (path.empty()) {
+        _nodes[node].include = include;
+        return;
+    }
+    _nodes[node].include = !include;
+
+    const size_t dot = path.find('.');
+    const StringData subfield = path.substr(0, dot);
+    const StringData rest = dot == std::string::npos ? StringData() : path.substr(dot + 1);
+
+    size_t child;
+    auto it = _nodes[node].children.find(subfield);
+    if (it == _nodes[node].children.end()) {
+        child = _nodes.size();
+        _nodes.emplace_back();
+        _nodes[node].children[subfield] = child;
+    } else {
+        child = it->second;
+    }
+    add(child, rest, include);
+}
+
+BSONObj SimpleProjectionExec::transform(const BSONObj& in) {
+    BSONObjBuilder bob(std::max(_sizeHint, kMinBuilderSize));
+    for (auto&& elt : in) {
+        if (mongoutils::str::equals("_id", elt.fieldName())) {
+            if (_includeId) {
+                bob.append(elt);
+            }
+            continue;
+        }
+        appendField(&bob, elt, 0);
+    }
+    BSONObj out = bob.obj();
+    _sizeHint = out.objsize();
+    return out;
+}
+
+void SimpleProjectionExec::appendField(BSONObjBuilder* bob,
+                                       const BSONElement& elt,
+                                       size_t node) const {
+    // Mirrors ProjectionExec::append().
+    const auto& children = _nodes[node].children;
+    auto it = children.find(elt.fieldNameStringData());
+    if (it == children.end()) {
+        if (_nodes[node].include) {
+            bob->append(elt);
+        }
+        return;
+    }
+
+    const size_t child = it->second;
+    if (_nodes[child].children.empty() || !(elt.type() == Object || elt.type() == Array)) {
+        if (_nodes[child].include) {
+            bob->append(elt);
+        }
+    } else if (elt.type() == Object) {
+        BSONObjBuilder subBob(bob->subobjStart(elt.fieldNameStringData()));
+        for (auto&& subElt : elt.embeddedObject()) {
+            appendField(&subBob, subElt, child);
+        }
+    } else {
+        BSONArrayBuilder subBab(bob->subarrayStart(elt.fieldNameStringData()));
+        appendArray(&subBab, elt.embeddedObject(), child);
+    }
+}
+
+void SimpleProjectionExec::appendArray(BSONArrayBuilder* bab,
+                                       const BSONObj& array,
+                                       size_t node) const {
+    // Mirrors ProjectionExec::appendArray() without $slice.
+    for (auto&& elt : array) {
+        switch (elt.type()) {
+            case Array: {
+                BSONArrayBuilder subBab(bab->subarrayStart());
+                appendArray(&subBab, elt.embeddedObject(), node);
+                break;
+            }
+            case Object: {
+                BSONObjBuilder subBob(bab->subobjStart());
+                for (auto&& subElt : elt.embeddedObject()) {
+                    appendField(&subBob, subElt, node);
+                }
+                break;
+            }
+            default:
+                if (_nodes[node].include) {
+                    bab->append(elt);
+                }
+        }
+    }
+}
+
+}  // namespace mongo
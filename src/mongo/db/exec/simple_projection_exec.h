@@ -0,0 +1,74 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * Applies a projection made only of inclusions or only of exclusions of top-level or dotted paths,
+ * such as {_id: 0, a: 1, 'b.c': 1} or {'a.b': 0}, directly on BSON.
+ *
+ * The output matches ProjectionExec's, but is written into a single builder: embedded objects and
+ * arrays are built in place rather than as separate objects, and the builder is pre-sized from
+ * the previous output. Projections with $-operators, $meta, $slice or $elemMatch are not
+ * supported.
+ */
+class SimpleProjectionExec {
+public:
+    /**
+     * Returns whether 'spec' can be executed by a SimpleProjectionExec.
+     */
+    static bool supports(const BSONObj& spec);
+
+    explicit SimpleProjectionExec(const BSONObj& spec);
+
+    /**
+     * Returns the projection of 'in'.
+     */
+    BSONObj transform(const BSONObj& in);
+
+private:
+    // A path component of the projection. 'include' tells whether fields below this component
+    // which are not named by one of its children are kept, like ProjectionExec::_include.
+    struct Node {
+        bool include = true;
+        StringMap<size_t> children;
+    };
+
+    void add(size_t node, StringData path, bool include);
+
+    void appendField(BSONObjBuilder* bob, const BSONElement& elt, size_t node) const;
+
+    void appendArray(BSONArrayBuilder* bab, const BSONObj& array, size_t node) const;
+
+    // Node 0 stands for the root of the document.
+    std::vector<Node> _nodes;
+
+    bool _includeId = true;
+
+    // The size of the last output, used to size the builder of the next one.
+    int _sizeHint = 0;
+};
+
+}  // namespace mongo
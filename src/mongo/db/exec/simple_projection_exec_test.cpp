@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/simple_projection_exec.h"
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/exec/projection_exec.h"
+#include "mongo/db/json.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Asserts that SimpleProjectionExec and ProjectionExec produce the same output for 'specStr' on
+ * every document in 'docs'.
+ */
+void assertSameAsProjectionExec(const char* specStr, const std::vector<const char*>& docs) {
+    BSONObj spec = fromjson(specStr);
+    ASSERT(SimpleProjectionExec::supports(spec)) << spec;
+
+    QueryTestServiceContext serviceCtx;
+    auto opCtx = serviceCtx.makeOperationContext();
+    ProjectionExec exec(opCtx.get(), spec, nullptr, nullptr);
+    SimpleProjectionExec simpleExec(spec);
+
+    for (auto&& docStr : docs) {
+        BSONObj doc = fromjson(docStr);
+
+        WorkingSetMember wsm;
+        wsm.obj = Snapshotted<BSONObj>(SnapshotId(), doc);
+        wsm.transitionToOwnedObj();
+        ASSERT_OK(exec.transform(&wsm));
+
+        BSONObj projected = simpleExec.transform(doc);
+        ASSERT(SimpleBSONObjComparator::kInstance.evaluate(projected == wsm.obj.value()))
+            << "spec: " << spec << " doc: " << doc << " expected: " << wsm.obj.value()
+            << " actual: " << projected;
+    }
+}
+
+const std::vector<const char*> kDocs{
+    "{_id: 1, a: 1, b: 2, c: 3}",
+    "{b: 2, _id: 1, a: {b: 1, c: 2}}",
+    "{a: {b: {c: 1, d: 2}, e: 3}, b: [1, 2]}",
+    "{a: [{b: 1, c: 2}, 3, [{b: 4}, 5], {c: 6}], c: {a: 1}}",
+    "{a: 1, a: 2, b: {c: 1, c: 2}}",
+    "{x: 1}",
+    "{}",
+};
+
+TEST(SimpleProjectionExecTest, TopLevelInclusion) {
+    assertSameAsProjectionExec("{a: 1, b: 1}", kDocs);
+    assertSameAsProjectionExec("{_id: 0, a: 1, c: true}", kDocs);
+    assertSameAsProjectionExec("{_id: 1}", kDocs);
+}
+
+TEST(SimpleProjectionExecTest, DottedInclusion) {
+    assertSameAsProjectionExec("{'a.b': 1}", kDocs);
+    assertSameAsProjectionExec("{_id: 0, 'a.b.c': 1, 'a.e': 1, b: 1}", kDocs);
+    assertSameAsProjectionExec("{'a.b': 1, a: 1}", kDocs);
+}
+
+TEST(SimpleProjectionExecTest, Exclusion) {
+    assertSameAsProjectionExec("{a: 0}", kDocs);
+    assertSameAsProjectionExec("{_id: 0}", kDocs);
+    assertSameAsProjectionExec("{_id: 0, 'a.b': 0, c: false}", kDocs);
+    assertSameAsProjectionExec("{'a.b.d': 0}", kDocs);
+}
+
+TEST(SimpleProjectionExecTest, UnsupportedSpecs) {
+    ASSERT_FALSE(SimpleProjectionExec::supports(fromjson("{'a.$': 1}")));
+    ASSERT_FALSE(SimpleProjectionExec::supports(fromjson("{a: {$slice: 2}}")));
+    ASSERT_FALSE(SimpleProjectionExec::supports(fromjson("{a: {$elemMatch: {b: 1}}}")));
+    ASSERT_FALSE(SimpleProjectionExec::supports(fromjson("{a: 1, s: {$meta: 'textScore'}}")));
+}
+
+}  // namespace
+}  // namespace mongo
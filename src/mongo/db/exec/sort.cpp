@@ -33,6 +33,7 @@
 #include <algorithm>
 
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/exec/collection_scan.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/exec/working_set_computed_data.h"
@@ -90,6 +91,27 @@ SortStage::SortStage(OperationContext* opCtx,
         const WorkingSetComparator& cmp = *_sortKeyComparator;
         _dataSet.reset(new SortableDataItemSet(cmp));
     }
+
+    if (_limit > 0) {
+        pushDownTopKThreshold();
+    }
+}
+
+void SortStage::pushDownTopKThreshold() {
+    // The sort keys must be generated from the scanned documents as they are, without a collation.
+    if (child()->stageType() != STAGE_SORT_KEY_GENERATOR ||
+        static_cast<SortKeyGeneratorStage*>(child().get())->getCollator()) {
+        return;
+    }
+    PlanStage* scan = child()->getChildren()[0].get();
+    if (scan->stageType() != STAGE_COLLSCAN) {
+        return;
+    }
+
+    _topKThreshold = TopKThreshold::make(_pattern);
+    if (_topKThreshold) {
+        static_cast<CollectionScan*>(scan)->setTopKThreshold(_topKThreshold.get());
+    }
 }
 
 SortStage::~SortStage() {}
@@ -264,6 +286,9 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
             member->makeObjOwnedIfNeeded();
             _data.push_back(item);
             _memUsage = member->getMemUsage();
+            if (_topKThreshold) {
+                _topKThreshold->update(item.sortKey);
+            }
             return;
         }
         wsidToFree = item.wsid;
@@ -274,6 +299,9 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
             member->makeObjOwnedIfNeeded();
             _data[0] = item;
             _memUsage = member->getMemUsage();
+            if (_topKThreshold) {
+                _topKThreshold->update(item.sortKey);
+            }
         }
     } else {
         // Update data item set instead of vector
@@ -283,6 +311,9 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
             member->makeObjOwnedIfNeeded();
             _dataSet->insert(item);
             _memUsage += member->getMemUsage();
+            if (_topKThreshold && _dataSet->size() == limit) {
+                _topKThreshold->update(_dataSet->rbegin()->sortKey);
+            }
             return;
         }
         // Limit will be exceeded - compare with item with lowest key
@@ -303,6 +334,9 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
             _dataSet->erase(lastItemIt);
             member->makeObjOwnedIfNeeded();
             _dataSet->insert(item);
+            if (_topKThreshold) {
+                _topKThreshold->update(_dataSet->rbegin()->sortKey);
+            }
         }
     }
 
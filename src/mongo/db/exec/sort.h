@@ -33,6 +33,7 @@
 
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/exec/sort_key_generator.h"
+#include "mongo/db/exec/top_k_threshold.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/index_bounds.h"
@@ -144,6 +145,11 @@ private:
      */
     void addToBuffer(const SortableDataItem& item);
 
+    /**
+     * Shares '_topKThreshold' with the CollectionScan that produces our input, if any.
+     */
+    void pushDownTopKThreshold();
+
     /**
      * Sorts data buffer.
      * Assumes no more items will be added to buffer.
@@ -178,6 +184,10 @@ private:
 
     // The usage in bytes of all buffered data that we're sorting.
     size_t _memUsage;
+
+    // The sort key of the worst buffered item once the buffer holds '_limit' items. Null if there
+    // is no limit or the sort pattern is not supported.
+    std::unique_ptr<TopKThreshold> _topKThreshold;
 };
 
 }  // namespace mongo
@@ -64,6 +64,10 @@ public:
 
     const SpecificStats* getSpecificStats() const final;
 
+    const CollatorInterface* getCollator() const {
+        return _collator;
+    }
+
     static const char* kStageType;
 
 protected:
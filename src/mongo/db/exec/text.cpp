@@ -125,6 +125,17 @@ unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* opCtx,
 
         textScorer->addChildren(std::move(indexScanList));
 
+        // The TEXT_MATCH stage drops documents only for negations, phrases, or a case or
+        // diacritic sensitive term; otherwise TEXT_OR may stop at the documents that can be in
+        // the top k.
+        const auto& terms = _params.query.getTermsForBounds();
+        if (_params.topK && _params.query.getNegatedTerms().empty() &&
+            _params.query.getPositivePhr().empty() && _params.query.getNegatedPhr().empty() &&
+            !_params.query.getCaseSensitive() && !_params.query.getDiacriticSensitive() &&
+            !terms.empty() && terms.size() <= TextOrStage::kMaxTopKTerms) {
+            textScorer->setTopK(_params.topK, {terms.begin(), terms.end()});
+        }
+
         textMatchStage = make_unique<TextMatchStage>(
             opCtx, std::move(textScorer), _params.query, _params.spec, ws);
     } else {
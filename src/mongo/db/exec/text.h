@@ -63,6 +63,10 @@ struct TextStageParams {
     // True if we need the text score in the output, because the projection includes the 'textScore'
     // metadata field.
     bool wantTextScore = true;
+
+    // If non-zero, only the 'topK' documents with the highest text scores are needed, because the
+    // results are sorted by text score and limited to that many.
+    size_t topK = 0;
 };
 
 /**
@@ -28,7 +28,9 @@
 
 #include "mongo/db/exec/text_or.h"
 
+#include <algorithm>
 #include <map>
+#include <numeric>
 #include <vector>
 
 #include "mongo/db/concurrency/write_conflict_exception.h"
@@ -78,6 +80,18 @@ void TextOrStage::addChildren(Children childrenToAdd) {
                      std::make_move_iterator(childrenToAdd.end()));
 }
 
+void TextOrStage::setTopK(size_t limit, std::vector<std::string> terms) {
+    invariant(limit > 0);
+    invariant(terms.size() == _children.size());
+    invariant(terms.size() <= kMaxTopKTerms);
+    _topK = limit;
+    _terms = std::move(terms);
+    _termScoreBounds.assign(_children.size(), fts::MAX_WEIGHT);
+    _childIsEOF.assign(_children.size(), false);
+    _nextPruneAt = _topK;
+    _specificStats.topK = _topK;
+}
+
 bool TextOrStage::isEOF() {
     return _internalState == State::kDone;
 }
@@ -197,8 +211,33 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
 
     if (PlanStage::ADVANCED == childState) {
-        return addTerm(id, out);
+        StageState addTermState = addTerm(id, out);
+        if (_topK && _keysRead >= _nextPruneAt) {
+            if (pruneToTopK()) {
+                _scoreIterator = _scores.begin();
+                _internalState = State::kReturningResults;
+            } else {
+                _nextPruneAt = _keysRead + std::max(_topK, _scores.size() / 8);
+            }
+        }
+        return addTermState;
     } else if (PlanStage::IS_EOF == childState) {
+        if (_topK) {
+            // Nothing that this child has yet to return can add to a score any more.
+            _termScoreBounds[_currentChild] = 0;
+            _childIsEOF[_currentChild] = true;
+            if (++_numChildrenEOF < _children.size()) {
+                advanceToNextChild();
+                return PlanStage::NEED_TIME;
+            }
+
+            // The scores are all complete, so pruning cannot fail.
+            invariant(pruneToTopK());
+            _scoreIterator = _scores.begin();
+            _internalState = State::kReturningResults;
+            return PlanStage::NEED_TIME;
+        }
+
         // Done with this child.
         ++_currentChild;
 
@@ -239,17 +278,41 @@ PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
     }
 
     // Retrieve the record that contains the text score.
-    TextRecordData textRecordData = _scoreIterator->second;
-    ++_scoreIterator;
+    TextRecordData& textRecordData = _scoreIterator->second;
 
     // Ignore non-matched documents.
     if (textRecordData.score < 0) {
         invariant(textRecordData.wsid == WorkingSet::INVALID_ID);
+        ++_scoreIterator;
         return PlanStage::NEED_TIME;
     }
 
     WorkingSetMember* wsm = _ws->get(textRecordData.wsid);
 
+    if (wsm->getState() == WorkingSetMember::RID_AND_IDX) {
+        // Top-k evaluation defers fetching until the document is known to be a candidate.
+        invariant(_topK);
+        try {
+            if (!WorkingSetCommon::fetch(getOpCtx(), _ws, textRecordData.wsid, _recordCursor)) {
+                _ws->free(textRecordData.wsid);
+                ++_scoreIterator;
+                return PlanStage::NEED_TIME;
+            }
+            ++_specificStats.fetches;
+        } catch (const WriteConflictException&) {
+            // Leave _scoreIterator in place so that we fetch this document again.
+            *out = WorkingSet::INVALID_ID;
+            return PlanStage::NEED_YIELD;
+        }
+
+        const uint64_t allTerms =
+            _terms.size() == kMaxTopKTerms ? ~uint64_t(0) : (uint64_t(1) << _terms.size()) - 1;
+        if (textRecordData.termsSeen != allTerms) {
+            textRecordData.score = scoreDocument(wsm->obj.value());
+        }
+    }
+    ++_scoreIterator;
+
     // Populate the working set member with the text score and return it.
     wsm->addComputed(new TextScoreComputedData(textRecordData.score));
     *out = textRecordData.wsid;
@@ -261,6 +324,26 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
     invariant(wsm->getState() == WorkingSetMember::RID_AND_IDX);
     invariant(1 == wsm->keyData.size());
     const IndexKeyDatum newKeyData = wsm->keyData.back();  // copy to keep it around.
+
+    // Locate score within possibly compound key: {prefix,term,score,suffix}.
+    BSONObjIterator keyIt(newKeyData.keyData);
+    for (unsigned i = 0; i < _ftsSpec.numExtraBefore(); i++) {
+        keyIt.next();
+    }
+
+    keyIt.next();  // Skip past 'term'.
+
+    BSONElement scoreElement = keyIt.next();
+    double documentTermScore = scoreElement.number();
+
+    const size_t termIndex = _currentChild;
+    if (_topK) {
+        // Keys arrive in descending score order, so no later key of this term scores higher.
+        _termScoreBounds[termIndex] = documentTermScore;
+        ++_keysRead;
+        advanceToNextChild();
+    }
+
     TextRecordData* textRecordData = &_scores[wsm->recordId];
 
     if (textRecordData->score < 0) {
@@ -280,6 +363,15 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
             return NEED_TIME;
         }
 
+        if (_topK) {
+            // Keep the member in its index key state; returnResults() fetches the documents that
+            // survive pruning.
+            textRecordData->wsid = wsid;
+            textRecordData->score = documentTermScore;
+            textRecordData->termsSeen = uint64_t(1) << termIndex;
+            return NEED_TIME;
+        }
+
         // Our parent expects RID_AND_OBJ members, so we fetch the document here if we haven't
         // already.
         try {
@@ -308,22 +400,109 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         invariant(wsid != textRecordData->wsid);
         _ws->free(wsid);
         wsm = _ws->get(textRecordData->wsid);
-    }
 
-    // Locate score within possibly compound key: {prefix,term,score,suffix}.
-    BSONObjIterator keyIt(newKeyData.keyData);
-    for (unsigned i = 0; i < _ftsSpec.numExtraBefore(); i++) {
-        keyIt.next();
+        if (_topK) {
+            const uint64_t termBit = uint64_t(1) << termIndex;
+            if (textRecordData->termsSeen & termBit) {
+                return NEED_TIME;
+            }
+            textRecordData->termsSeen |= termBit;
+        }
     }
 
-    keyIt.next();  // Skip past 'term'.
-
-    BSONElement scoreElement = keyIt.next();
-    double documentTermScore = scoreElement.number();
-
     // Aggregate relevance score, term keys.
     textRecordData->score += documentTermScore;
     return NEED_TIME;
 }
 
+void TextOrStage::advanceToNextChild() {
+    for (size_t i = 1; i <= _children.size(); ++i) {
+        const size_t child = (_currentChild + i) % _children.size();
+        if (!_childIsEOF[child]) {
+            _currentChild = child;
+            return;
+        }
+    }
+}
+
+bool TextOrStage::pruneToTopK() {
+    const bool allChildrenEOF = _numChildrenEOF == _children.size();
+
+    std::vector<TextRecordData*> matches;
+    matches.reserve(_scores.size());
+    for (auto&& entry : _scores) {
+        if (entry.second.score >= 0) {
+            matches.push_back(&entry.second);
+        }
+    }
+
+    if (matches.size() <= _topK) {
+        // Every match is in the top k, but unless all keys have been read, documents that we have
+        // not seen yet may be as well.
+        return allChildrenEOF;
+    }
+
+    std::nth_element(matches.begin(),
+                     matches.begin() + (_topK - 1),
+                     matches.end(),
+                     [](const TextRecordData* lhs, const TextRecordData* rhs) {
+                         return lhs->score > rhs->score;
+                     });
+    const double threshold = matches[_topK - 1]->score;
+
+    // A document that has not been seen yet scores at most the sum of the bounds of all terms.
+    const double unseenBound =
+        std::accumulate(_termScoreBounds.begin(), _termScoreBounds.end(), 0.0);
+    if (unseenBound > threshold) {
+        return false;
+    }
+
+    // A document beyond the k-th one can only overtake it with the terms it has not been seen
+    // with yet. The ones that still can are fetched and scored from the document itself.
+    auto scoreBound = [this](const TextRecordData* data) {
+        double bound = data->score;
+        for (size_t i = 0; i < _termScoreBounds.size(); ++i) {
+            if (!(data->termsSeen & (uint64_t(1) << i))) {
+                bound += _termScoreBounds[i];
+            }
+        }
+        return bound;
+    };
+
+    size_t numCandidates = _topK;
+    for (size_t i = _topK; i < matches.size(); ++i) {
+        if (scoreBound(matches[i]) > threshold) {
+            ++numCandidates;
+        }
+    }
+
+    // Reading on lowers the bounds, which is cheaper than fetching many candidates.
+    if (!allChildrenEOF && numCandidates > 2 * _topK) {
+        return false;
+    }
+
+    for (size_t i = _topK; i < matches.size(); ++i) {
+        if (scoreBound(matches[i]) <= threshold) {
+            _ws->free(matches[i]->wsid);
+            matches[i]->wsid = WorkingSet::INVALID_ID;
+            matches[i]->score = -1;
+        }
+    }
+    return true;
+}
+
+double TextOrStage::scoreDocument(const BSONObj& obj) const {
+    fts::TermFrequencyMap termFrequencies;
+    _ftsSpec.scoreDocument(obj, &termFrequencies);
+
+    double score = 0;
+    for (auto&& term : _terms) {
+        auto it = termFrequencies.find(term);
+        if (it != termFrequencies.end()) {
+            score += it->second;
+        }
+    }
+    return score;
+}
+
 }  // namespace mongo
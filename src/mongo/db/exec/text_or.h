@@ -29,6 +29,8 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/plan_stage.h"
@@ -47,6 +49,12 @@ class OperationContext;
  * A blocking stage that returns the set of WSMs with RecordIDs of all of the documents that contain
  * the positive terms in the search query, as well as their scores.
  *
+ * After setTopK(), the stage only returns the documents that can be among the highest scoring
+ * ones. Each child scans the keys of one term from the highest to the lowest score, so the score of
+ * the last key read from every child bounds the scores that the child has yet to return. The
+ * children are read in turn, one key at a time, and reading stops as soon as no document that is
+ * not a candidate yet could outscore the current top k.
+ *
  * The WorkingSetMembers returned are fetched and in the LOC_AND_OBJ state.
  */
 class TextOrStage final : public PlanStage {
@@ -79,6 +87,17 @@ public:
 
     void addChildren(Children childrenToAdd);
 
+    /**
+     * Restricts the results to the ones that may be among the 'limit' highest scoring documents.
+     * 'terms' are the terms scanned by the children, in the order of the children. The documents
+     * returned must not be filtered out by any later stage, so this is only correct for queries
+     * without negations or phrases.
+     */
+    void setTopK(size_t limit, std::vector<std::string> terms);
+
+    // The number of terms that top-k evaluation can track for each document.
+    static const size_t kMaxTopKTerms = 64;
+
     bool isEOF() final;
 
     StageState doWork(WorkingSetID* out) final;
@@ -123,6 +142,23 @@ private:
      */
     StageState returnResults(WorkingSetID* out);
 
+    /**
+     * Top-k evaluation only. Moves _currentChild to the next child that is not EOF, if any.
+     */
+    void advanceToNextChild();
+
+    /**
+     * Top-k evaluation only. Returns true if the documents read so far include the top _topK and
+     * drops the ones that cannot be among them; returns false if more keys must be read first.
+     */
+    bool pruneToTopK();
+
+    /**
+     * Top-k evaluation only. Computes the score of a document that was not seen in the keys of
+     * every term, in the same way that the index keys were scored.
+     */
+    double scoreDocument(const BSONObj& obj) const;
+
     // The index spec used to determine where to find the score.
     FTSSpec _ftsSpec;
 
@@ -144,14 +180,28 @@ private:
         TextRecordData() : wsid(WorkingSet::INVALID_ID), score(0.0) {}
         WorkingSetID wsid;
         double score;
+        // Top-k evaluation only: bit i is set once the key of the i-th term has been read.
+        uint64_t termsSeen = 0;
     };
 
     typedef stdx::unordered_map<RecordId, TextRecordData, RecordId::Hasher> ScoreMap;
     ScoreMap _scores;
-    ScoreMap::const_iterator _scoreIterator;
+    ScoreMap::iterator _scoreIterator;
 
     TextOrStats _specificStats;
 
+    // State of top-k evaluation, see setTopK(). A _topK of zero returns all documents.
+    size_t _topK = 0;
+    std::vector<std::string> _terms;
+    // The score of the last key read from each child, or zero once the child is EOF.
+    std::vector<double> _termScoreBounds;
+    std::vector<bool> _childIsEOF;
+    size_t _numChildrenEOF = 0;
+    // pruneToTopK() looks at every document read so far, so it only runs once the number of keys
+    // read reaches _nextPruneAt, which grows with the number of documents.
+    size_t _keysRead = 0;
+    size_t _nextPruneAt = 0;
+
     // Members needed only for using the TextMatchableDocument.
     const MatchExpression* _filter;
     WorkingSetID _idRetrying;
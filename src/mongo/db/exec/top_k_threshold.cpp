@@ -0,0 +1,85 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/top_k_threshold.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/util/stringutils.h"
+
+namespace mongo {
+
+// static
+std::unique_ptr<TopKThreshold> TopKThreshold::make(const BSONObj& sortPattern) {
+    if (!internalQueryExecEnableTopKThreshold.load() || sortPattern.nFields() != 1) {
+        return nullptr;
+    }
+
+    // Excludes {$meta: ...} sorts.
+    BSONElement elt = sortPattern.firstElement();
+    if (!elt.isNumber()) {
+        return nullptr;
+    }
+
+    std::vector<std::string> pathParts;
+    splitStringDelim(elt.fieldName(), &pathParts, '.');
+    return std::unique_ptr<TopKThreshold>(
+        new TopKThreshold(std::move(pathParts), elt.number() < 0 ? -1 : 1));
+}
+
+TopKThreshold::TopKThreshold(std::vector<std::string> pathParts, int direction)
+    : _pathParts(std::move(pathParts)), _direction(direction) {}
+
+void TopKThreshold::update(const BSONObj& sortKey) {
+    _sortKey = sortKey;
+}
+
+bool TopKThreshold::excludes(const BSONObj& doc) const {
+    if (_sortKey.isEmpty()) {
+        return false;
+    }
+
+    // A path that is missing or runs into a scalar has a null sort key.
+    static const BSONObj kNull = BSON("" << BSONNULL);
+    BSONElement value;
+    BSONObj obj = doc;
+    for (size_t i = 0; i < _pathParts.size(); ++i) {
+        value = obj[_pathParts[i]];
+        if (value.type() == Array || value.type() == Undefined) {
+            // The sort key of an array depends on its elements; leave it to the sort.
+            return false;
+        }
+        if (i + 1 < _pathParts.size()) {
+            if (value.type() != Object) {
+                value = BSONElement();
+                break;
+            }
+            obj = value.embeddedObject();
+        }
+    }
+    if (value.eoo()) {
+        value = kNull.firstElement();
+    }
+
+    // Ties are kept, since the sort breaks them by RecordId.
+    return _direction * value.woCompare(_sortKey.firstElement(), false) > 0;
+}
+
+}  // namespace mongo
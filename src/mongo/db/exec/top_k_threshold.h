@@ -0,0 +1,72 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+/**
+ * The sort key of the k-th best document buffered by a SortStage with a limit of k, shared with
+ * the CollectionScan that feeds it. Once the buffer is full, a document that sorts strictly after
+ * the threshold cannot make the cut, so the scan drops it before it allocates a working set
+ * member or evaluates its filter.
+ *
+ * Only single-field sort patterns without a collation are supported: the scan compares the raw
+ * value of the document with the threshold, so the two must order the same way as sort keys do.
+ */
+class TopKThreshold {
+    MONGO_DISALLOW_COPYING(TopKThreshold);
+
+public:
+    /**
+     * Returns null if 'sortPattern' is not supported.
+     */
+    static std::unique_ptr<TopKThreshold> make(const BSONObj& sortPattern);
+
+    /**
+     * Sets the threshold to 'sortKey', the sort key of the k-th best document seen so far.
+     */
+    void update(const BSONObj& sortKey);
+
+    /**
+     * Returns true if 'doc' sorts strictly after the threshold. Documents whose sort key cannot be
+     * derived cheaply, such as those with an array on the sort path, are never excluded.
+     */
+    bool excludes(const BSONObj& doc) const;
+
+private:
+    TopKThreshold(std::vector<std::string> pathParts, int direction);
+
+    // The sort path, split on '.'.
+    const std::vector<std::string> _pathParts;
+
+    // 1 for an ascending sort, -1 for a descending one.
+    const int _direction;
+
+    // Empty until the buffer of the SortStage first fills up.
+    BSONObj _sortKey;
+};
+
+}  // namespace mongo
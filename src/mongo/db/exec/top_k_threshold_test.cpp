@@ -0,0 +1,90 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/top_k_threshold.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/json.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+TEST(TopKThresholdTest, UnsupportedSortPatterns) {
+    ASSERT_FALSE(TopKThreshold::make(fromjson("{a: 1, b: 1}")));
+    ASSERT_FALSE(TopKThreshold::make(fromjson("{score: {$meta: 'textScore'}}")));
+    ASSERT_TRUE(TopKThreshold::make(fromjson("{'a.b': -1}")));
+}
+
+TEST(TopKThresholdTest, DisabledByKnob) {
+    internalQueryExecEnableTopKThreshold.store(false);
+    ON_BLOCK_EXIT([] { internalQueryExecEnableTopKThreshold.store(true); });
+    ASSERT_FALSE(TopKThreshold::make(fromjson("{a: 1}")));
+}
+
+TEST(TopKThresholdTest, ExcludesNothingUntilUpdated) {
+    auto threshold = TopKThreshold::make(fromjson("{a: 1}"));
+    ASSERT_FALSE(threshold->excludes(fromjson("{a: 100}")));
+}
+
+TEST(TopKThresholdTest, AscendingExcludesLargerValues) {
+    auto threshold = TopKThreshold::make(fromjson("{a: 1}"));
+    threshold->update(BSON("" << 5));
+    ASSERT_FALSE(threshold->excludes(fromjson("{a: 4}")));
+    ASSERT_FALSE(threshold->excludes(fromjson("{a: 5.0}")));
+    ASSERT_TRUE(threshold->excludes(fromjson("{a: 6}")));
+    ASSERT_TRUE(threshold->excludes(fromjson("{a: 'str'}")));
+
+    // Missing values sort as null, before any number.
+    ASSERT_FALSE(threshold->excludes(fromjson("{b: 6}")));
+}
+
+TEST(TopKThresholdTest, DescendingExcludesSmallerValues) {
+    auto threshold = TopKThreshold::make(fromjson("{a: -1}"));
+    threshold->update(BSON("" << 5));
+    ASSERT_TRUE(threshold->excludes(fromjson("{a: 4}")));
+    ASSERT_FALSE(threshold->excludes(fromjson("{a: 5}")));
+    ASSERT_FALSE(threshold->excludes(fromjson("{a: 6}")));
+    ASSERT_TRUE(threshold->excludes(fromjson("{b: 6}")));
+}
+
+TEST(TopKThresholdTest, DottedPath) {
+    auto threshold = TopKThreshold::make(fromjson("{'a.b': 1}"));
+    threshold->update(BSON("" << 5));
+    ASSERT_FALSE(threshold->excludes(fromjson("{a: {b: 1}}")));
+    ASSERT_TRUE(threshold->excludes(fromjson("{a: {b: 9}}")));
+
+    // A scalar on the path yields a null sort key.
+    threshold->update(BSON("" << BSONNULL));
+    ASSERT_FALSE(threshold->excludes(fromjson("{a: 3}")));
+    ASSERT_TRUE(threshold->excludes(fromjson("{a: {b: 3}}")));
+}
+
+TEST(TopKThresholdTest, ArraysAreNeverExcluded) {
+    auto threshold = TopKThreshold::make(fromjson("{'a.b': 1}"));
+    threshold->update(BSON("" << 5));
+    ASSERT_FALSE(threshold->excludes(fromjson("{a: [{b: 9}]}")));
+    ASSERT_FALSE(threshold->excludes(fromjson("{a: {b: [9, 10]}}")));
+}
+
+}  // namespace
+}  // namespace mongo
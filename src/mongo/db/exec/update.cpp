@@ -335,7 +335,8 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                                                           true,
                                                           driver->modsAffectIndices(),
                                                           _params.opDebug,
-                                                          &args);
+                                                          &args,
+                                                          driver->modifiedPaths());
             }
         }
 
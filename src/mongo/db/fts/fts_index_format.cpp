@@ -34,6 +34,7 @@
 
 #include "mongo/base/init.h"
 #include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/fts/fts_element_iterator.h"
 #include "mongo/db/fts/fts_index_format.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/util/hex.h"
@@ -204,6 +205,53 @@ void FTSIndexFormat::getKeys(const FTSSpec& spec, const BSONObj& obj, BSONObjSet
     }
 }
 
+bool FTSIndexFormat::generatesSameKeys(const FTSSpec& spec,
+                                       const BSONObj& lhs,
+                                       const BSONObj& rhs) {
+    // Version 1 indexes score documents with their own traversal, so don't try to reason about
+    // them here.
+    if (spec.getTextIndexVersion() == TEXT_INDEX_VERSION_1) {
+        return false;
+    }
+
+    try {
+        for (unsigned i = 0; i < spec.numExtraBefore(); i++) {
+            if (!extractNonFTSKeyElement(lhs, spec.extraBefore(i))
+                     .binaryEqualValues(extractNonFTSKeyElement(rhs, spec.extraBefore(i)))) {
+                return false;
+            }
+        }
+
+        for (unsigned i = 0; i < spec.numExtraAfter(); i++) {
+            if (!extractNonFTSKeyElement(lhs, spec.extraAfter(i))
+                     .binaryEqualValues(extractNonFTSKeyElement(rhs, spec.extraAfter(i)))) {
+                return false;
+            }
+        }
+
+        // The terms and their scores depend only on the sequence of (text, language, weight)
+        // triples produced by the element iterator, so identical sequences yield identical keys.
+        FTSElementIterator lhsIt(spec, lhs);
+        FTSElementIterator rhsIt(spec, rhs);
+        while (lhsIt.more()) {
+            if (!rhsIt.more()) {
+                return false;
+            }
+
+            FTSIteratorValue lhsVal = lhsIt.next();
+            FTSIteratorValue rhsVal = rhsIt.next();
+            if (lhsVal._language != rhsVal._language || lhsVal._weight != rhsVal._weight ||
+                strcmp(lhsVal._text, rhsVal._text) != 0) {
+                return false;
+            }
+        }
+        return !rhsIt.more();
+    } catch (const DBException&) {
+        // Let getKeys() surface the error, if any, for whichever document is invalid.
+        return false;
+    }
+}
+
 BSONObj FTSIndexFormat::getIndexKey(double weight,
                                     const string& term,
                                     const BSONObj& indexPrefix,
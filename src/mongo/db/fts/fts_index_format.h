@@ -46,6 +46,13 @@ class FTSIndexFormat {
 public:
     static void getKeys(const FTSSpec& spec, const BSONObj& document, BSONObjSet* keys);
 
+    /**
+     * Returns true if getKeys() is known to generate the same keys for 'lhs' and 'rhs', without
+     * tokenizing either document: every text-indexable string, with its language and weight, and
+     * every non-text key field must be identical. A false return only means the keys may differ.
+     */
+    static bool generatesSameKeys(const FTSSpec& spec, const BSONObj& lhs, const BSONObj& rhs);
+
     /**
      * Helper method to get return entry from the FTSIndex as a BSONObj
      * @param weight, the weight of the term in the entry
@@ -325,5 +325,45 @@ TEST(FTSIndexFormat, GetKeysWithPositionalPathAllowed) {
         ASSERT_BSONELT_EQ(it.next(), fromjson("{'': 'foo'}").firstElement());
     }
 }
+
+TEST(FTSIndexFormat, GeneratesSameKeysWhenOnlyNonTextFieldsChange) {
+    FTSSpec spec(assertGet(FTSSpec::fixSpec(BSON("key" << BSON("$**"
+                                                               << "text")))));
+    BSONObj from = fromjson("{_id: 1, title: 'cat sat', n: 1, sub: {body: 'dog ran'}}");
+    ASSERT_TRUE(FTSIndexFormat::generatesSameKeys(spec, from, from));
+    ASSERT_TRUE(FTSIndexFormat::generatesSameKeys(
+        spec, from, fromjson("{_id: 1, title: 'cat sat', n: 2, sub: {body: 'dog ran', m: 3}}")));
+
+    ASSERT_FALSE(FTSIndexFormat::generatesSameKeys(
+        spec, from, fromjson("{_id: 1, title: 'cat sat', n: 1, sub: {body: 'dog sat'}}")));
+    ASSERT_FALSE(FTSIndexFormat::generatesSameKeys(
+        spec, from, fromjson("{_id: 1, title: 'cat sat', n: 1, sub: {body: 'dog ran'}, x: 'a'}")));
+    ASSERT_FALSE(FTSIndexFormat::generatesSameKeys(
+        spec, from, fromjson("{_id: 1, title: 'cat sat', n: 1}")));
+    ASSERT_FALSE(FTSIndexFormat::generatesSameKeys(
+        spec,
+        from,
+        fromjson("{_id: 1, title: 'cat sat', n: 1, sub: {body: 'dog ran', language: 'spanish'}}")));
+}
+
+TEST(FTSIndexFormat, GeneratesSameKeysComparesExtraFields) {
+    FTSSpec spec(assertGet(FTSSpec::fixSpec(BSON("key" << BSON("x" << 1 << "data"
+                                                                   << "text"
+                                                                   << "y"
+                                                                   << 1)))));
+    BSONObj from = fromjson("{data: 'cat', x: 5, y: 'a', z: 1}");
+    ASSERT_TRUE(FTSIndexFormat::generatesSameKeys(
+        spec, from, fromjson("{data: 'cat', x: 5, y: 'a', z: 2}")));
+
+    // Numerically equal values of different types generate different keys.
+    ASSERT_FALSE(FTSIndexFormat::generatesSameKeys(
+        spec, from, fromjson("{data: 'cat', x: 5.0, y: 'a', z: 1}")));
+    ASSERT_FALSE(FTSIndexFormat::generatesSameKeys(
+        spec, from, fromjson("{data: 'cat', x: 5, y: 'b', z: 1}")));
+
+    // Documents getKeys() would reject are never reported as unchanged.
+    BSONObj invalid = fromjson("{data: 'cat', x: [5], y: 'a'}");
+    ASSERT_FALSE(FTSIndexFormat::generatesSameKeys(spec, invalid, invalid));
+}
 }  // namespace fts
 }  // namespace mongo
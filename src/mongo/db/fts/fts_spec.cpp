@@ -63,7 +63,94 @@ bool validateOverride(const string& override) {
     // can't contain a dot.
     return !override.empty()&& override[0] != '$' && override.find('.') == std::string::npos;
 }
+
+/**
+ * Per-thread scratch space for scoring documents. Index writes score one document at a time on
+ * the writing thread, so keeping the tokenizers (and the stemmers they own) and the term table
+ * between calls lets every string of a document, and every document of a multi-insert, reuse
+ * them instead of rebuilding them per string.
+ */
+class ScoringScratch {
+public:
+    struct Term {
+        std::string text;
+        ScoreHelperStruct helper;
+    };
+
+    /**
+     * Returns a tokenizer for 'language', creating it on first use by this thread.
+     */
+    FTSTokenizer* tokenizer(const FTSLanguage* language) {
+        for (auto&& cached : _tokenizers) {
+            if (cached.first == language) {
+                return cached.second.get();
+            }
+        }
+        _tokenizers.emplace_back(language, language->createTokenizer());
+        return _tokenizers.back().second.get();
+    }
+
+    /**
+     * Forgets the terms counted for the previous string.
+     */
+    void beginString() {
+        if (_slots.size() > kMaxRetainedTerms) {
+            _slots.clear();
+        }
+        ++_generation;
+        _numTerms = 0;
+    }
+
+    /**
+     * Returns the counters for 'term' within the current string. Terms seen by an earlier string
+     * reuse both their table slot and their buffer, so the common case doesn't allocate.
+     */
+    ScoreHelperStruct& term(StringData term) {
+        Slot& slot = _slots[term];
+        if (slot.generation != _generation) {
+            slot.generation = _generation;
+            slot.index = _numTerms++;
+            if (slot.index == _terms.size()) {
+                _terms.emplace_back();
+            }
+            Term& entry = _terms[slot.index];
+            entry.text.assign(term.rawData(), term.size());
+            entry.helper = ScoreHelperStruct();
+        }
+        return _terms[slot.index].helper;
+    }
+
+    /**
+     * The distinct terms of the current string, in order of first appearance.
+     */
+    const Term* begin() const {
+        return _terms.data();
+    }
+    const Term* end() const {
+        return _terms.data() + _numTerms;
+    }
+
+private:
+    // Bounds the memory a thread keeps after scoring documents with a very large vocabulary.
+    static constexpr size_t kMaxRetainedTerms = 64 * 1024;
+
+    struct Slot {
+        uint64_t generation = 0;
+        size_t index = 0;
+    };
+
+    std::vector<std::pair<const FTSLanguage*, std::unique_ptr<FTSTokenizer>>> _tokenizers;
+    StringMap<Slot> _slots;
+    std::vector<Term> _terms;
+    size_t _numTerms = 0;
+    uint64_t _generation = 0;
+};
+
+ScoringScratch& scoringScratch() {
+    thread_local ScoringScratch scratch;
+    return scratch;
 }
+}  // namespace
 
 FTSSpec::FTSSpec(const BSONObj& indexInfo) {
     // indexInfo is a text index spec.  Text index specs pass through fixSpec() before
@@ -181,11 +268,11 @@ void FTSSpec::scoreDocument(const BSONObj& obj, TermFrequencyMap* term_freqs) co
     }
 
     FTSElementIterator it(*this, obj);
+    ScoringScratch& scratch = scoringScratch();
 
     while (it.more()) {
         FTSIteratorValue val = it.next();
-        std::unique_ptr<FTSTokenizer> tokenizer(val._language->createTokenizer());
-        _scoreStringV2(tokenizer.get(), val._text, term_freqs, val._weight);
+        _scoreStringV2(scratch.tokenizer(val._language), val._text, term_freqs, val._weight);
     }
 }
 
@@ -193,16 +280,15 @@ void FTSSpec::_scoreStringV2(FTSTokenizer* tokenizer,
                              StringData raw,
                              TermFrequencyMap* docScores,
                              double weight) const {
-    ScoreHelperMap terms;
+    ScoringScratch& scratch = scoringScratch();
+    scratch.beginString();
 
     unsigned numTokens = 0;
 
     tokenizer->reset(raw.rawData(), FTSTokenizer::kFilterStopWords);
 
     while (tokenizer->moveNext()) {
-        StringData term = tokenizer->get();
-
-        ScoreHelperStruct& data = terms[term];
+        ScoreHelperStruct& data = scratch.term(tokenizer->get());
 
         if (data.exp) {
             data.exp *= 2;
@@ -214,9 +300,9 @@ void FTSSpec::_scoreStringV2(FTSTokenizer* tokenizer,
         numTokens++;
     }
 
-    for (ScoreHelperMap::const_iterator i = terms.begin(); i != terms.end(); ++i) {
-        const string& term = i->first;
-        const ScoreHelperStruct& data = i->second;
+    for (const auto& entry : scratch) {
+        const string& term = entry.text;
+        const ScoreHelperStruct& data = entry.helper;
 
         // in order to adjust weights as a function of term count as it
         // relates to total field length. ie. is this the only word or
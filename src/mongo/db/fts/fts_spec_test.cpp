@@ -263,6 +263,27 @@ TEST(FTSSpec, ScoreRepeatWord) {
     ASSERT(m["run"] > m["sat"]);
 }
 
+TEST(FTSSpec, ScoreIsIndependentOfPreviouslyScoredDocuments) {
+    BSONObj indexSpec = BSON("key" << BSON("$**"
+                                           << "text"));
+    FTSSpec spec(assertGet(FTSSpec::fixSpec(indexSpec)));
+
+    BSONObj english = fromjson("{title: 'runs running ran', body: 'run cat'}");
+    BSONObj spanish =
+        fromjson("{title: 'corriendo corre', body: 'run gato gatos', language: 'spanish'}");
+
+    TermFrequencyMap first;
+    spec.scoreDocument(english, &first);
+
+    TermFrequencyMap other;
+    spec.scoreDocument(spanish, &other);
+    ASSERT_FALSE(other.empty());
+
+    TermFrequencyMap second;
+    spec.scoreDocument(english, &second);
+    ASSERT(first == second);
+}
+
 TEST(FTSSpec, Extra1) {
     BSONObj user = BSON("key" << BSON("data"
                                       << "text"));
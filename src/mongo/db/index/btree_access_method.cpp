@@ -68,4 +68,12 @@ void BtreeAccessMethod::doGetKeys(const BSONObj& obj,
     _keyGenerator->getKeys(obj, keys, multikeyPaths);
 }
 
+void BtreeAccessMethod::doGetKeyStrings(const BSONObj& obj,
+                                        KeyString::Version version,
+                                        Ordering ordering,
+                                        KeyStringSet* keys,
+                                        MultikeyPaths* multikeyPaths) const {
+    _keyGenerator->getKeyStrings(obj, version, ordering, keys, multikeyPaths);
+}
+
 }  // namespace mongo
@@ -50,6 +50,12 @@ public:
 private:
     void doGetKeys(const BSONObj& obj, BSONObjSet* keys, MultikeyPaths* multikeyPaths) const final;
 
+    void doGetKeyStrings(const BSONObj& obj,
+                         KeyString::Version version,
+                         Ordering ordering,
+                         KeyStringSet* keys,
+                         MultikeyPaths* multikeyPaths) const final;
+
     // Our keys differ for V0 and V1.
     std::unique_ptr<BtreeKeyGenerator> _keyGenerator;
 };
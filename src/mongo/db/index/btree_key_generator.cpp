@@ -31,6 +31,7 @@
 #include <boost/optional.hpp>
 
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/query/collation/collation_index_key.h"
@@ -93,6 +94,33 @@ void BtreeKeyGenerator::getKeys(const BSONObj& obj,
     }
 }
 
+void BtreeKeyGenerator::getKeyStrings(const BSONObj& obj,
+                                      KeyString::Version version,
+                                      Ordering ordering,
+                                      KeyStringSet* keys,
+                                      MultikeyPaths* multikeyPaths) const {
+    keys->clear();
+    getKeyStringsImpl(_fieldNames, _fixed, obj, version, ordering, keys, multikeyPaths);
+    if (keys->empty() && !_isSparse) {
+        keys->add(version, _nullKey, ordering);
+    }
+    keys->sortAndDedupe();
+}
+
+void BtreeKeyGenerator::getKeyStringsImpl(std::vector<const char*> fieldNames,
+                                          std::vector<BSONElement> fixed,
+                                          const BSONObj& obj,
+                                          KeyString::Version version,
+                                          Ordering ordering,
+                                          KeyStringSet* keys,
+                                          MultikeyPaths* multikeyPaths) const {
+    BSONObjSet bsonKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    getKeysImpl(std::move(fieldNames), std::move(fixed), obj, &bsonKeys, multikeyPaths);
+    for (const auto& key : bsonKeys) {
+        keys->add(version, key, ordering);
+    }
+}
+
 static void assertParallelArrays(const char* first, const char* second) {
     std::stringstream ss;
     ss << "cannot index parallel arrays [" << first << "] [" << second << "]";
@@ -234,6 +262,67 @@ void BtreeKeyGeneratorV0::getKeysImpl(std::vector<const char*> fieldNames,
     }
 }
 
+class BtreeKeyGeneratorV1::BSONObjSetSink final : public KeySink {
+public:
+    BSONObjSetSink(BSONObjSet* keys,
+                   const CollatorInterface* collator,
+                   const BSONSizeTracker& sizeTracker)
+        : _keys(keys), _collator(collator), _sizeTracker(sizeTracker) {}
+
+    void add(const std::vector<BSONElement>& fields) final {
+        BSONObjBuilder b(_sizeTracker);
+        for (const auto& field : fields) {
+            CollationIndexKey::collationAwareIndexKeyAppend(field, _collator, &b);
+        }
+        _keys->insert(b.obj());
+    }
+
+private:
+    BSONObjSet* const _keys;
+    const CollatorInterface* const _collator;
+    const BSONSizeTracker& _sizeTracker;
+};
+
+/**
+ * Encodes each key field by field, so that only strings translated by the collator pass through a
+ * temporary BSONObj.
+ */
+class BtreeKeyGeneratorV1::KeyStringSink final : public KeySink {
+public:
+    KeyStringSink(KeyStringSet* keys,
+                  KeyString::Version version,
+                  Ordering ordering,
+                  const CollatorInterface* collator)
+        : _keys(keys), _version(version), _ordering(ordering), _collator(collator) {}
+
+    void add(const std::vector<BSONElement>& fields) final {
+        auto& key = _keys->emplace(_version);
+        key.bsonSize = 5;  // The length prefix and the terminating EOO byte.
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (_collator && CollationIndexKey::isCollatableType(fields[i].type())) {
+                BSONObjBuilder b;
+                CollationIndexKey::collationAwareIndexKeyAppend(fields[i], _collator, &b);
+                _append(&key, b.done().firstElement(), i);
+            } else {
+                _append(&key, fields[i], i);
+            }
+        }
+        key.keyString.appendIndexKeyEnd();
+    }
+
+private:
+    void _append(KeyStringSet::Key* key, const BSONElement& field, size_t i) {
+        key->keyString.appendIndexKeyElement(field, _ordering.get(i) == -1);
+        // Key fields have empty names, which take a single byte.
+        key->bsonSize += field.size() - field.fieldNameSize() + 1;
+    }
+
+    KeyStringSet* const _keys;
+    const KeyString::Version _version;
+    const Ordering _ordering;
+    const CollatorInterface* const _collator;
+};
+
 BtreeKeyGeneratorV1::BtreeKeyGeneratorV1(std::vector<const char*> fieldNames,
                                          std::vector<BSONElement> fixed,
                                          bool isSparse,
@@ -283,7 +372,7 @@ BSONElement BtreeKeyGeneratorV1::extractNextElement(const BSONObj& obj,
 void BtreeKeyGeneratorV1::_getKeysArrEltFixed(std::vector<const char*>* fieldNames,
                                               std::vector<BSONElement>* fixed,
                                               const BSONElement& arrEntry,
-                                              BSONObjSet* keys,
+                                              KeySink* keys,
                                               unsigned numNotFound,
                                               const BSONElement& arrObjElt,
                                               const std::set<size_t>& arrIdxs,
@@ -343,15 +432,51 @@ void BtreeKeyGeneratorV1::getKeysImpl(std::vector<const char*> fieldNames,
         invariant(multikeyPaths->empty());
         multikeyPaths->resize(fieldNames.size());
     }
-    getKeysImplWithArray(
-        std::move(fieldNames), std::move(fixed), obj, keys, 0, _emptyPositionalInfo, multikeyPaths);
+    BSONObjSetSink sink(keys, _collator, _sizeTracker);
+    getKeysImplWithArray(std::move(fieldNames),
+                         std::move(fixed),
+                         obj,
+                         &sink,
+                         0,
+                         _emptyPositionalInfo,
+                         multikeyPaths);
+}
+
+void BtreeKeyGeneratorV1::getKeyStringsImpl(std::vector<const char*> fieldNames,
+                                            std::vector<BSONElement> fixed,
+                                            const BSONObj& obj,
+                                            KeyString::Version version,
+                                            Ordering ordering,
+                                            KeyStringSet* keys,
+                                            MultikeyPaths* multikeyPaths) const {
+    KeyStringSink sink(keys, version, ordering, _collator);
+    if (_isIdIndex) {
+        BSONElement e = obj["_id"];
+        sink.add({e.eoo() ? nullElt : e});
+        if (multikeyPaths) {
+            multikeyPaths->resize(1);
+        }
+        return;
+    }
+
+    if (multikeyPaths) {
+        invariant(multikeyPaths->empty());
+        multikeyPaths->resize(fieldNames.size());
+    }
+    getKeysImplWithArray(std::move(fieldNames),
+                         std::move(fixed),
+                         obj,
+                         &sink,
+                         0,
+                         _emptyPositionalInfo,
+                         multikeyPaths);
 }
 
 void BtreeKeyGeneratorV1::getKeysImplWithArray(
     std::vector<const char*> fieldNames,
     std::vector<BSONElement> fixed,
     const BSONObj& obj,
-    BSONObjSet* keys,
+    KeySink* keys,
     unsigned numNotFound,
     const std::vector<PositionalPathInfo>& positionalInfo,
     MultikeyPaths* multikeyPaths) const {
@@ -423,11 +548,7 @@ void BtreeKeyGeneratorV1::getKeysImplWithArray(
         if (_isSparse && numNotFound == fieldNames.size()) {
             return;
         }
-        BSONObjBuilder b(_sizeTracker);
-        for (std::vector<BSONElement>::iterator i = fixed.begin(); i != fixed.end(); ++i) {
-            CollationIndexKey::collationAwareIndexKeyAppend(*i, _collator, &b);
-        }
-        keys->insert(b.obj());
+        keys->add(fixed);
     } else if (arrElt.embeddedObject().firstElement().eoo()) {
         // We've encountered an empty array.
         if (multikeyPaths && mayExpandArrayUnembedded) {
@@ -36,6 +36,7 @@
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/multikey_paths.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/storage/key_string.h"
 
 namespace mongo {
 
@@ -61,6 +62,16 @@ public:
 
     void getKeys(const BSONObj& obj, BSONObjSet* keys, MultikeyPaths* multikeyPaths) const;
 
+    /**
+     * Replaces the contents of 'keys' with the keys getKeys() would generate for 'obj', encoded as
+     * KeyStrings of 'version' ordered by 'ordering', sorted and without duplicates.
+     */
+    void getKeyStrings(const BSONObj& obj,
+                       KeyString::Version version,
+                       Ordering ordering,
+                       KeyStringSet* keys,
+                       MultikeyPaths* multikeyPaths) const;
+
 protected:
     // These are used by the getKeysImpl(s) below.
     std::vector<const char*> _fieldNames;
@@ -76,6 +87,18 @@ private:
                              BSONObjSet* keys,
                              MultikeyPaths* multikeyPaths) const = 0;
 
+    /**
+     * Generates the keys for getKeyStrings(), before the null key is added and the keys are
+     * sorted. The default encodes the keys generated by getKeysImpl().
+     */
+    virtual void getKeyStringsImpl(std::vector<const char*> fieldNames,
+                                   std::vector<BSONElement> fixed,
+                                   const BSONObj& obj,
+                                   KeyString::Version version,
+                                   Ordering ordering,
+                                   KeyStringSet* keys,
+                                   MultikeyPaths* multikeyPaths) const;
+
     std::vector<BSONElement> _fixed;
 };
 
@@ -112,6 +135,18 @@ public:
     virtual ~BtreeKeyGeneratorV1() {}
 
 private:
+    /**
+     * Receives each generated key as its fields in key pattern order.
+     */
+    class KeySink {
+    public:
+        virtual ~KeySink() = default;
+        virtual void add(const std::vector<BSONElement>& fields) = 0;
+    };
+
+    class BSONObjSetSink;
+    class KeyStringSink;
+
     /**
      * Stores info regarding traversal of a positional path. A path through a document is
      * considered positional if this path element names an array element. Generally this means
@@ -186,12 +221,24 @@ private:
                      MultikeyPaths* multikeyPaths) const final;
 
     /**
-     * This recursive method does the heavy-lifting for getKeysImpl().
+     * Generates the keys directly into KeyStrings, without building a BSONObj for each of them.
+     */
+    void getKeyStringsImpl(std::vector<const char*> fieldNames,
+                           std::vector<BSONElement> fixed,
+                           const BSONObj& obj,
+                           KeyString::Version version,
+                           Ordering ordering,
+                           KeyStringSet* keys,
+                           MultikeyPaths* multikeyPaths) const final;
+
+    /**
+     * This recursive method does the heavy-lifting for getKeysImpl() and getKeyStringsImpl(),
+     * passing each key it generates to 'keys'.
      */
     void getKeysImplWithArray(std::vector<const char*> fieldNames,
                               std::vector<BSONElement> fixed,
                               const BSONObj& obj,
-                              BSONObjSet* keys,
+                              KeySink* keys,
                               unsigned numNotFound,
                               const std::vector<PositionalPathInfo>& positionalInfo,
                               MultikeyPaths* multikeyPaths) const;
@@ -241,7 +288,7 @@ private:
     void _getKeysArrEltFixed(std::vector<const char*>* fieldNames,
                              std::vector<BSONElement>* fixed,
                              const BSONElement& arrEntry,
-                             BSONObjSet* keys,
+                             KeySink* keys,
                              unsigned numNotFound,
                              const BSONElement& arrObjElt,
                              const std::set<size_t>& arrIdxs,
@@ -33,6 +33,7 @@
 #include "mongo/db/index/btree_key_generator.h"
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 
 #include "mongo/bson/simple_bsonobj_comparator.h"
@@ -95,6 +96,55 @@ bool keysetsEqual(const BSONObjSet& expectedKeys, const BSONObjSet& actualKeys)
     return true;
 }
 
+bool typeBitsEqual(const KeyString::TypeBits& lhs, const KeyString::TypeBits& rhs) {
+    return lhs.getSize() == rhs.getSize() &&
+        std::memcmp(lhs.getBuffer(), rhs.getBuffer(), lhs.getSize()) == 0;
+}
+
+/**
+ * Returns true if 'actualKeys' holds exactly the KeyString encodings of 'expectedKeys', including
+ * their TypeBits and BSON sizes.
+ */
+bool keyStringsEqual(const BSONObjSet& expectedKeys,
+                     Ordering ordering,
+                     const KeyStringSet& actualKeys) {
+    KeyStringSet expectedKeyStrings;
+    for (const auto& key : expectedKeys) {
+        expectedKeyStrings.add(KeyString::kLatestVersion, key, ordering);
+    }
+    expectedKeyStrings.sortAndDedupe();
+
+    if (expectedKeyStrings.size() != actualKeys.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < actualKeys.size(); ++i) {
+        const auto& expected = expectedKeyStrings[i];
+        const auto& actual = actualKeys[i];
+        if (expected.keyString.compare(actual.keyString) != 0 ||
+            !typeBitsEqual(expected.keyString.getTypeBits(), actual.keyString.getTypeBits()) ||
+            expected.bsonSize != actual.bsonSize) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string dumpKeyStrings(const KeyStringSet& keys, Ordering ordering) {
+    std::stringstream ss;
+    ss << "[ ";
+    for (size_t i = 0; i < keys.size(); ++i) {
+        const auto& keyString = keys[i].keyString;
+        ss << KeyString::toBson(keyString.getBuffer(),
+                                keyString.getSize(),
+                                ordering,
+                                keyString.getTypeBits())
+           << " ";
+    }
+    ss << "]";
+
+    return ss.str();
+}
+
 bool testKeygen(const BSONObj& kp,
                 const BSONObj& obj,
                 const BSONObjSet& expectedKeys,
@@ -143,6 +193,30 @@ bool testKeygen(const BSONObj& kp,
     if (!match) {
         log() << "Expected: " << dumpMultikeyPaths(expectedMultikeyPaths) << ", "
               << "Actual: " << dumpMultikeyPaths(actualMultikeyPaths);
+        return false;
+    }
+
+    //
+    // Step 4: check that generating the keys as KeyStrings yields the encodings of the keys
+    // generated as BSON, with the same multikey paths.
+    //
+    const Ordering ordering = Ordering::make(kp);
+    KeyStringSet actualKeyStrings;
+    MultikeyPaths keyStringMultikeyPaths;
+    keyGen->getKeyStrings(
+        obj, KeyString::kLatestVersion, ordering, &actualKeyStrings, &keyStringMultikeyPaths);
+
+    match = keyStringsEqual(actualKeys, ordering, actualKeyStrings);
+    if (!match) {
+        log() << "Expected: " << dumpKeyset(actualKeys) << ", "
+              << "Actual KeyStrings: " << dumpKeyStrings(actualKeyStrings, ordering);
+        return false;
+    }
+
+    match = (keyStringMultikeyPaths == actualMultikeyPaths);
+    if (!match) {
+        log() << "Expected: " << dumpMultikeyPaths(actualMultikeyPaths) << ", "
+              << "Actual from KeyStrings: " << dumpMultikeyPaths(keyStringMultikeyPaths);
     }
 
     return match;
@@ -1160,4 +1234,41 @@ TEST(BtreeKeyGeneratorTest, GetCollationAwareKeysFromNestedArray) {
         testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths, false, &collator));
 }
 
+TEST(BtreeKeyGeneratorTest, GetKeyStringsSortsDescendingKeysInIndexOrder) {
+    BSONObj keyPattern = fromjson("{a: -1}");
+    BSONObj genKeysFrom = fromjson("{a: [2, 3, 1, 3]}");
+    BtreeKeyGeneratorV1 keyGen({"a"}, {BSONElement()}, false, nullptr);
+
+    const Ordering ordering = Ordering::make(keyPattern);
+    KeyStringSet keys;
+    keyGen.getKeyStrings(genKeysFrom, KeyString::kLatestVersion, ordering, &keys, nullptr);
+
+    ASSERT_EQ(keys.size(), 3U);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        const auto& keyString = keys[i].keyString;
+        ASSERT_BSONOBJ_EQ(BSON("" << static_cast<int>(3 - i)),
+                          KeyString::toBson(keyString.getBuffer(),
+                                            keyString.getSize(),
+                                            ordering,
+                                            keyString.getTypeBits()));
+    }
+}
+
+TEST(BtreeKeyGeneratorTest, GetKeyStringsReplacesKeysOfPreviousDocument) {
+    BSONObj keyPattern = fromjson("{a: 1}");
+    BtreeKeyGeneratorV1 keyGen({"a"}, {BSONElement()}, false, nullptr);
+
+    const Ordering ordering = Ordering::make(keyPattern);
+    KeyStringSet keys;
+    keyGen.getKeyStrings(
+        fromjson("{a: ['x', 'y', 'z']}"), KeyString::kLatestVersion, ordering, &keys, nullptr);
+    ASSERT_EQ(keys.size(), 3U);
+
+    keyGen.getKeyStrings(fromjson("{b: 1}"), KeyString::kLatestVersion, ordering, &keys, nullptr);
+    ASSERT_EQ(keys.size(), 1U);
+    ASSERT_EQ(KeyString(KeyString::kLatestVersion, BSON("" << BSONNULL), ordering)
+                  .compare(keys[0].keyString),
+              0);
+}
+
 }  // namespace
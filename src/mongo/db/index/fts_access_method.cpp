@@ -28,6 +28,7 @@
 
 #include "mongo/db/index/fts_access_method.h"
 #include "mongo/db/catalog/index_catalog_entry.h"
+#include "mongo/db/fts/fts_index_format.h"
 #include "mongo/db/index/expression_keys_private.h"
 #include "mongo/db/index/index_descriptor.h"
 
@@ -42,4 +43,8 @@ void FTSAccessMethod::doGetKeys(const BSONObj& obj,
     ExpressionKeysPrivate::getFTSKeys(obj, _ftsSpec, keys);
 }
 
+bool FTSAccessMethod::keysUnchanged(const BSONObj& from, const BSONObj& to) const {
+    return fts::FTSIndexFormat::generatesSameKeys(_ftsSpec, from, to);
+}
+
 }  // namespace mongo
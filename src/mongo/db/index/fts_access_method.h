@@ -53,6 +53,12 @@ private:
      */
     void doGetKeys(const BSONObj& obj, BSONObjSet* keys, MultikeyPaths* multikeyPaths) const final;
 
+    /**
+     * Compares the text-indexable strings and non-text key fields of 'from' and 'to' so that
+     * updates which leave them alone don't pay for tokenizing and stemming both documents.
+     */
+    bool keysUnchanged(const BSONObj& from, const BSONObj& to) const final;
+
     fts::FTSSpec _ftsSpec;
 };
 
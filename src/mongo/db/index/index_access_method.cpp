@@ -80,6 +80,16 @@ bool isMultikeyFromPaths(const MultikeyPaths& multikeyPaths) {
 }  // namespace
 MONGO_EXPORT_SERVER_PARAMETER(failIndexKeyTooLong, bool, true);
 
+// Number of sorted runs an index build may spill in the background while it scans the collection.
+MONGO_EXPORT_SERVER_PARAMETER(indexBuildSorterSpillThreads, int, 2)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "indexBuildSorterSpillThreads must be non-negative");
+        }
+        return Status::OK();
+    });
+
 //
 // Comparison for external sorter interface
 //
@@ -113,7 +123,10 @@ private:
 };
 
 IndexAccessMethod::IndexAccessMethod(IndexCatalogEntry* btreeState, SortedDataInterface* btree)
-    : _btreeState(btreeState), _descriptor(btreeState->descriptor()), _newInterface(btree) {
+    : _btreeState(btreeState),
+      _descriptor(btreeState->descriptor()),
+      _newInterface(btree),
+      _ordering(Ordering::make(_descriptor->keyPattern())) {
     verify(IndexDescriptor::isIndexVersionSupported(_descriptor->version()));
 }
 
@@ -133,6 +146,10 @@ Status IndexAccessMethod::insert(OperationContext* opCtx,
                                  int64_t* numInserted) {
     invariant(numInserted);
     *numInserted = 0;
+    if (auto version = _newInterface->acceptedKeyStringVersion()) {
+        return _insertKeyStrings(opCtx, obj, loc, options, *version, numInserted);
+    }
+
     BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
     MultikeyPaths multikeyPaths;
     // Delegate to the subclass.
@@ -181,6 +198,51 @@ Status IndexAccessMethod::insert(OperationContext* opCtx,
     return ret;
 }
 
+Status IndexAccessMethod::_insertKeyStrings(OperationContext* opCtx,
+                                            const BSONObj& obj,
+                                            const RecordId& loc,
+                                            const InsertDeleteOptions& options,
+                                            KeyString::Version version,
+                                            int64_t* numInserted) {
+    KeyStringSet keys;
+    MultikeyPaths multikeyPaths;
+    getKeyStrings(obj, options.getKeysMode, version, &keys, &multikeyPaths);
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        Status status = _newInterface->insertKeyString(opCtx, keys[i], loc, options.dupsAllowed);
+        if (status.isOK()) {
+            ++*numInserted;
+            continue;
+        }
+
+        if (status.code() == ErrorCodes::KeyTooLong && ignoreKeyTooLong(opCtx)) {
+            continue;
+        }
+
+        if (status.code() == ErrorCodes::DuplicateKeyValue && !_btreeState->isReady(opCtx)) {
+            LOG(3) << "key "
+                   << KeyString::toBson(keys[i].keyString.getBuffer(),
+                                        keys[i].keyString.getSize(),
+                                        _ordering,
+                                        keys[i].keyString.getTypeBits())
+                   << " already in index during background indexing (ok)";
+            continue;
+        }
+
+        for (size_t j = 0; j < i; ++j) {
+            removeOneKey(opCtx, keys[j], loc, options.dupsAllowed);
+        }
+        *numInserted = 0;
+        return status;
+    }
+
+    if (*numInserted > 1 || isMultikeyFromPaths(multikeyPaths)) {
+        _btreeState->setMultikey(opCtx, multikeyPaths);
+    }
+
+    return Status::OK();
+}
+
 void IndexAccessMethod::removeOneKey(OperationContext* opCtx,
                                      const BSONObj& key,
                                      const RecordId& loc,
@@ -197,6 +259,24 @@ void IndexAccessMethod::removeOneKey(OperationContext* opCtx,
     }
 }
 
+void IndexAccessMethod::removeOneKey(OperationContext* opCtx,
+                                     const KeyStringSet::Key& key,
+                                     const RecordId& loc,
+                                     bool dupsAllowed) {
+    try {
+        _newInterface->unindexKeyString(opCtx, key, loc, dupsAllowed);
+    } catch (AssertionException& e) {
+        log() << "Assertion failure: _unindex failed " << _descriptor->indexNamespace();
+        log() << "Assertion failure: _unindex failed: " << redact(e) << "  key:"
+              << KeyString::toBson(key.keyString.getBuffer(),
+                                   key.keyString.getSize(),
+                                   _ordering,
+                                   key.keyString.getTypeBits())
+              << "  dl:" << loc;
+        logContext();
+    }
+}
+
 std::unique_ptr<SortedDataInterface::Cursor> IndexAccessMethod::newCursor(OperationContext* opCtx,
                                                                           bool isForward) const {
     return _newInterface->newCursor(opCtx, isForward);
@@ -215,12 +295,24 @@ Status IndexAccessMethod::remove(OperationContext* opCtx,
                                  int64_t* numDeleted) {
     invariant(numDeleted);
     *numDeleted = 0;
-    BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
     // There's no need to compute the prefixes of the indexed fields that cause the index to be
     // multikey when removing a document since the index metadata isn't updated when keys are
     // deleted.
     MultikeyPaths* multikeyPaths = nullptr;
 
+    if (auto version = _newInterface->acceptedKeyStringVersion()) {
+        KeyStringSet keys;
+        getKeyStrings(
+            obj, GetKeysMode::kRelaxConstraintsUnfiltered, *version, &keys, multikeyPaths);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            removeOneKey(opCtx, keys[i], loc, options.dupsAllowed);
+            ++*numDeleted;
+        }
+        return Status::OK();
+    }
+
+    BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+
     // Relax key constraints on removal when deleting documents with invalid formats, but only
     // those that don't apply to the partialIndex filter.
     getKeys(obj, GetKeysMode::kRelaxConstraintsUnfiltered, &keys, multikeyPaths);
@@ -349,7 +441,20 @@ Status IndexAccessMethod::validateUpdate(OperationContext* opCtx,
                                          const InsertDeleteOptions& options,
                                          UpdateTicket* ticket,
                                          const MatchExpression* indexFilter) {
-    if (!indexFilter || indexFilter->matchesBSON(from)) {
+    const bool fromMatches = !indexFilter || indexFilter->matchesBSON(from);
+    const bool toMatches = !indexFilter || indexFilter->matchesBSON(to);
+
+    ticket->loc = record;
+    ticket->dupsAllowed = options.dupsAllowed;
+
+    // When both versions of the document generate the same keys there is nothing to add or
+    // remove, so leave the key sets empty rather than generating them twice.
+    if (fromMatches == toMatches && keysUnchanged(from, to)) {
+        ticket->_isValid = true;
+        return Status::OK();
+    }
+
+    if (fromMatches) {
         // There's no need to compute the prefixes of the indexed fields that possibly caused the
         // index to be multikey when the old version of the document was written since the index
         // metadata isn't updated when keys are deleted.
@@ -357,13 +462,10 @@ Status IndexAccessMethod::validateUpdate(OperationContext* opCtx,
         getKeys(from, options.getKeysMode, &ticket->oldKeys, multikeyPaths);
     }
 
-    if (!indexFilter || indexFilter->matchesBSON(to)) {
+    if (toMatches) {
         getKeys(to, options.getKeysMode, &ticket->newKeys, &ticket->newMultikeyPaths);
     }
 
-    ticket->loc = record;
-    ticket->dupsAllowed = options.dupsAllowed;
-
     std::tie(ticket->removed, ticket->added) = setDifference(ticket->oldKeys, ticket->newKeys);
 
     ticket->_isValid = true;
@@ -433,7 +535,8 @@ IndexAccessMethod::BulkBuilder::BulkBuilder(const IndexAccessMethod* index,
           SortOptions()
               .TempDir(storageGlobalParams.dbpath + "/_tmp")
               .ExtSortAllowed()
-              .MaxMemoryUsageBytes(maxMemoryUsageBytes),
+              .MaxMemoryUsageBytes(maxMemoryUsageBytes)
+              .SpillThreads(indexBuildSorterSpillThreads.load()),
           BtreeExternalSortComparison(descriptor->keyPattern(), descriptor->version()))),
       _real(index) {}
 
@@ -556,6 +659,50 @@ void IndexAccessMethod::getKeys(const BSONObj& obj,
                                 GetKeysMode mode,
                                 BSONObjSet* keys,
                                 MultikeyPaths* multikeyPaths) const {
+    try {
+        doGetKeys(obj, keys, multikeyPaths);
+    } catch (const AssertionException& ex) {
+        keys->clear();
+        if (multikeyPaths) {
+            multikeyPaths->clear();
+        }
+        _handleGetKeysError(ex, obj, mode);
+    }
+}
+
+void IndexAccessMethod::getKeyStrings(const BSONObj& obj,
+                                      GetKeysMode mode,
+                                      KeyString::Version version,
+                                      KeyStringSet* keys,
+                                      MultikeyPaths* multikeyPaths) const {
+    keys->clear();
+    try {
+        doGetKeyStrings(obj, version, _ordering, keys, multikeyPaths);
+    } catch (const AssertionException& ex) {
+        keys->clear();
+        if (multikeyPaths) {
+            multikeyPaths->clear();
+        }
+        _handleGetKeysError(ex, obj, mode);
+    }
+    keys->sortAndDedupe();
+}
+
+void IndexAccessMethod::doGetKeyStrings(const BSONObj& obj,
+                                        KeyString::Version version,
+                                        Ordering ordering,
+                                        KeyStringSet* keys,
+                                        MultikeyPaths* multikeyPaths) const {
+    BSONObjSet bsonKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    doGetKeys(obj, &bsonKeys, multikeyPaths);
+    for (const auto& key : bsonKeys) {
+        keys->add(version, key, ordering);
+    }
+}
+
+void IndexAccessMethod::_handleGetKeysError(const AssertionException& ex,
+                                            const BSONObj& obj,
+                                            GetKeysMode mode) const {
     static stdx::unordered_set<int> whiteList{ErrorCodes::CannotBuildIndexKeys,
                                               // Btree
                                               ErrorCodes::KeyTooLong,
@@ -580,34 +727,26 @@ void IndexAccessMethod::getKeys(const BSONObj& obj,
                                               13068,
                                               13026,
                                               13027};
-    try {
-        doGetKeys(obj, keys, multikeyPaths);
-    } catch (const AssertionException& ex) {
-        // Suppress all indexing errors when mode is kRelaxConstraints.
-        if (mode == GetKeysMode::kEnforceConstraints) {
-            throw;
-        }
 
-        keys->clear();
-        if (multikeyPaths) {
-            multikeyPaths->clear();
-        }
-        // Only suppress the errors in the whitelist.
-        if (whiteList.find(ex.code()) == whiteList.end()) {
-            throw;
-        }
+    // Suppress all indexing errors when mode is kRelaxConstraints.
+    if (mode == GetKeysMode::kEnforceConstraints) {
+        throw;
+    }
 
-        // If the document applies to the filter (which means that it should have never been
-        // indexed), do not supress the error.
-        const MatchExpression* filter = _btreeState->getFilterExpression();
-        if (mode == GetKeysMode::kRelaxConstraintsUnfiltered && filter &&
-            filter->matchesBSON(obj)) {
-            throw;
-        }
+    // Only suppress the errors in the whitelist.
+    if (whiteList.find(ex.code()) == whiteList.end()) {
+        throw;
+    }
 
-        LOG(1) << "Ignoring indexing error for idempotency reasons: " << redact(ex)
-               << " when getting index keys of " << redact(obj);
+    // If the document applies to the filter (which means that it should have never been
+    // indexed), do not supress the error.
+    const MatchExpression* filter = _btreeState->getFilterExpression();
+    if (mode == GetKeysMode::kRelaxConstraintsUnfiltered && filter && filter->matchesBSON(obj)) {
+        throw;
     }
+
+    LOG(1) << "Ignoring indexing error for idempotency reasons: " << redact(ex)
+           << " when getting index keys of " << redact(obj);
 }
 
 bool IndexAccessMethod::BulkBuilder::isMultikey() const {
@@ -295,6 +295,16 @@ public:
                  BSONObjSet* keys,
                  MultikeyPaths* multikeyPaths) const;
 
+    /**
+     * Like getKeys(), but replaces the contents of 'keys' with the keys encoded as KeyStrings of
+     * 'version' in the ordering of this index, sorted and without duplicates.
+     */
+    void getKeyStrings(const BSONObj& obj,
+                       GetKeysMode mode,
+                       KeyString::Version version,
+                       KeyStringSet* keys,
+                       MultikeyPaths* multikeyPaths) const;
+
     /**
      * Splits the sets 'left' and 'right' into two vectors, the first containing the elements that
      * only appeared in 'left', and the second containing only elements that appeared in 'right'.
@@ -320,6 +330,26 @@ protected:
                            BSONObjSet* keys,
                            MultikeyPaths* multikeyPaths) const = 0;
 
+    /**
+     * Fills 'keys' with the keys that should be generated for 'obj' on this index, encoded as
+     * KeyStrings of 'version' ordered by 'ordering'. The keys need not be sorted. The default
+     * encodes the keys generated by doGetKeys().
+     */
+    virtual void doGetKeyStrings(const BSONObj& obj,
+                                 KeyString::Version version,
+                                 Ordering ordering,
+                                 KeyStringSet* keys,
+                                 MultikeyPaths* multikeyPaths) const;
+
+    /**
+     * Returns true if this index is known to generate the same keys for 'from' and 'to', letting
+     * validateUpdate() skip key generation for both. Implementations must be conservative: the
+     * default of false always regenerates the keys.
+     */
+    virtual bool keysUnchanged(const BSONObj& from, const BSONObj& to) const {
+        return false;
+    }
+
     /**
      * Determines whether it's OK to ignore ErrorCodes::KeyTooLong for this OperationContext
      */
@@ -329,12 +359,33 @@ protected:
     const IndexDescriptor* _descriptor;
 
 private:
+    /**
+     * Rethrows the indexing error 'ex' being handled by the caller unless 'mode' allows ignoring
+     * it for 'obj'.
+     */
+    void _handleGetKeysError(const AssertionException& ex,
+                             const BSONObj& obj,
+                             GetKeysMode mode) const;
+
+    Status _insertKeyStrings(OperationContext* opCtx,
+                             const BSONObj& obj,
+                             const RecordId& loc,
+                             const InsertDeleteOptions& options,
+                             KeyString::Version version,
+                             int64_t* numInserted);
+
     void removeOneKey(OperationContext* opCtx,
                       const BSONObj& key,
                       const RecordId& loc,
                       bool dupsAllowed);
 
+    void removeOneKey(OperationContext* opCtx,
+                      const KeyStringSet::Key& key,
+                      const RecordId& loc,
+                      bool dupsAllowed);
+
     const std::unique_ptr<SortedDataInterface> _newInterface;
+    const Ordering _ordering;
 };
 
 /**
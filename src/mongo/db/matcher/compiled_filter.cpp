@@ -0,0 +1,203 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_filter.h"
+
+#include "mongo/db/field_ref.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/matchable.h"
+#include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/stdx/memory.h"
+
+namespace mongo {
+
+CompiledFilter::HashedEqualities::HashedEqualities(const CollatorInterface* collator)
+    : comparator(BSONElementComparator::FieldNamesMode::kIgnore, collator),
+      set(comparator.makeBSONEltUnorderedSet()) {}
+
+CompiledFilter::CompiledFilter(const MatchExpression* expr) : _expr(expr), _nodes(1) {}
+
+std::unique_ptr<CompiledFilter> CompiledFilter::compile(const MatchExpression* expr) {
+    if (!expr || !internalQueryEnableCompiledFilters.load()) {
+        return nullptr;
+    }
+
+    std::unique_ptr<CompiledFilter> filter(new CompiledFilter(expr));
+    if (!filter->addPredicate(expr, false) || filter->_predicates.empty()) {
+        return nullptr;
+    }
+    return filter;
+}
+
+bool CompiledFilter::addPredicate(const MatchExpression* expr, bool negated) {
+    switch (expr->matchType()) {
+        case MatchExpression::AND:
+            if (negated) {
+                return false;
+            }
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                if (!addPredicate(expr->getChild(i), false)) {
+                    return false;
+                }
+            }
+            return true;
+        case MatchExpression::NOT:
+            return addPredicate(expr->getChild(0), !negated);
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+        case MatchExpression::MATCH_IN:
+        case MatchExpression::EXISTS:
+        case MatchExpression::TYPE_OPERATOR:
+        case MatchExpression::REGEX:
+        case MatchExpression::MOD:
+            break;
+        default:
+            return false;
+    }
+
+    if (expr->path().empty()) {
+        return false;
+    }
+    const int node = addPath(expr->path());
+    if (node < 0) {
+        return false;
+    }
+
+    Predicate predicate{Op::kLeaf,
+                        negated,
+                        static_cast<uint8_t>(node),
+                        static_cast<const LeafMatchExpression*>(expr),
+                        nullptr,
+                        false,
+                        false};
+    if (expr->matchType() == MatchExpression::EXISTS) {
+        predicate.op = Op::kExists;
+    } else if (expr->matchType() == MatchExpression::MATCH_IN) {
+        auto in = static_cast<const InMatchExpression*>(expr);
+        if (in->getRegexes().empty()) {
+            auto hashed = stdx::make_unique<HashedEqualities>(in->getCollator());
+            for (auto&& equality : in->getEqualities()) {
+                hashed->set.insert(equality);
+            }
+            predicate.op = Op::kInHashed;
+            predicate.equalities = &hashed->set;
+            predicate.hasNull = in->hasNull();
+            _hashedEqualities.push_back(std::move(hashed));
+        }
+    }
+    _predicates.push_back(predicate);
+    return true;
+}
+
+int CompiledFilter::addPath(StringData path) {
+    FieldRef fieldRef(path);
+    size_t node = 0;
+    for (size_t i = 0; i < fieldRef.numParts(); ++i) {
+        const StringData part = fieldRef.getPart(i);
+        size_t next = 0;
+        for (auto child : _nodes[node].children) {
+            if (_nodes[child].fieldName == part) {
+                next = child;
+                break;
+            }
+        }
+        if (next == 0) {
+            if (_nodes.size() == kMaxPathNodes) {
+                return -1;
+            }
+            next = _nodes.size();
+            _nodes[node].children.push_back(static_cast<uint8_t>(next));
+            _nodes.push_back(PathNode{part.toString(), {}});
+        }
+        node = next;
+    }
+    return static_cast<int>(node);
+}
+
+bool CompiledFilter::resolve(const BSONObj& obj, uint8_t node, BSONElement* elements) const {
+    const auto& children = _nodes[node].children;
+    size_t remaining = children.size();
+    uint64_t found = 0;
+
+    for (auto&& elem : obj) {
+        const StringData fieldName = elem.fieldNameStringData();
+        for (size_t i = 0; i < children.size(); ++i) {
+            const uint8_t child = children[i];
+            if ((found & (1ULL << i)) || _nodes[child].fieldName != fieldName) {
+                continue;
+            }
+
+            // Like BSONElementIterator, only the first field with a given name is considered.
+            found |= 1ULL << i;
+            --remaining;
+            if (elem.type() == Array) {
+                return false;
+            }
+            elements[child] = elem;
+            if (elem.type() == Object && !_nodes[child].children.empty() &&
+                !resolve(elem.embeddedObject(), child, elements)) {
+                return false;
+            }
+            break;
+        }
+        if (remaining == 0) {
+            break;
+        }
+    }
+    return true;
+}
+
+bool CompiledFilter::evaluate(const Predicate& predicate, const BSONElement& elem) const {
+    switch (predicate.op) {
+        case Op::kExists:
+            return !elem.eoo();
+        case Op::kInHashed:
+            if (elem.eoo()) {
+                return predicate.hasNull;
+            }
+            return predicate.equalities->find(elem) != predicate.equalities->end();
+        case Op::kLeaf:
+            return predicate.expr->matchesSingleElement(elem);
+    }
+    MONGO_UNREACHABLE;
+}
+
+bool CompiledFilter::matches(const BSONObj& doc) const {
+    // Missing paths stay EOO, which is also what a BSONElementIterator yields for them.
+    BSONElement elements[kMaxPathNodes];
+    if (!resolve(doc, 0, elements)) {
+        ++_fallbackCount;
+        BSONMatchableDocument matchable(doc);
+        return _expr->matches(&matchable);
+    }
+
+    for (auto&& predicate : _predicates) {
+        if (evaluate(predicate, elements[predicate.node]) == predicate.negated) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace mongo
@@ -0,0 +1,136 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonelement_comparator.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo {
+
+class CollatorInterface;
+class LeafMatchExpression;
+
+/**
+ * A flat evaluation program for the common shapes of query filters: a conjunction of comparisons
+ * ($eq, $lt, $lte, $gt, $gte), $in, $exists, $type, $regex and $mod predicates, each possibly
+ * negated, on top-level or dotted paths.
+ *
+ * Evaluating the tree of PathMatchExpressions re-resolves every path from the root of the document
+ * through an ElementIterator. A CompiledFilter instead merges all referenced paths into a trie and
+ * resolves them with a single pass over the document, then tests each predicate against its
+ * resolved element. $in predicates without regexes probe a hash set built at compile time.
+ *
+ * Array semantics are left to the MatchExpression: as soon as an array is met on a referenced
+ * path, the document is matched against the original expression instead, so the result is always
+ * identical to 'expr->matches()'.
+ *
+ * The CompiledFilter keeps pointers into the expression it was compiled from, which must outlive
+ * it.
+ */
+class CompiledFilter {
+    CompiledFilter(const CompiledFilter&) = delete;
+    CompiledFilter& operator=(const CompiledFilter&) = delete;
+
+public:
+    // The number of path components a filter can reference before it is left uncompiled.
+    static constexpr size_t kMaxPathNodes = 64;
+
+    /**
+     * Compiles 'expr', or returns nullptr if it has a shape the program cannot evaluate or if
+     * compiled filters are disabled.
+     */
+    static std::unique_ptr<CompiledFilter> compile(const MatchExpression* expr);
+
+    /**
+     * Returns whether 'doc' satisfies the expression this filter was compiled from.
+     */
+    bool matches(const BSONObj& doc) const;
+
+    /**
+     * Returns the number of documents which had to be matched against the original expression.
+     */
+    long long fallbackCount() const {
+        return _fallbackCount;
+    }
+
+private:
+    enum class Op : uint8_t {
+        kExists,
+        kInHashed,
+        kLeaf,
+    };
+
+    struct Predicate {
+        Op op;
+        bool negated;
+        uint8_t node;
+        const LeafMatchExpression* expr;
+        // Only set for kInHashed.
+        const BSONEltUnorderedSet* equalities;
+        bool hasNull;
+        bool hasRegexes;
+    };
+
+    // The equalities of an $in, hashed with the semantics of its collator. The set refers to the
+    // comparator, so neither may move.
+    struct HashedEqualities {
+        explicit HashedEqualities(const CollatorInterface* collator);
+
+        const BSONElementComparator comparator;
+        BSONEltUnorderedSet set;
+    };
+
+    // A path component. The children of a node name the components which follow it in one or
+    // more referenced paths.
+    struct PathNode {
+        std::string fieldName;
+        std::vector<uint8_t> children;
+    };
+
+    explicit CompiledFilter(const MatchExpression* expr);
+
+    bool addPredicate(const MatchExpression* expr, bool negated);
+
+    // Returns the node for 'path', creating the missing nodes along it, or -1 if the node limit
+    // has been reached.
+    int addPath(StringData path);
+
+    // Stores into 'elements' the first element which matches each child of 'node' in 'obj', and
+    // descends into embedded objects. Returns false if an array was met on a referenced path.
+    bool resolve(const BSONObj& obj, uint8_t node, BSONElement* elements) const;
+
+    bool evaluate(const Predicate& predicate, const BSONElement& elem) const;
+
+    const MatchExpression* _expr;
+
+    // Node 0 is the root of the document.
+    std::vector<PathNode> _nodes;
+    std::vector<Predicate> _predicates;
+    std::vector<std::unique_ptr<HashedEqualities>> _hashedEqualities;
+
+    mutable long long _fallbackCount = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,134 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/matcher/compiled_filter.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<MatchExpression> parse(const BSONObj& filter,
+                                       const CollatorInterface* collator = nullptr) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto expr = uassertStatusOK(MatchExpressionParser::parse(filter, expCtx));
+    expr = MatchExpression::optimize(std::move(expr));
+    if (collator) {
+        expr->setCollator(collator);
+    }
+    return expr;
+}
+
+/**
+ * Asserts that 'filter' compiles and that the compiled program agrees with the MatchExpression
+ * on every document of 'docs'. Returns the number of documents which needed the fallback.
+ */
+long long assertMatchesLikeExpression(const BSONObj& filter,
+                                      const std::vector<BSONObj>& docs,
+                                      const CollatorInterface* collator = nullptr) {
+    auto expr = parse(filter, collator);
+    auto compiled = CompiledFilter::compile(expr.get());
+    ASSERT(compiled) << filter;
+    for (auto&& doc : docs) {
+        ASSERT_EQ(expr->matchesBSON(doc), compiled->matches(doc)) << filter << " on " << doc;
+    }
+    return compiled->fallbackCount();
+}
+
+TEST(CompiledFilterTest, ConjunctionOfComparisons) {
+    std::vector<BSONObj> docs{fromjson("{a: 1, b: 'x'}"),
+                              fromjson("{a: 5, b: 'x'}"),
+                              fromjson("{a: 5, b: 'y'}"),
+                              fromjson("{a: 5.5, b: 'x', c: null}"),
+                              fromjson("{b: 'x'}"),
+                              fromjson("{a: NaN, b: 'x'}"),
+                              fromjson("{a: '5', b: 'x'}"),
+                              fromjson("{}")};
+    ASSERT_EQ(0, assertMatchesLikeExpression(fromjson("{a: {$gt: 1, $lte: 5.5}, b: 'x'}"), docs));
+    ASSERT_EQ(0, assertMatchesLikeExpression(fromjson("{a: {$gte: 5}, c: null}"), docs));
+    ASSERT_EQ(0, assertMatchesLikeExpression(fromjson("{a: {$lt: 5}}"), docs));
+    ASSERT_EQ(0, assertMatchesLikeExpression(fromjson("{a: {$ne: 5}, b: {$ne: null}}"), docs));
+}
+
+TEST(CompiledFilterTest, DottedPaths) {
+    std::vector<BSONObj> docs{fromjson("{a: {b: 1, c: {d: 'x'}}}"),
+                              fromjson("{a: {b: 2, c: {d: 'x'}}}"),
+                              fromjson("{a: {c: {d: 'x'}}}"),
+                              fromjson("{a: {b: 1, c: 3}}"),
+                              fromjson("{a: 1}"),
+                              fromjson("{a: {b: 1}, 'a.b': 2}"),
+                              fromjson("{a: {b: 1}, a: {b: 2}}"),
+                              fromjson("{x: 1}")};
+    ASSERT_EQ(0, assertMatchesLikeExpression(fromjson("{'a.b': 1, 'a.c.d': 'x'}"), docs));
+    ASSERT_EQ(0, assertMatchesLikeExpression(fromjson("{'a.b': null, a: {$exists: true}}"), docs));
+    ASSERT_EQ(0, assertMatchesLikeExpression(fromjson("{'a.c.d': {$exists: false}}"), docs));
+    ASSERT_EQ(0, assertMatchesLikeExpression(fromjson("{'a.c': {$type: 'object'}}"), docs));
+}
+
+TEST(CompiledFilterTest, InUsesHashedEqualities) {
+    std::vector<BSONObj> docs{fromjson("{a: 1}"),
+                              fromjson("{a: 1.0}"),
+                              fromjson("{a: NumberLong(3)}"),
+                              fromjson("{a: NumberDecimal('3')}"),
+                              fromjson("{a: 4}"),
+                              fromjson("{a: 'foo'}"),
+                              fromjson("{a: {b: 1}}"),
+                              fromjson("{a: null}"),
+                              fromjson("{}")};
+    ASSERT_EQ(0, assertMatchesLikeExpression(fromjson("{a: {$in: [1, 3, 'foo', {b: 1}]}}"), docs));
+    ASSERT_EQ(0, assertMatchesLikeExpression(fromjson("{a: {$in: [4, null]}}"), docs));
+    ASSERT_EQ(0, assertMatchesLikeExpression(fromjson("{a: {$nin: [1, null]}}"), docs));
+    ASSERT_EQ(0, assertMatchesLikeExpression(fromjson("{a: {$in: [4, /^f/]}}"), docs));
+}
+
+TEST(CompiledFilterTest, InRespectsCollation) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    std::vector<BSONObj> docs{fromjson("{a: 'FOO'}"), fromjson("{a: 'bar'}"), fromjson("{a: 1}")};
+    ASSERT_EQ(0, assertMatchesLikeExpression(fromjson("{a: {$in: ['foo', 2]}}"), docs, &collator));
+    ASSERT_EQ(0, assertMatchesLikeExpression(fromjson("{a: {$gte: 'BAR'}}"), docs, &collator));
+}
+
+TEST(CompiledFilterTest, ArraysOnReferencedPathsFallBackToExpression) {
+    std::vector<BSONObj> docs{fromjson("{a: [1, 5], b: {c: 2}}"),
+                              fromjson("{a: 5, b: [{c: 2}, {c: 3}]}"),
+                              fromjson("{a: 5, b: {c: [3, 2]}}"),
+                              fromjson("{a: 5, b: {c: 2}, d: [1]}")};
+    ASSERT_EQ(3, assertMatchesLikeExpression(fromjson("{a: 5, 'b.c': {$in: [2]}}"), docs));
+    ASSERT_EQ(3, assertMatchesLikeExpression(fromjson("{a: {$ne: 1}, 'b.c': {$ne: 3}}"), docs));
+}
+
+TEST(CompiledFilterTest, UnsupportedShapesAreNotCompiled) {
+    for (auto&& filter : {fromjson("{$or: [{a: 1}, {b: 1}]}"),
+                          fromjson("{a: {$elemMatch: {$gt: 1}}}"),
+                          fromjson("{a: {$size: 2}}"),
+                          fromjson("{$nor: [{a: 1}, {b: 1}]}"),
+                          fromjson("{a: 1, b: {$bitsAllSet: 1}}"),
+                          fromjson("{}")}) {
+        auto expr = parse(filter);
+        ASSERT_FALSE(CompiledFilter::compile(expr.get())) << filter;
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -107,6 +107,13 @@ public:
         return *_query;
     }
 
+    /**
+     * Returns the geo specification this expression was parsed from.
+     */
+    const BSONObj& getRawObj() const {
+        return _rawObj;
+    }
+
 private:
     ExpressionOptimizerFunc getOptimizer() const final {
         return [](std::unique_ptr<MatchExpression> expression) { return expression; };
@@ -32,15 +32,19 @@ MongoKey::MongoKey(const mongo::RecordId& rid) {
         assert(false);
         int64_t native = rid.getLong();
         int64_t be = mongo::endian::nativeToBig(native);
-        packed_key_ = std::string{reinterpret_cast<const char*>(&be), sizeof(be)};
+        auto bePtr = reinterpret_cast<const char*>(&be);
+        packed_key_.assign(bePtr, bePtr + sizeof(be));
     } else {
-        packed_key_ = std::string{rid.getStringView()};
+        std::string_view sv = rid.getStringView();
+        packed_key_.assign(sv.begin(), sv.end());
     }
+    UpdatePrefix();
 }
 
 MongoKey::MongoKey(const mongo::KeyString& ks) {
     MONGO_LOG(1) << "MongoKey construction. KeyString: " << ks.toString();
-    packed_key_ = std::string{ks.getBuffer(), ks.getSize()};
+    packed_key_.assign(ks.getBuffer(), ks.getBuffer() + ks.getSize());
+    UpdatePrefix();
 }
 
 mongo::RecordId MongoKey::ToRecordId(bool is_long) const {
@@ -80,8 +84,8 @@ std::string MongoKey::ToString() const {
 void MongoKey::SetPackedKey(const mongo::RecordId& rid) {
     invariant(!rid.isLong());
     std::string_view sv = rid.getStringView();
-    packed_key_.resize(sv.size());
-    std::copy(sv.begin(), sv.end(), packed_key_.begin());
+    packed_key_.assign(sv.begin(), sv.end());
+    UpdatePrefix();
 }
 
 };  // namespace Eloq
@@ -27,6 +27,8 @@
 #include <string_view>
 #include <utility>
 
+#include "absl/container/inlined_vector.h"
+
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/key_string.h"
 
@@ -35,27 +37,42 @@
 namespace Eloq {
 /**
  * MongoKey stores the mem-comparable which equals to KeyString in Mongo.
+ *
+ * The keyStringPrefix() of the packed key is kept next to it so that most comparisons in the cc
+ * maps are decided by one integer compare. Every mutation of packed_key_ must call UpdatePrefix().
+ *
+ * Packed keys of up to kInlineKeyBytes bytes are stored inside the MongoKey itself. That covers the
+ * ObjectId _id keys of the primary index and most secondary index entries, so the common keys cost
+ * no heap allocation of their own when they are built on the write path or copied into the cc maps.
  */
 class MongoKey {
 public:
+    static constexpr size_t kInlineKeyBytes = 32;
+
     void Reset() {
         packed_key_.clear();
+        prefix_ = 0;
     }
 
     explicit MongoKey() = default;
 
-    explicit MongoKey(const char* buf, size_t len) : packed_key_{buf, len} {}
+    explicit MongoKey(const char* buf, size_t len)
+        : packed_key_(buf, buf + len), prefix_{mongo::keyStringPrefix(buf, len)} {}
     explicit MongoKey(std::string_view packed_key)
-        : packed_key_{packed_key.data(), packed_key.size()} {}
+        : MongoKey(packed_key.data(), packed_key.size()) {}
     explicit MongoKey(const std::string& packed_key)
-        : packed_key_{packed_key.data(), packed_key.size()} {}
-    explicit MongoKey(std::string&& packed_key) : packed_key_{std::move(packed_key)} {}
+        : MongoKey(packed_key.data(), packed_key.size()) {}
+    explicit MongoKey(std::string&& packed_key)
+        : MongoKey(packed_key.data(), packed_key.size()) {}
 
     // https://stackoverflow.com/questions/76858243/why-is-stdcopy-faster-than-stdstring-constructor
     // https://quick-bench.com/q/2IPRbwhFkUKaRHMC_Ym4JPrBeuw
     // Using std::string constructor directly is better than using std::copy?
-    MongoKey(const MongoKey& other) : packed_key_{other.packed_key_} {}
-    MongoKey(MongoKey&& other) noexcept : packed_key_{std::move(other.packed_key_)} {}
+    MongoKey(const MongoKey& other) : packed_key_{other.packed_key_}, prefix_{other.prefix_} {}
+    MongoKey(MongoKey&& other) noexcept
+        : packed_key_{std::move(other.packed_key_)}, prefix_{other.prefix_} {
+        other.Reset();
+    }
 
     explicit MongoKey(const mongo::RecordId& rid);
     explicit MongoKey(const mongo::KeyString& ks);
@@ -77,12 +94,14 @@ public:
 
         MongoKey pos_inf_key;
         pos_inf_key.packed_key_.resize(max_length, 0xFF);
+        pos_inf_key.UpdatePrefix();
         return pos_inf_key;
     }
 
     MongoKey& operator=(const MongoKey& rhs) noexcept {
         if (this != &rhs) {
             packed_key_ = rhs.packed_key_;
+            prefix_ = rhs.prefix_;
         }
         return *this;
     }
@@ -90,6 +109,8 @@ public:
     MongoKey& operator=(MongoKey&& rhs) noexcept {
         if (this != &rhs) {
             packed_key_ = std::move(rhs.packed_key_);
+            prefix_ = rhs.prefix_;
+            rhs.Reset();
         }
         return *this;
     }
@@ -102,7 +123,7 @@ public:
             return &lhs == &rhs;
         }
 
-        return lhs.packed_key_ == rhs.packed_key_;
+        return lhs.prefix_ == rhs.prefix_ && lhs.packed_key_ == rhs.packed_key_;
     }
 
     friend bool operator!=(const MongoKey& lhs, const MongoKey& rhs) {
@@ -121,7 +142,7 @@ public:
             return &lhs != pos_ptr;
         }
 
-        return lhs.packed_key_ < rhs.packed_key_;
+        return lhs.Compare(rhs) < 0;
     }
 
     friend bool operator<=(const MongoKey& lhs, const MongoKey& rhs) {
@@ -160,10 +181,9 @@ public:
         uint16_t len = *reinterpret_cast<const uint16_t*>(buf + offset);
         offset += sizeof(uint16_t);
 
-        packed_key_.resize(len);
-        // auto uBuf = reinterpret_cast<const char*>(buf);
-        std::copy(buf + offset, buf + offset + len, packed_key_.begin());
+        packed_key_.assign(buf + offset, buf + offset + len);
         offset += len;
+        UpdatePrefix();
     }
 
     txservice::TxKey CloneTxKey() const {
@@ -191,7 +211,8 @@ public:
     }
 
     bool NeedsDefrag(mi_heap_t* heap) {
-        if (packed_key_.data() != nullptr) {
+        // Inline keys live in the MongoKey, which is defragmented along with its owner.
+        if (IsHeapAllocated()) {
             float page_utilization = mi_heap_page_utilization(heap, packed_key_.data());
             if (page_utilization < 0.8) {
                 return true;
@@ -206,9 +227,8 @@ public:
     void SetPackedKey(const mongo::RecordId& rid);
 
     void SetPackedKey(const char* data, size_t len) {
-        // packed_key_ = std::string{data, len};
-        packed_key_.resize(len);
-        std::copy(data, data + len, packed_key_.begin());
+        packed_key_.assign(data, data + len);
+        UpdatePrefix();
     }
 
     std::string_view PackedKeyStringView() const {
@@ -228,13 +248,8 @@ public:
     }
 
     size_t MemUsage() const {
-        // Most C++ implementations provide SSO, Small String Optimization. Based
-        // on libstdc++, basic_string<char> has a local capacity of 15, plus one
-        // more byte to store '\0', i.e. strings shorter than 16 are stored
-        // directly in the String object, only strings longer than 16 have an
-        // allocated buffer to store the contents.
         size_t mem_usage = sizeof(MongoKey);
-        if (packed_key_.capacity() >= 16) {
+        if (IsHeapAllocated()) {
             mem_usage += packed_key_.capacity();
         }
         return mem_usage;
@@ -297,6 +312,25 @@ public:
     }
 
 private:
-    std::string packed_key_;
+    // Three-way comparison of the packed keys of two normal keys.
+    int Compare(const MongoKey& rhs) const {
+        return mongo::compareKeyStrings(packed_key_.data(),
+                                        packed_key_.size(),
+                                        prefix_,
+                                        rhs.packed_key_.data(),
+                                        rhs.packed_key_.size(),
+                                        rhs.prefix_);
+    }
+
+    bool IsHeapAllocated() const {
+        return packed_key_.capacity() > kInlineKeyBytes;
+    }
+
+    void UpdatePrefix() {
+        prefix_ = mongo::keyStringPrefix(packed_key_.data(), packed_key_.size());
+    }
+
+    absl::InlinedVector<char, kInlineKeyBytes> packed_key_;
+    uint64_t prefix_{0};
 };
 }  // namespace Eloq
@@ -40,10 +40,10 @@ public:
         unpack_info_.clear();
     }
 
-    MongoRecord() {
-        encoded_blob_.reserve(32);
-        unpack_info_.reserve(8);
-    }
+    // Buffers are sized by the first SetEncodedBlob()/SetUnpackInfo() or Deserialize() rather
+    // than reserved up front: most records outgrow a small reservation, and most have no unpack
+    // info at all.
+    MongoRecord() = default;
 
     MongoRecord(const MongoRecord& rhs)
         : encoded_blob_{rhs.encoded_blob_}, unpack_info_{rhs.unpack_info_} {}
@@ -139,7 +139,7 @@ public:
     }
 
     void Copy(const TxRecord& rhs) override {
-        auto typed_rhs = static_cast<const MongoRecord&>(rhs);
+        const auto& typed_rhs = static_cast<const MongoRecord&>(rhs);
 
         encoded_blob_ = typed_rhs.encoded_blob_;
         unpack_info_ = typed_rhs.unpack_info_;
@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <cstddef>
+#include <deque>
+
+#include "mongo/db/modules/eloq/src/base/eloq_key.h"
+#include "mongo/db/modules/eloq/src/base/eloq_record.h"
+
+namespace mongo {
+
+/**
+ * Keys and records that a storage operation needs only for its own duration, such as the buffer
+ * that the current version of a document is read into before the document is deleted.
+ *
+ * Objects are recycled instead of freed and keep their buffers, so a recovery unit stops allocating
+ * for them after its first few operations. Objects handed out while a Scope is alive are returned
+ * when it ends; the remaining ones are all returned at once by release(), which
+ * EloqRecoveryUnit::reset() calls. Keys and records passed to setKV() are owned by txservice and
+ * must not come from here.
+ */
+class EloqScratchArena {
+public:
+    class Scope {
+    public:
+        explicit Scope(EloqScratchArena& arena)
+            : _arena(arena), _keysInUse(arena._keys.inUse), _recordsInUse(arena._records.inUse) {}
+
+        ~Scope() {
+            _arena._keys.inUse = _keysInUse;
+            _arena._records.inUse = _recordsInUse;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        EloqScratchArena& _arena;
+        const size_t _keysInUse;
+        const size_t _recordsInUse;
+    };
+
+    Eloq::MongoKey* allocateKey() {
+        return _keys.next();
+    }
+
+    Eloq::MongoRecord* allocateRecord() {
+        return _records.next();
+    }
+
+    void release() {
+        _keys.release();
+        _records.release();
+    }
+
+private:
+    // Objects beyond this many are freed by release() rather than kept for reuse.
+    static constexpr size_t kMaxRetainedObjects = 16;
+
+    template <typename T>
+    struct Pool {
+        T* next() {
+            if (inUse == objects.size()) {
+                objects.emplace_back();
+            }
+            T* object = &objects[inUse++];
+            object->Reset();
+            return object;
+        }
+
+        void release() {
+            inUse = 0;
+            if (objects.size() > kMaxRetainedObjects) {
+                objects.resize(kMaxRetainedObjects);
+            }
+        }
+
+        // A deque, so that the objects handed out do not move when the pool grows.
+        std::deque<T> objects;
+        size_t inUse{0};
+    };
+
+    Pool<Eloq::MongoKey> _keys;
+    Pool<Eloq::MongoRecord> _records;
+};
+
+}  // namespace mongo
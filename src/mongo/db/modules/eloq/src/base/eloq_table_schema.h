@@ -176,6 +176,27 @@ public:
             obj, mongo::IndexAccessMethod::GetKeysMode::kEnforceConstraints, keys, multikeyPaths);
     }
 
+    /**
+     * Like GetKeys(), with the keys encoded as KeyStrings without a RecordId, replacing the
+     * contents of 'keys'.
+     */
+    void GetKeyStrings(const mongo::BSONObj& obj,
+                       mongo::KeyStringSet* keys,
+                       mongo::MultikeyPaths* multikeyPaths) const {
+        keys->clear();
+        auto filter_expr = entry_->getFilterExpression();
+        if (filter_expr && !filter_expr->matchesBSON(obj)) {
+            return;
+        }
+
+        entry_->accessMethod()->getKeyStrings(
+            obj,
+            mongo::IndexAccessMethod::GetKeysMode::kEnforceConstraints,
+            mongo::KeyString::kLatestVersion,
+            keys,
+            multikeyPaths);
+    }
+
     const mongo::IndexDescriptor* IndexDescriptor() const {
         return entry_->descriptor();
     }
@@ -189,14 +189,17 @@ inline BSONObj getIdBSONObjWithoutFieldName(const BSONObj& obj) {
 }
 
 inline constexpr int MaxKeySize = 1024;
-inline Status checkKeySize(const BSONObj& key, std::string_view indexName) {
-    if (key.objsize() >= MaxKeySize) {
+inline Status checkKeySize(int keySize, std::string_view indexName) {
+    if (keySize >= MaxKeySize) {
         std::stringstream ss;
-        ss << "Insert " << indexName
-           << " fail: key too large to index, key size: " << key.objsize();
+        ss << "Insert " << indexName << " fail: key too large to index, key size: " << keySize;
         return {ErrorCodes::KeyTooLong, ss.str()};
     }
     return Status::OK();
 }
 
+inline Status checkKeySize(const BSONObj& key, std::string_view indexName) {
+    return checkKeySize(key.objsize(), indexName);
+}
+
 }  // namespace mongo
@@ -0,0 +1,120 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/oid.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/key_string.h"
+
+#include "mongo/db/modules/eloq/src/base/eloq_key.h"
+#include "mongo/db/modules/eloq/src/base/eloq_record.h"
+#include "mongo/db/modules/eloq/src/base/eloq_scratch_arena.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Returns the RecordId of a document with an ObjectId _id, the key of the primary index.
+ */
+RecordId makeRecordId() {
+    KeyString ks(KeyString::Version::V1, BSON("" << OID::gen()), Ordering::make(BSONObj()));
+    return RecordId(ks.getBuffer(), ks.getSize());
+}
+
+std::string makeDocumentBlob(size_t size) {
+    BSONObjBuilder bob;
+    bob.append("_id", OID::gen());
+    bob.append("payload", std::string(size, 'x'));
+    const BSONObj obj = bob.obj();
+    return std::string(obj.objdata(), obj.objsize());
+}
+
+// The key and record insertRecords() hands to setKV() for each document.
+void BM_insertKeyAndRecord(benchmark::State& state) {
+    const RecordId id = makeRecordId();
+    const std::string blob = makeDocumentBlob(state.range(0));
+    for (auto _ : state) {
+        auto mongoKey = std::make_unique<Eloq::MongoKey>(id);
+        auto mongoRecord = std::make_unique<Eloq::MongoRecord>();
+        mongoRecord->SetEncodedBlob(reinterpret_cast<const unsigned char*>(blob.data()),
+                                    blob.size());
+        benchmark::DoNotOptimize(mongoKey);
+        benchmark::DoNotOptimize(mongoRecord);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// An index entry key of 'state.range(0)' bytes, built and then copied into the cc map. Keys of
+// up to MongoKey::kInlineKeyBytes bytes are stored inline.
+void BM_indexKeyAndCopy(benchmark::State& state) {
+    std::string packed(state.range(0), 'k');
+    size_t i = 0;
+    for (auto _ : state) {
+        packed.back() = static_cast<char>(i++);
+        auto mongoKey = std::make_unique<Eloq::MongoKey>(packed.data(), packed.size());
+        Eloq::MongoKey copy(*mongoKey);
+        benchmark::DoNotOptimize(copy.Data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// The key and record of a point lookup such as findRecord(), allocated for every operation.
+void BM_lookupKeyAndRecordOnHeap(benchmark::State& state) {
+    const RecordId id = makeRecordId();
+    const std::string blob = makeDocumentBlob(state.range(0));
+    for (auto _ : state) {
+        auto mongoKey = std::make_unique<Eloq::MongoKey>();
+        mongoKey->SetPackedKey(id);
+        auto mongoRecord = std::make_unique<Eloq::MongoRecord>();
+        mongoRecord->SetEncodedBlob(reinterpret_cast<const unsigned char*>(blob.data()),
+                                    blob.size());
+        benchmark::DoNotOptimize(mongoRecord->EncodedBlobData());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// The same lookup with the key and record taken from an EloqScratchArena.
+void BM_lookupKeyAndRecordFromArena(benchmark::State& state) {
+    const RecordId id = makeRecordId();
+    const std::string blob = makeDocumentBlob(state.range(0));
+    EloqScratchArena arena;
+    for (auto _ : state) {
+        EloqScratchArena::Scope scope(arena);
+        Eloq::MongoKey* mongoKey = arena.allocateKey();
+        mongoKey->SetPackedKey(id);
+        Eloq::MongoRecord* mongoRecord = arena.allocateRecord();
+        mongoRecord->SetEncodedBlob(reinterpret_cast<const unsigned char*>(blob.data()),
+                                    blob.size());
+        benchmark::DoNotOptimize(mongoRecord->EncodedBlobData());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_insertKeyAndRecord)->Arg(64)->Arg(512)->Arg(4096);
+BENCHMARK(BM_indexKeyAndCopy)->Arg(14)->Arg(24)->Arg(30)->Arg(48);
+BENCHMARK(BM_lookupKeyAndRecordOnHeap)->Arg(64)->Arg(512)->Arg(4096);
+BENCHMARK(BM_lookupKeyAndRecordFromArena)->Arg(64)->Arg(512)->Arg(4096);
+
+}  // namespace
+}  // namespace mongo
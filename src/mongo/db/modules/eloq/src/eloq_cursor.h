@@ -47,6 +47,11 @@ public:
     txservice::TxErrorCode nextBatchTuple();
     const txservice::ScanBatchTuple* currentBatchTuple() const;
 
+    // True once every tuple fetched so far has been returned by nextBatchTuple().
+    bool fetchedBatchExhausted() const {
+        return _scanBatchIdx >= _scanBatchVector.size();
+    }
+
 
     uint32_t PrefetchSize() {
         std::array<uint32_t, 5> boundaries = {1, 4, 16, 64, 256};
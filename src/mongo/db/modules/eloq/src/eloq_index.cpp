@@ -122,6 +122,7 @@ public:
             _forward == inclusive ? KeyString::kExclusiveAfter : KeyString::kExclusiveBefore;
         _endPosition.emplace(_idx->keyStringVersion());
         _endPosition->resetToKey(stripFieldNames(key), _idx->ordering(), discriminator);
+        _endPositionPrefix = keyStringPrefix(_endPosition->getBuffer(), _endPosition->getSize());
         MONGO_LOG(1) << "endPosition: " << _endPosition->toString();
     }
 
@@ -382,7 +383,12 @@ private:
             return false;
         }
 
-        const int cmp = _key.compare(*_endPosition);
+        const int cmp = compareKeyStrings(_key.getBuffer(),
+                                          _key.getSize(),
+                                          keyStringPrefix(_key.getBuffer(), _key.getSize()),
+                                          _endPosition->getBuffer(),
+                                          _endPosition->getSize(),
+                                          _endPositionPrefix);
 
         // We set up _endPosition to be in between the last in-range value and the first
         // out-of-range value. In particular, it is constructed to never equal any legal index
@@ -415,6 +421,8 @@ private:
     RecordId _id;
     bool _eof{true};
     boost::optional<KeyString> _endPosition;
+    // keyStringPrefix() of _endPosition, which every step of a bounded scan compares against.
+    uint64_t _endPositionPrefix{0};
 
     const Eloq::MongoKey* _scanTupleKey{nullptr};
     const Eloq::MongoRecord* _scanTupleRecord{nullptr};
@@ -643,12 +651,30 @@ Status EloqUniqueIndex::insert(OperationContext* opCtx,
         return s;
     }
 
-    auto ru = EloqRecoveryUnit::get(opCtx);
-
     // key as MongoKey
     KeyString keyString{keyStringVersion(), key, _ordering};
-    auto valueItem = id.getStringView();
+    return _insert(opCtx, keyString, id);
+}
+
+Status EloqUniqueIndex::insertKeyString(OperationContext* opCtx,
+                                        const KeyStringSet::Key& key,
+                                        const RecordId& id,
+                                        bool dupsAllowed) {
+    MONGO_LOG(1) << "EloqUniqueIndex::insertKeyString";
+    assert(!dupsAllowed);
+    Status s = checkKeySize(key.bsonSize, _indexName.StringView());
+    if (!s.isOK()) {
+        return s;
+    }
+    return _insert(opCtx, key.keyString, id);
+}
+
+Status EloqUniqueIndex::_insert(OperationContext* opCtx,
+                                const KeyString& keyString,
+                                const RecordId& id) {
+    auto ru = EloqRecoveryUnit::get(opCtx);
 
+    auto valueItem = id.getStringView();
     auto mongoKey = std::make_unique<Eloq::MongoKey>(keyString.getBuffer(), keyString.getSize());
     auto mongoRecord = std::make_unique<Eloq::MongoRecord>();
     uint64_t keySchemaVersion = ru->getIndexSchema(_tableName, _indexName)->SchemaTs();
@@ -684,26 +710,42 @@ void EloqUniqueIndex::unindex(OperationContext* opCtx,
     MONGO_LOG(1) << "EloqUniqueIndex::unindex";
     assert(!dupsAllowed);
 
+    // key as MongoKey. Unlike WiredTiger, whose unique key encodes(key, id), Eloq puts id in
+    // MongoRecord.
+    KeyString keyString{keyStringVersion(), key, _ordering};
+    _unindex(opCtx, keyString, id);
+}
+
+void EloqUniqueIndex::unindexKeyString(OperationContext* opCtx,
+                                       const KeyStringSet::Key& key,
+                                       const RecordId& id,
+                                       bool dupsAllowed) {
+    MONGO_LOG(1) << "EloqUniqueIndex::unindexKeyString";
+    assert(!dupsAllowed);
+    _unindex(opCtx, key.keyString, id);
+}
+
+void EloqUniqueIndex::_unindex(OperationContext* opCtx,
+                               const KeyString& keyString,
+                               const RecordId& id) {
     auto ru = EloqRecoveryUnit::get(opCtx);
 
     const Eloq::MongoKeySchema* keySchema = ru->getIndexSchema(_tableName, _indexName);
     uint64_t keySchemaVersion = keySchema->SchemaTs();
 
-    // key as MongoKey. Unlike WiredTiger, whose unique key encodes(key, id), Eloq puts id in
-    // MongoRecord.
-    KeyString keyString{keyStringVersion(), key, _ordering};
     auto mongoKey = std::make_unique<Eloq::MongoKey>(keyString.getBuffer(), keyString.getSize());
 
     if (keySchema->IndexDescriptor()->isPartial()) {
-        Eloq::MongoRecord mongoRecord;
+        EloqScratchArena::Scope scratchScope(ru->scratchArena());
+        Eloq::MongoRecord* mongoRecord = ru->scratchArena().allocateRecord();
         auto [exists, err] =
-            ru->getKV(opCtx, _indexName, keySchemaVersion, mongoKey.get(), &mongoRecord, true);
+            ru->getKV(opCtx, _indexName, keySchemaVersion, mongoKey.get(), mongoRecord, true);
         if (err != txservice::TxErrorCode::NO_ERROR) {
             uassertStatusOK(TxErrorCodeToMongoStatus(err));
         }
         if (exists) {
-            std::string_view encodedBlob(mongoRecord.EncodedBlobData(),
-                                         mongoRecord.EncodedBlobSize());
+            std::string_view encodedBlob(mongoRecord->EncodedBlobData(),
+                                         mongoRecord->EncodedBlobSize());
             if (encodedBlob != id.getStringView()) {
                 return;
             }
@@ -755,13 +797,35 @@ Status EloqStandardIndex::insert(OperationContext* opCtx,
         return s;
     }
 
-    auto ru = EloqRecoveryUnit::get(opCtx);
-
     KeyString keyString{keyStringVersion(), key, _ordering, id};
+    return _insert(opCtx, keyString, keyString.getTypeBits());
+}
+
+Status EloqStandardIndex::insertKeyString(OperationContext* opCtx,
+                                          const KeyStringSet::Key& key,
+                                          const RecordId& id,
+                                          bool dupsAllowed) {
+    MONGO_LOG(1) << "EloqStandardIndex::insertKeyString. RecordId: " << id;
+    assert(dupsAllowed);
+    Status s = checkKeySize(key.bsonSize, _indexName.StringView());
+    if (!s.isOK()) {
+        return s;
+    }
+
+    KeyString keyString{keyStringVersion()};
+    keyString.resetFromBuffer(key.keyString.getBuffer(), key.keyString.getSize());
+    keyString.appendRecordId(id);
+    return _insert(opCtx, keyString, key.keyString.getTypeBits());
+}
+
+Status EloqStandardIndex::_insert(OperationContext* opCtx,
+                                  const KeyString& keyString,
+                                  const KeyString::TypeBits& typeBits) {
+    auto ru = EloqRecoveryUnit::get(opCtx);
 
     auto mongoKey = std::make_unique<Eloq::MongoKey>(keyString.getBuffer(), keyString.getSize());
     auto mongoRecord = std::make_unique<Eloq::MongoRecord>();
-    if (const auto& typeBits = keyString.getTypeBits(); !typeBits.isAllZeros()) {
+    if (!typeBits.isAllZeros()) {
         mongoRecord->SetUnpackInfo(typeBits.getBuffer(), typeBits.getSize());
     }
     uint64_t keySchemaVersion = ru->getIndexSchema(_tableName, _indexName)->SchemaTs();
@@ -781,9 +845,24 @@ void EloqStandardIndex::unindex(OperationContext* opCtx,
                                 bool dupsAllowed) {
     MONGO_LOG(1) << "EloqStandardIndex::_unindex";
 
-    auto ru = EloqRecoveryUnit::get(opCtx);
-
     KeyString keyString{keyStringVersion(), key, _ordering, id};
+    _unindex(opCtx, keyString);
+}
+
+void EloqStandardIndex::unindexKeyString(OperationContext* opCtx,
+                                         const KeyStringSet::Key& key,
+                                         const RecordId& id,
+                                         bool dupsAllowed) {
+    MONGO_LOG(1) << "EloqStandardIndex::unindexKeyString";
+
+    KeyString keyString{keyStringVersion()};
+    keyString.resetFromBuffer(key.keyString.getBuffer(), key.keyString.getSize());
+    keyString.appendRecordId(id);
+    _unindex(opCtx, keyString);
+}
+
+void EloqStandardIndex::_unindex(OperationContext* opCtx, const KeyString& keyString) {
+    auto ru = EloqRecoveryUnit::get(opCtx);
 
     auto mongoKey = std::make_unique<Eloq::MongoKey>(keyString.getBuffer(), keyString.getSize());
     uint64_t keySchemaVersion = ru->getIndexSchema(_tableName, _indexName)->SchemaTs();
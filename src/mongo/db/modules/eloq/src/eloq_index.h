@@ -153,6 +153,25 @@ public:
                  const BSONObj& key,
                  const RecordId& id,
                  bool dupsAllowed) override;
+
+    boost::optional<KeyString::Version> acceptedKeyStringVersion() const override {
+        return keyStringVersion();
+    }
+
+    Status insertKeyString(OperationContext* opCtx,
+                           const KeyStringSet::Key& key,
+                           const RecordId& id,
+                           bool dupsAllowed) override;
+
+    void unindexKeyString(OperationContext* opCtx,
+                          const KeyStringSet::Key& key,
+                          const RecordId& id,
+                          bool dupsAllowed) override;
+
+private:
+    // Both take the key without a RecordId, which unique indexes store as the value instead.
+    Status _insert(OperationContext* opCtx, const KeyString& keyString, const RecordId& id);
+    void _unindex(OperationContext* opCtx, const KeyString& keyString, const RecordId& id);
 };
 
 class EloqStandardIndex final : public EloqIndex {
@@ -181,6 +200,27 @@ public:
                  const BSONObj& key,
                  const RecordId& id,
                  bool dupsAllowed) override;
+
+    boost::optional<KeyString::Version> acceptedKeyStringVersion() const override {
+        return keyStringVersion();
+    }
+
+    Status insertKeyString(OperationContext* opCtx,
+                           const KeyStringSet::Key& key,
+                           const RecordId& id,
+                           bool dupsAllowed) override;
+
+    void unindexKeyString(OperationContext* opCtx,
+                          const KeyStringSet::Key& key,
+                          const RecordId& id,
+                          bool dupsAllowed) override;
+
+private:
+    // Both take the key followed by the RecordId.
+    Status _insert(OperationContext* opCtx,
+                   const KeyString& keyString,
+                   const KeyString::TypeBits& typeBits);
+    void _unindex(OperationContext* opCtx, const KeyString& keyString);
 };
 
 }  // namespace mongo
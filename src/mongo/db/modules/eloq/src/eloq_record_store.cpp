@@ -29,13 +29,13 @@
 #include "mongo/base/error_codes.h"
 #include "mongo/base/status.h"
 #include "mongo/bson/bsonobj.h"
-#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/index/multikey_paths.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/kv/kv_catalog_feature_tracker.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
 
 #include "mongo/db/modules/eloq/src/base/eloq_key.h"
 #include "mongo/db/modules/eloq/src/base/eloq_record.h"
@@ -65,6 +65,29 @@ thread_local std::random_device r;
 thread_local std::default_random_engine randomEngine{r()};
 thread_local std::uniform_int_distribution<int> uniformDist{1, 500};
 
+namespace {
+
+/**
+ * Returns the key under which a standard index stores 'key' of the document 'id'.
+ */
+std::unique_ptr<Eloq::MongoKey> makeIndexEntryKey(const KeyStringSet::Key& key,
+                                                  const RecordId& id) {
+    KeyString keyString{key.keyString.version};
+    keyString.resetFromBuffer(key.keyString.getBuffer(), key.keyString.getSize());
+    keyString.appendRecordId(id);
+    return std::make_unique<Eloq::MongoKey>(keyString.getBuffer(), keyString.getSize());
+}
+
+std::unique_ptr<Eloq::MongoRecord> makeIndexEntryRecord(const KeyStringSet::Key& key) {
+    auto mongoRecord = std::make_unique<Eloq::MongoRecord>();
+    if (const auto& typeBits = key.keyString.getTypeBits(); !typeBits.isAllZeros()) {
+        mongoRecord->SetUnpackInfo(typeBits.getBuffer(), typeBits.getSize());
+    }
+    return mongoRecord;
+}
+
+}  // namespace
+
 class EloqCatalogRecordStoreCursor : public SeekableRecordCursor {
 public:
     explicit EloqCatalogRecordStoreCursor(OperationContext* opCtx)
@@ -415,7 +438,8 @@ public:
           _ru{EloqRecoveryUnit::get(opCtx)},
           _tableName{rs->tableName()},
           _keySchema(_ru->getIndexSchema(*rs->tableName())),
-          _forward{forward} {
+          _forward{forward},
+          _sharedScan{rs->sharedScan()} {
         MONGO_LOG(1) << "EloqRecordStoreCursor::EloqRecordStoreCursor";
     }
 
@@ -426,15 +450,19 @@ public:
 
     ~EloqRecordStoreCursor() override {
         MONGO_LOG(1) << "EloqRecordStoreCursor::~EloqRecordStoreCursor";
+        _leaveSharedScan();
     }
 
     void reset(OperationContext* opCtx, const EloqRecordStore* rs, bool forward) {
+        _resetSharedScan();
         _opCtx = opCtx;
         _ru = EloqRecoveryUnit::get(opCtx);
         _tableName = rs->tableName();
         _keySchema = _ru->getIndexSchema(*rs->tableName());
+        _sharedScan = rs->sharedScan();
         _forward = forward;
         _eof = false;
+        _started = false;
         _lastMongoKey.reset();
         _cursor.reset();
     }
@@ -446,6 +474,22 @@ public:
             return {};
         }
 
+        if (!_started) {
+            _started = true;
+            // Only a scan over the whole table can run along with the others.
+            if (_sharedScan && _forward && !_lastMongoKey && EloqSharedScan::canShare(_opCtx)) {
+                _joinSharedScan();
+            }
+        }
+        if (_sharing) {
+            if (auto record = _nextShared()) {
+                return record;
+            }
+            if (_eof) {
+                return {};
+            }
+        }
+
         if (!_cursor) {
             _seekCursor();
         }
@@ -455,19 +499,19 @@ public:
         uassertStatusOK(TxErrorCodeToMongoStatus(txErr));
 
         const txservice::ScanBatchTuple* scanTuple = _cursor->currentBatchTuple();
-        if (scanTuple == nullptr) {
+        const auto* key = scanTuple ? scanTuple->key_.GetKey<Eloq::MongoKey>() : nullptr;
+        if (key == nullptr) {
+            if (_wrapEndKey && !_wrapping) {
+                // Scanned from where the shared scan was joined to the end; now wrap around.
+                _startWrapping();
+                return next();
+            }
             MONGO_LOG(1) << "reach the end";
             _eof = true;
             return {};
         }
 
-        const auto* key = scanTuple->key_.GetKey<Eloq::MongoKey>();
         const auto* record = static_cast<const Eloq::MongoRecord*>(scanTuple->record_);
-        if (key == nullptr) {
-            MONGO_LOG(1) << "reach the end";
-            _eof = true;
-            return {};
-        }
 
         RecordId id = key->ToRecordId(false);
         MONGO_LOG(1) << "id: " << id
@@ -483,6 +527,7 @@ public:
         if (_cursor) {
             _cursor.reset();
         }
+        _resetSharedScan();
 
         EloqKVPair& kvPair = _ru->getKVPair();
         Eloq::MongoKey& store_pkey = kvPair.keyRef();
@@ -518,11 +563,13 @@ public:
         MONGO_LOG(1) << "EloqRecordStoreCursor::saveUnpositioned";
         _lastMongoKey.reset();
         _cursor.reset();
+        _resetSharedScan();
     }
 
     void save() override {
         MONGO_LOG(1) << "EloqRecordStoreCursor::save";
-        if (!_eof && _cursor && _cursor->currentBatchTuple() != nullptr) {
+        // A shared scan keeps its position in the batch it holds.
+        if (!_eof && !_sharing && _cursor && _cursor->currentBatchTuple() != nullptr) {
             _lastMongoKey.emplace(*_cursor->currentBatchTuple()->key_.GetKey<Eloq::MongoKey>());
         }
         _cursor.reset();
@@ -564,12 +611,18 @@ private:
                 _startKey = Eloq::MongoKey::GetPosInfTxKey();
             }
         }
-        if (_forward) {
+        if (_wrapping) {
+            _endKey = txservice::TxKey(&_wrapEndKey.get());
+        } else if (_forward) {
             _endKey = Eloq::MongoKey::GetPosInfTxKey();
         } else {
             _endKey = Eloq::MongoKey::GetNegInfTxKey();
         }
 
+        _openScan(_wrapping);
+    }
+
+    void _openScan(bool endInclusive) {
         bool isForWrite = _opCtx->isUpsert();
         _cursor->indexScanOpen(_tableName,
                                _keySchema->SchemaTs(),
@@ -577,12 +630,186 @@ private:
                                &_startKey,
                                false,
                                &_endKey,
-                               false,
+                               endInclusive,
                                _forward ? txservice::ScanDirection::Forward
                                         : txservice::ScanDirection::Backward,
                                isForWrite);
     }
 
+    void _joinSharedScan() {
+        _sharing = true;
+        _sharedPrev = _sharedScan->join(&_joinSeq);
+        if (_sharedPrev) {
+            // Joined midway: what comes before the join point is read after wrapping around.
+            _wrapEndKey.emplace(_sharedPrev->records.back().id);
+        }
+    }
+
+    void _leaveSharedScan() {
+        if (_sharing) {
+            _sharing = false;
+            _sharedScan->leave();
+        }
+    }
+
+    void _resetSharedScan() {
+        _leaveSharedScan();
+        _sharedPrev.reset();
+        _sharedNode.reset();
+        _batch.reset();
+        _batchIdx = 0;
+        _cursorAfter = nullptr;
+        _wrapEndKey.reset();
+        _wrapping = false;
+    }
+
+    void _startWrapping() {
+        _wrapping = true;
+        _lastMongoKey.reset();
+        _cursor.reset();
+    }
+
+    // Returns the next record of the shared scan. Returns none once the cursor has left the
+    // shared scan, after which it either reached the end or goes on with a scan of its own.
+    boost::optional<Record> _nextShared() {
+        const uint64_t schemaVersion = _keySchema->SchemaTs();
+        while (true) {
+            if (_batch && _batchIdx < _batch->records.size()) {
+                return _batch->records[_batchIdx++];
+            }
+            if (_batch) {
+                _batch.reset();
+                _sharedPrev = std::move(_sharedNode);
+                if (_sharedPrev->isLast) {
+                    const bool wrapAround = _wrapEndKey.has_value();
+                    _leaveSharedScan();
+                    _sharedPrev.reset();
+                    if (wrapAround) {
+                        _startWrapping();
+                    } else {
+                        _eof = true;
+                    }
+                    return {};
+                }
+            }
+
+            std::shared_ptr<const EloqSharedScan::Batch> next;
+            uint64_t readSeq = 0;
+            const CoroutineFunctors& coro = _opCtx->getCoroutineFunctors();
+            switch (_sharedScan->advance(_sharedPrev, &next, &readSeq, coro.resumeFuncPtr)) {
+                case EloqSharedScan::Step::kFollow: {
+                    _cursor.reset();
+                    _cursorAfter = nullptr;
+                    // A batch read before this scan began may miss writes it must see.
+                    const bool usable =
+                        next->readSeq > _joinSeq && next->schemaVersion == schemaVersion;
+                    _sharedScan->noteFollowed(usable);
+                    _batch = usable ? next : _rereadSharedBatch(*next);
+                    _sharedNode = std::move(next);
+                    _batchIdx = 0;
+                    break;
+                }
+                case EloqSharedScan::Step::kRead: {
+                    auto abandonGuard = MakeGuard([&] { _sharedScan->abandonRead(); });
+                    auto batch = _readSharedBatch(readSeq);
+                    abandonGuard.Dismiss();
+                    _sharedScan->publish(_sharedPrev, batch);
+                    _sharedNode = batch;
+                    _batch = std::move(batch);
+                    _batchIdx = 0;
+                    break;
+                }
+                case EloqSharedScan::Step::kWait: {
+                    // Parked until the scan reading the batch publishes or abandons it.
+                    (*coro.yieldFuncPtr)();
+                    _opCtx->checkForInterrupt();
+                    break;
+                }
+                case EloqSharedScan::Step::kDetached: {
+                    // Fell too far behind; go on alone from the end of the last batch.
+                    if (_sharedPrev) {
+                        _lastMongoKey.emplace(_sharedPrev->records.back().id);
+                    }
+                    _leaveSharedScan();
+                    _sharedPrev.reset();
+                    _cursor.reset();
+                    _cursorAfter = nullptr;
+                    return {};
+                }
+            }
+        }
+    }
+
+    // Positions '_cursor' after the last record of '_sharedPrev', or at the beginning of the
+    // table, up to and including 'endAt' if given.
+    void _openSharedRange(const RecordId* endAt) {
+        _cursor.emplace(_opCtx);
+        _cursorAfter = nullptr;
+        if (_sharedPrev) {
+            _rangeStartKey.emplace(_sharedPrev->records.back().id);
+            _startKey = txservice::TxKey(&_rangeStartKey.get());
+        } else {
+            _startKey = Eloq::MongoKey::GetNegInfTxKey();
+        }
+        if (endAt) {
+            _rangeEndKey.emplace(*endAt);
+            _endKey = txservice::TxKey(&_rangeEndKey.get());
+        } else {
+            _endKey = Eloq::MongoKey::GetPosInfTxKey();
+        }
+        _openScan(endAt != nullptr);
+    }
+
+    // Appends the next record of '_cursor' to 'batch'. Returns false at the end of the scan.
+    bool _appendNextTuple(EloqSharedScan::Batch* batch) {
+        txservice::TxErrorCode txErr = _cursor->nextBatchTuple();
+        uassertStatusOK(TxErrorCodeToMongoStatus(txErr));
+
+        const txservice::ScanBatchTuple* scanTuple = _cursor->currentBatchTuple();
+        const auto* key = scanTuple ? scanTuple->key_.GetKey<Eloq::MongoKey>() : nullptr;
+        if (key == nullptr) {
+            return false;
+        }
+        const auto* record = static_cast<const Eloq::MongoRecord*>(scanTuple->record_);
+        RecordData data{record->EncodedBlobData(), static_cast<int>(record->EncodedBlobSize())};
+        batch->records.push_back({key->ToRecordId(false), data.getOwned()});
+        return true;
+    }
+
+    // Reads the batch following '_sharedPrev' for the other scans, one fetch from the storage.
+    std::shared_ptr<const EloqSharedScan::Batch> _readSharedBatch(uint64_t readSeq) {
+        if (!_cursor || !_sharedPrev || _cursorAfter != _sharedPrev.get()) {
+            _openSharedRange(nullptr);
+        }
+        _cursorAfter = nullptr;
+
+        auto batch = std::make_shared<EloqSharedScan::Batch>();
+        batch->readSeq = readSeq;
+        batch->schemaVersion = _keySchema->SchemaTs();
+        do {
+            if (!_appendNextTuple(batch.get())) {
+                batch->isLast = true;
+                break;
+            }
+        } while (!_cursor->fetchedBatchExhausted());
+
+        // Leave '_cursor' open to read the batch after this one as well.
+        _cursorAfter = batch.get();
+        return batch;
+    }
+
+    // Reads the records of the key range of 'node' again for this scan alone.
+    std::shared_ptr<const EloqSharedScan::Batch> _rereadSharedBatch(
+        const EloqSharedScan::Batch& node) {
+        _openSharedRange(node.isLast ? nullptr : &node.records.back().id);
+
+        auto batch = std::make_shared<EloqSharedScan::Batch>();
+        while (_appendNextTuple(batch.get())) {
+        }
+        _cursor.reset();
+        return batch;
+    }
+
     OperationContext* _opCtx;                         // not owned
     EloqRecoveryUnit* _ru;                            // not owned
     const txservice::TableName* _tableName{nullptr};  // not owned
@@ -598,6 +825,27 @@ private:
     txservice::TxKey _startKey;
     txservice::TxKey _endKey;
 
+    // Scans over the whole table share their reads through '_sharedScan', see EloqSharedScan.
+    EloqSharedScan* _sharedScan{nullptr};  // not owned
+    bool _started{false};
+    bool _sharing{false};
+    uint64_t _joinSeq{0};
+    // The batch of the shared scan before '_sharedNode', nullptr for the beginning of the table.
+    std::shared_ptr<const EloqSharedScan::Batch> _sharedPrev;
+    std::shared_ptr<const EloqSharedScan::Batch> _sharedNode;
+    // The records of '_sharedNode' this cursor returns; a copy of its own if it had to read them
+    // again.
+    std::shared_ptr<const EloqSharedScan::Batch> _batch;
+    size_t _batchIdx{0};
+    // The batch '_cursor' is positioned after, when it was left open by reading that batch.
+    const EloqSharedScan::Batch* _cursorAfter{nullptr};
+    boost::optional<Eloq::MongoKey> _rangeStartKey;
+    boost::optional<Eloq::MongoKey> _rangeEndKey;
+    // When this cursor joined the shared scan midway, the last key to return after wrapping
+    // around to the beginning of the table.
+    boost::optional<Eloq::MongoKey> _wrapEndKey;
+    bool _wrapping{false};
+
     // Mongo use EloqRecordStoreCursor even for exact match operation
     // which actually does not need construct a Cursor in Eloq's design.
     // So use boost::optional to delay the contruction
@@ -719,22 +967,24 @@ bool EloqRecordStore::findRecord(OperationContext* opCtx,
 
     auto ru = EloqRecoveryUnit::get(opCtx);
 
-    Eloq::MongoKey mongoKey(id);
-    Eloq::MongoRecord mongoRecord;
+    EloqScratchArena::Scope scratchScope(ru->scratchArena());
+    Eloq::MongoKey* mongoKey = ru->scratchArena().allocateKey();
+    mongoKey->SetPackedKey(id);
+    Eloq::MongoRecord* mongoRecord = ru->scratchArena().allocateRecord();
     uint64_t keySchemaVersion = ru->getIndexSchema(_tableName)->SchemaTs();
 
     bool isForWrite = opCtx->isUpsert();
     auto [exists, err] =
-        ru->getKV(opCtx, _tableName, keySchemaVersion, &mongoKey, &mongoRecord, isForWrite);
+        ru->getKV(opCtx, _tableName, keySchemaVersion, mongoKey, mongoRecord, isForWrite);
     uassertStatusOK(TxErrorCodeToMongoStatus(err));
     if (!exists) {
         MONGO_LOG(1) << "not exists";
         return false;
     }
 
-    *out =
-        RecordData{mongoRecord.EncodedBlobData(), static_cast<int>(mongoRecord.EncodedBlobSize())}
-            .getOwned();
+    *out = RecordData{mongoRecord->EncodedBlobData(),
+                      static_cast<int>(mongoRecord->EncodedBlobSize())}
+               .getOwned();
 
 
     // timer.stop();
@@ -751,13 +1001,14 @@ void EloqRecordStore::deleteRecord(OperationContext* opCtx, const RecordId& id)
 
     // For primary index.
     auto mongoKey = std::make_unique<Eloq::MongoKey>(id);
-    Eloq::MongoRecord mongoRecord;
+    EloqScratchArena::Scope scratchScope(ru->scratchArena());
+    Eloq::MongoRecord* mongoRecord = ru->scratchArena().allocateRecord();
     uint64_t keySchemaVersion = table._schema->KeySchema()->SchemaTs();
 
     // read the record if the table is creating indexes.
     if (table._creatingIndexes.size() > 0) {
         auto [exists, err] =
-            ru->getKV(opCtx, _tableName, keySchemaVersion, mongoKey.get(), &mongoRecord, true);
+            ru->getKV(opCtx, _tableName, keySchemaVersion, mongoKey.get(), mongoRecord, true);
         uassertStatusOK(TxErrorCodeToMongoStatus(err));
     }
 
@@ -771,22 +1022,19 @@ void EloqRecordStore::deleteRecord(OperationContext* opCtx, const RecordId& id)
 
     // remove record from creating index.
     if (table._creatingIndexes.size() > 0) {
-        BSONObj recordObj(mongoRecord.EncodedBlobData());
+        BSONObj recordObj(mongoRecord->EncodedBlobData());
+        KeyStringSet keys;
         for (const EloqRecoveryUnit::SecondaryIndex* index : table._creatingIndexes) {
             const txservice::TableName& indexName = index->first;
             const auto* keySchema =
                 static_cast<const Eloq::MongoKeySchema*>(index->second.sk_schema_.get());
 
-            BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
             MultikeyPaths multikeyPaths;
-            keySchema->GetKeys(recordObj, &keys, &multikeyPaths);
-            for (const BSONObj& bsonKey : keys) {
-                KeyString keyString(KeyString::kLatestVersion, bsonKey, keySchema->Ordering(), id);
-                auto mongoKey =
-                    std::make_unique<Eloq::MongoKey>(keyString.getBuffer(), keyString.getSize());
+            keySchema->GetKeyStrings(recordObj, &keys, &multikeyPaths);
+            for (size_t i = 0; i < keys.size(); ++i) {
                 err = ru->setKV(indexName,
                                 keySchema->SchemaTs(),
-                                std::move(mongoKey),
+                                makeIndexEntryKey(keys[i], id),
                                 nullptr,
                                 txservice::OperationType::Delete,
                                 false);
@@ -863,21 +1111,26 @@ Status EloqRecordStore::updateRecord(OperationContext* opCtx,
         return TxErrorCodeToMongoStatus(err);
     }
 
-    // For creating index
+    // For creating index. Indexes whose keys the update leaves unchanged already hold the right
+    // entries, so only the record write above is needed for them.
     try {
+        KeyStringSet keys;
         for (const EloqRecoveryUnit::SecondaryIndex* index : table._creatingIndexes) {
             const txservice::TableName& indexName = index->first;
             const auto* keySchema =
                 static_cast<const Eloq::MongoKeySchema*>(index->second.sk_schema_.get());
+            if (notifier &&
+                !notifier->indexKeysMayChange(opCtx, keySchema->IndexDescriptor()->indexName())) {
+                continue;
+            }
             if (keySchema->Unique()) {
                 uasserted(ErrorCodes::ConflictingOperationInProgress,
                           str::stream()
                               << "A conflict create-unique-index transaction is running.");
             }
 
-            BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
             MultikeyPaths multikeyPaths;
-            keySchema->GetKeys(recordObj, &keys, &multikeyPaths);
+            keySchema->GetKeyStrings(recordObj, &keys, &multikeyPaths);
             if (keys.size() > 1 || Eloq::MongoKeySchema::IsMultiKeyFromPaths(multikeyPaths)) {
                 if (!keySchema->IsMultiKey() ||
                     !std::includes(keySchema->MongoMultiKeyPaths().cbegin(),
@@ -889,21 +1142,15 @@ Status EloqRecordStore::updateRecord(OperationContext* opCtx,
                 }
             }
 
-            const BSONObj& skObj = *keys.cbegin();
-            KeyString keyString(KeyString::kLatestVersion, skObj, keySchema->Ordering(), id);
-            auto mongoKey =
-                std::make_unique<Eloq::MongoKey>(keyString.getBuffer(), keyString.getSize());
-            auto mongoRecord = std::make_unique<Eloq::MongoRecord>();
-            if (const auto& typeBits = keyString.getTypeBits(); !typeBits.isAllZeros()) {
-                mongoRecord->SetUnpackInfo(typeBits.getBuffer(), typeBits.getSize());
+            for (size_t i = 0; i < keys.size(); ++i) {
+                err = ru->setKV(indexName,
+                                keySchema->SchemaTs(),
+                                makeIndexEntryKey(keys[i], id),
+                                makeIndexEntryRecord(keys[i]),
+                                txservice::OperationType::Update,
+                                false);
+                uassertStatusOK(TxErrorCodeToMongoStatus(err));
             }
-            err = ru->setKV(indexName,
-                            keySchema->SchemaTs(),
-                            std::move(mongoKey),
-                            std::move(mongoRecord),
-                            txservice::OperationType::Update,
-                            false);
-            uassertStatusOK(TxErrorCodeToMongoStatus(err));
         }
     } catch (const mongo::DBException& e) {
         MONGO_LOG(1)
@@ -1034,7 +1281,7 @@ void EloqRecordStore::appendCustomStats(OperationContext* opCtx,
                                         BSONObjBuilder* result,
                                         double scale) const {
     MONGO_LOG(1) << "EloqRecordStore::appendCustomStats";
-    // MONGO_UNREACHABLE;
+    _sharedScan.appendStats(result);
 }
 
 void EloqRecordStore::updateStatsAfterRepair(OperationContext* opCtx,
@@ -1112,6 +1359,8 @@ Status EloqRecordStore::_insertRecords(OperationContext* opCtx,
         return TxErrorCodeToMongoStatus(err);
     }
 
+    // Index keys of the records for the indexes being built, reused from record to record.
+    KeyStringSet keys;
     for (size_t i = 0; i < nRecords; i++) {
         const txservice::ScanBatchTuple& tuple = batchTuples[i];
         if (tuple.status_ == txservice::RecordStatus::Normal) {
@@ -1155,10 +1404,8 @@ Status EloqRecordStore::_insertRecords(OperationContext* opCtx,
                                   << "A conflict create-unique-index transaction is running.");
                 }
 
-                BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
                 MultikeyPaths multikeyPaths;
-                keySchema->GetKeys(obj, &keys, &multikeyPaths);
-                invariant(keys.size() > 0 && multikeyPaths.size() > 0);
+                keySchema->GetKeyStrings(obj, &keys, &multikeyPaths);
                 if (keys.size() > 1 || Eloq::MongoKeySchema::IsMultiKeyFromPaths(multikeyPaths)) {
                     if (!keySchema->IsMultiKey() ||
                         !std::includes(keySchema->MongoMultiKeyPaths().cbegin(),
@@ -1171,23 +1418,15 @@ Status EloqRecordStore::_insertRecords(OperationContext* opCtx,
                     }
                 }
 
-                const BSONObj& skObj = *keys.cbegin();
-                KeyString keyString(
-                    KeyString::kLatestVersion, skObj, keySchema->Ordering(), records[i].id);
-                auto mongoKey =
-                    std::make_unique<Eloq::MongoKey>(keyString.getBuffer(), keyString.getSize());
-                auto mongoRecord = std::make_unique<Eloq::MongoRecord>();
-                if (const auto& typeBits = keyString.getTypeBits(); !typeBits.isAllZeros()) {
-                    mongoRecord->SetUnpackInfo(typeBits.getBuffer(), typeBits.getSize());
+                for (size_t k = 0; k < keys.size(); ++k) {
+                    err = ru->setKV(indexName,
+                                    keySchema->SchemaTs(),
+                                    makeIndexEntryKey(keys[k], records[i].id),
+                                    makeIndexEntryRecord(keys[k]),
+                                    txservice::OperationType::Insert,
+                                    unique);
+                    uassertStatusOK(TxErrorCodeToMongoStatus(err));
                 }
-                bool checkUnique = unique;
-                err = ru->setKV(indexName,
-                                keySchema->SchemaTs(),
-                                std::move(mongoKey),
-                                std::move(mongoRecord),
-                                txservice::OperationType::Insert,
-                                checkUnique);
-                uassertStatusOK(TxErrorCodeToMongoStatus(err));
             }
         } catch (const mongo::DBException& e) {
             MONGO_LOG(1) << "EloqRecordStore::_insertRecords insert record for dirty indexes raise "
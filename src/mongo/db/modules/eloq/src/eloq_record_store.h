@@ -22,6 +22,8 @@
 #include "mongo/bson/ordering.h"
 #include "mongo/db/storage/record_store.h"
 
+#include "mongo/db/modules/eloq/src/eloq_shared_scan.h"
+
 #include "mongo/db/modules/eloq/tx_service/include/type.h"
 
 namespace mongo {
@@ -200,6 +202,11 @@ public:
         return &_tableName;
     }
 
+    // Returns nullptr if scans of this collection must see its records in insertion order.
+    EloqSharedScan* sharedScan() const {
+        return _isCapped || _isOplog ? nullptr : &_sharedScan;
+    }
+
     const char* name() const override;
 
     const std::string& getIdent() const override;
@@ -327,6 +334,8 @@ private:
     mutable stdx::mutex _cappedCallbackMutex;
 
     bool _shuttingDown;
+
+    mutable EloqSharedScan _sharedScan;
 };
 
 }  // namespace mongo
@@ -18,19 +18,25 @@
 
 #define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <exception>
+#include <limits>
 #include <thread>
 #include <utility>
 
 #include "mongo/base/status.h"
 #include "mongo/bson/timestamp.h"
+#include "mongo/db/client.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/snapshot.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/concurrency/thread_name.h"
 #include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/progress_meter.h"
 
 #include "mongo/db/modules/eloq/src/base/eloq_key.h"
 #include "mongo/db/modules/eloq/src/base/eloq_record.h"
@@ -151,6 +157,7 @@ void EloqRecoveryUnit::reset() {
     _isTimestamped = false;
     _inMultiDocumentTransation = false;
     _kvPair.reset();
+    _scratchArena.release();
     _commitTimestamp.reset();
     _prepareTimestamp.reset();
     _lastTimestampSet.reset();
@@ -678,6 +685,27 @@ Status EloqRecoveryUnit::updateTable(const txservice::TableName& tableName,
         return Status::OK();
     } else {
         *insideDmlTxn = false;
+        boost::optional<ProgressMeterHolder> progress;
+        unsigned long long numRecords = 0;
+        if (opType == txservice::OperationType::AddIndex) {
+            // txservice populates the new index as part of the AddIndex schema change, while
+            // concurrent writes maintain it through the dirty schema (_creatingIndexes). Surface
+            // this phase in currentOp with the number of documents to index, taken from the table
+            // statistics and hence approximate. txservice does not report how far it got, so the
+            // meter only advances once the phase has ended.
+            if (const auto statistics = currentTableSchema->StatisticsObject()) {
+                if (const txservice::Distribution* distribution =
+                        statistics->GetDistribution(tableName)) {
+                    numRecords = distribution->Records();
+                }
+            }
+            str::stream msg;
+            msg << "Index Build: building " << alterTableInfo.index_add_count_
+                << " index(es) on " << tableName.StringView();
+            stdx::lock_guard<Client> lk(*_opCtx->getClient());
+            progress.emplace(CurOp::get(_opCtx)->setMessage_inlock(
+                std::string(msg).c_str(), "Index Build", numRecords));
+        }
         txservice::UpsertTableTxRequest upsertTableTxReq{&tableName,
                                                          &catalogRecord.Schema()->SchemaImage(),
                                                          catalogRecord.SchemaTs(),
@@ -693,6 +721,10 @@ Status EloqRecoveryUnit::updateTable(const txservice::TableName& tableName,
         switch (upsertTableTxReq.Result()) {
             case txservice::UpsertResult::Succeeded:
                 MONGO_LOG(1) << "UpsertTableTxRequest success";
+                if (progress) {
+                    progress->hit(static_cast<int>(std::min<unsigned long long>(
+                        numRecords, std::numeric_limits<int>::max())));
+                }
                 return Status::OK();
                 break;
             case txservice::UpsertResult::Failed: {
@@ -929,6 +961,7 @@ void EloqRecoveryUnit::_txnClose(bool commit) {
         MONGO_LOG(1) << "EloqRecoveryUnit::_txnClose. "
                      << "txm commit " << _txm->TxNumber();
 
+        CoroutineWaitTypeBlock waitType(_opCtx, CoroutineWaitStats::WaitType::kTxCommit);
         std::tie(succeed, err) = txservice::CommitTx(_txm, coro.yieldFuncPtr, coro.resumeFuncPtr);
         if (!succeed) {
             MONGO_LOG(1) << "txm commit fail. "
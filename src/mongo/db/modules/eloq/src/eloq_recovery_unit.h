@@ -17,6 +17,7 @@
  */
 #pragma once
 
+#include <deque>
 #include <set>
 #include <string_view>
 #include <unordered_map>
@@ -33,6 +34,7 @@
 
 #include "mongo/db/modules/eloq/src/base/eloq_key.h"
 #include "mongo/db/modules/eloq/src/base/eloq_record.h"
+#include "mongo/db/modules/eloq/src/base/eloq_scratch_arena.h"
 #include "mongo/db/modules/eloq/src/base/eloq_table_schema.h"
 #include "mongo/db/modules/eloq/src/eloq_cursor.h"
 
@@ -130,6 +132,14 @@ public:
     txservice::TransactionExecution* getTxm();
     bool inActiveTxn() const;
 
+    bool inUnitOfWork() const {
+        return _inUnitOfWork;
+    }
+
+    bool inMultiDocumentTransaction() const {
+        return _inMultiDocumentTransation;
+    }
+
     void registerCursor(EloqCursor* cursor);
     void closeAllCursors();
     void unregisterCursor(EloqCursor* cursor);
@@ -183,6 +193,10 @@ public:
         return _kvPair;
     }
 
+    EloqScratchArena& scratchArena() {
+        return _scratchArena;
+    }
+
     bool unreadyIsEmpty() {
         return _unreadyTableMap.empty();
     }
@@ -228,6 +242,7 @@ private:
     absl::flat_hash_set<EloqCursor*> _cursors;
 
     EloqKVPair _kvPair;
+    EloqScratchArena _scratchArena;
 
     Timestamp _commitTimestamp;
     Timestamp _prepareTimestamp;
@@ -0,0 +1,181 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "mongo/db/modules/eloq/src/eloq_shared_scan.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/repl/read_concern_level.h"
+#include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/util/assert_util.h"
+
+#include "mongo/db/modules/eloq/src/eloq_recovery_unit.h"
+
+namespace mongo {
+
+// Whether concurrent forward collection scans share the batches they read. Off by default: a
+// shared scan copies every record it reads so that others can take it, and one that joins midway
+// returns the records out of RecordId order.
+MONGO_EXPORT_SERVER_PARAMETER(eloqEnableSharedScans, bool, false);
+
+// How many of the most recently published batches a shared scan keeps for lagging scans.
+MONGO_EXPORT_SERVER_PARAMETER(eloqSharedScanRetainedBatches, int, 8)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1) {
+            return Status(ErrorCodes::BadValue,
+                          "eloqSharedScanRetainedBatches must be greater than or equal to 1");
+        }
+        return Status::OK();
+    });
+
+bool EloqSharedScan::canShare(OperationContext* opCtx) {
+    if (!eloqEnableSharedScans.load() || !serverGlobalParams.enableCoroutine) {
+        return false;
+    }
+    // Waiting for another scan's read yields the coroutine.
+    const CoroutineFunctors& coro = opCtx->getCoroutineFunctors();
+    if (!coro.yieldFuncPtr || !coro.resumeFuncPtr) {
+        return false;
+    }
+    if (opCtx->isUpsert() ||
+        opCtx->getIsolationLevel() !=
+            static_cast<int>(repl::ReadConcernLevel::kEloqReadCommittedIsolationLevel)) {
+        return false;
+    }
+    const EloqRecoveryUnit* ru = EloqRecoveryUnit::get(opCtx);
+    return !ru->inUnitOfWork() && !ru->inMultiDocumentTransaction();
+}
+
+std::shared_ptr<const EloqSharedScan::Batch> EloqSharedScan::join(uint64_t* joinSeq) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    ++_participants;
+    *joinSeq = _seq;
+    if (_recent.empty() || _recent.back()->isLast) {
+        return nullptr;
+    }
+    return _recent.back();
+}
+
+void EloqSharedScan::leave() {
+    std::deque<std::shared_ptr<const Batch>> dropped;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        invariant(_participants > 0);
+        if (--_participants > 0) {
+            return;
+        }
+        // A read in progress belongs to a participant, so nobody can publish after this.
+        invariant(!_readInProgress);
+        dropped.swap(_recent);
+        _first.reset();
+    }
+    // 'dropped' frees the documents of the batches outside of the mutex.
+}
+
+EloqSharedScan::Step EloqSharedScan::advance(const std::shared_ptr<const Batch>& prev,
+                                             std::shared_ptr<const Batch>* next,
+                                             uint64_t* readSeq,
+                                             const std::function<void()>* resume) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    const bool chainEnded = _recent.empty() || _recent.back()->isLast;
+
+    bool atEnd;
+    if (prev) {
+        invariant(!prev->isLast);
+        if ((*next = prev->_next.lock())) {
+            return Step::kFollow;
+        }
+        atEnd = !_recent.empty() && _recent.back() == prev;
+    } else if (chainEnded) {
+        atEnd = true;
+    } else {
+        *next = _first.lock();
+        if (*next) {
+            return Step::kFollow;
+        }
+        atEnd = false;
+    }
+
+    if (!atEnd) {
+        return Step::kDetached;
+    }
+    if (_readInProgress) {
+        _waiters.push_back(resume);
+        return Step::kWait;
+    }
+    _readInProgress = true;
+    *readSeq = ++_seq;
+    return Step::kRead;
+}
+
+void EloqSharedScan::publish(const std::shared_ptr<const Batch>& prev,
+                             std::shared_ptr<const Batch> batch) {
+    std::vector<const std::function<void()>*> waiters;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        invariant(_readInProgress);
+        _readInProgress = false;
+        waiters.swap(_waiters);
+
+        if (prev) {
+            invariant(_recent.back() == prev);
+            prev->_next = batch;
+        } else {
+            _recent.clear();
+            _first = batch;
+        }
+
+        _recent.push_back(std::move(batch));
+        while (_recent.size() > static_cast<size_t>(eloqSharedScanRetainedBatches.load())) {
+            _recent.pop_front();
+        }
+    }
+    _batchesPublished.addAndFetch(1);
+    _resumeWaiters(waiters);
+}
+
+void EloqSharedScan::abandonRead() {
+    std::vector<const std::function<void()>*> waiters;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        invariant(_readInProgress);
+        _readInProgress = false;
+        waiters.swap(_waiters);
+    }
+    _resumeWaiters(waiters);
+}
+
+void EloqSharedScan::_resumeWaiters(const std::vector<const std::function<void()>*>& waiters) {
+    // Resuming only queues the waiting coroutine, which runs once it has yielded.
+    for (const std::function<void()>* resume : waiters) {
+        (*resume)();
+    }
+}
+
+void EloqSharedScan::noteFollowed(bool shared) {
+    (shared ? _batchesShared : _batchesReread).addAndFetch(1);
+}
+
+void EloqSharedScan::appendStats(BSONObjBuilder* builder) const {
+    BSONObjBuilder bob(builder->subobjStart("sharedScans"));
+    bob.appendNumber("batchesPublished", _batchesPublished.load());
+    bob.appendNumber("batchesShared", _batchesShared.load());
+    bob.appendNumber("batchesReread", _batchesReread.load());
+}
+
+}  // namespace mongo
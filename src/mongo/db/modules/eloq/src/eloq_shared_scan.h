@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/storage/record_store.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+class BSONObjBuilder;
+class OperationContext;
+
+/**
+ * Lets concurrent forward scans over a whole table share the batches they read from storage.
+ *
+ * A scan joins behind the most recently published batch and then follows the chain of batches
+ * published after it. Whenever it reaches the end of the chain, it reads the next batch itself
+ * and publishes it for the others, which wait for it rather than reading it too. A scan that
+ * joined midway wraps around once it has seen the end of the table and reads the part it missed
+ * on its own.
+ *
+ * A scan only takes batches whose read began after it joined, so it sees every write committed
+ * before it started, as it would have reading them itself.
+ *
+ * The published batches are kept only while some scan takes part, so an idle collection holds
+ * no documents.
+ */
+class EloqSharedScan {
+public:
+    struct Batch {
+        // Sequence number assigned by advance() when the read of this batch started.
+        uint64_t readSeq;
+        uint64_t schemaVersion;
+        // Records with owned data, in key order.
+        std::vector<Record> records;
+        // True if no records follow this batch.
+        bool isLast{false};
+
+    private:
+        friend class EloqSharedScan;
+        // Guarded by the mutex of the EloqSharedScan the batch was published to.
+        mutable std::weak_ptr<const Batch> _next;
+    };
+
+    /**
+     * Returns true if the scans of 'opCtx' may read from or publish to a shared scan: they must
+     * read the latest committed data outside of any write or multi-document transaction.
+     */
+    static bool canShare(OperationContext* opCtx);
+
+    enum class Step {
+        // '*next' is the batch following 'prev'.
+        kFollow,
+        // The caller is to read the batch following 'prev' and then publish() or abandonRead().
+        kRead,
+        // Another scan is reading the batch following 'prev'. The caller is to yield until that
+        // read ends, when the scan calls the 'resume' given to advance(), and then try again.
+        kWait,
+        // The batch following 'prev' is no longer kept; the caller is to continue on its own.
+        kDetached,
+    };
+
+    /**
+     * Joins the scan. Returns the batch to continue after, or nullptr to start from the beginning
+     * of the table. '*joinSeq' is set to the sequence number that batches taken from the scan
+     * must have been read after. Every join must be matched by a leave().
+     */
+    std::shared_ptr<const Batch> join(uint64_t* joinSeq);
+
+    /**
+     * Leaves the scan. The last scan to leave drops the batches kept for the others.
+     */
+    void leave();
+
+    /**
+     * Determines how a scan gets the batch after 'prev', the beginning of the table if nullptr.
+     * Sets '*next' for kFollow, and '*readSeq' for kRead. For kWait, 'resume' is called once
+     * when the read in progress ends; it must stay valid until then.
+     */
+    Step advance(const std::shared_ptr<const Batch>& prev,
+                 std::shared_ptr<const Batch>* next,
+                 uint64_t* readSeq,
+                 const std::function<void()>* resume);
+
+    /**
+     * Ends the read begun by advance() by publishing 'batch' as the batch following 'prev', and
+     * resumes the scans waiting for it.
+     */
+    void publish(const std::shared_ptr<const Batch>& prev, std::shared_ptr<const Batch> batch);
+
+    /**
+     * Ends the read begun by advance() without publishing a batch, and resumes the scans waiting
+     * for it so that one of them reads it instead.
+     */
+    void abandonRead();
+
+    /**
+     * Counts a batch a scan took from the others, or read again on its own because it was read
+     * too early or under another schema.
+     */
+    void noteFollowed(bool shared);
+
+    /**
+     * Appends how many batches were published, taken from other scans and read again.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    /**
+     * Resumes 'waiters', taken from '_waiters' when the read in progress ended.
+     */
+    static void _resumeWaiters(const std::vector<const std::function<void()>*>& waiters);
+
+    mutable stdx::mutex _mutex;
+    uint64_t _seq{0};
+    bool _readInProgress{false};
+    // Number of scans that joined and have not left yet.
+    size_t _participants{0};
+    // Resume functors of the scans waiting for the read in progress to end.
+    std::vector<const std::function<void()>*> _waiters;
+    // The first batch of the current chain, which scans starting from the beginning follow.
+    std::weak_ptr<const Batch> _first;
+    // The most recently published batches, newest last, so that scans lagging a little behind
+    // the tail still find them.
+    std::deque<std::shared_ptr<const Batch>> _recent;
+
+    AtomicInt64 _batchesPublished;
+    AtomicInt64 _batchesShared;
+    AtomicInt64 _batchesReread;
+};
+
+}  // namespace mongo
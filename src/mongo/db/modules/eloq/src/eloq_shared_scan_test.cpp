@@ -0,0 +1,243 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/modules/eloq/src/eloq_shared_scan.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Batch = EloqSharedScan::Batch;
+using Step = EloqSharedScan::Step;
+
+std::shared_ptr<const Batch> makeBatch(uint64_t readSeq, bool isLast = false) {
+    auto batch = std::make_shared<Batch>();
+    batch->readSeq = readSeq;
+    batch->schemaVersion = 1;
+    batch->isLast = isLast;
+    return batch;
+}
+
+// Reads the batch after 'prev' on behalf of a scan that expects to be the one reading it.
+std::shared_ptr<const Batch> readAndPublish(EloqSharedScan& scan,
+                                            const std::shared_ptr<const Batch>& prev,
+                                            bool isLast = false) {
+    std::shared_ptr<const Batch> next;
+    uint64_t readSeq = 0;
+    ASSERT(scan.advance(prev, &next, &readSeq, nullptr) == Step::kRead);
+    auto batch = makeBatch(readSeq, isLast);
+    scan.publish(prev, batch);
+    return batch;
+}
+
+TEST(EloqSharedScanTest, FirstScanStartsFromTheBeginning) {
+    EloqSharedScan scan;
+    uint64_t joinSeq = 42;
+    ASSERT(!scan.join(&joinSeq));
+    ASSERT_EQ(joinSeq, 0U);
+
+    std::shared_ptr<const Batch> next;
+    uint64_t readSeq = 0;
+    ASSERT(scan.advance(nullptr, &next, &readSeq, nullptr) == Step::kRead);
+    ASSERT_EQ(readSeq, 1U);
+    scan.abandonRead();
+    scan.leave();
+}
+
+TEST(EloqSharedScanTest, JoinContinuesAfterTheLatestBatch) {
+    EloqSharedScan scan;
+    uint64_t joinSeq;
+    ASSERT(!scan.join(&joinSeq));
+    auto first = readAndPublish(scan, nullptr);
+    auto second = readAndPublish(scan, first);
+
+    ASSERT_EQ(scan.join(&joinSeq), second);
+    ASSERT_EQ(joinSeq, 2U);
+
+    // A scan starting from the beginning follows the chain published so far.
+    std::shared_ptr<const Batch> next;
+    uint64_t readSeq;
+    ASSERT(scan.advance(nullptr, &next, &readSeq, nullptr) == Step::kFollow);
+    ASSERT_EQ(next, first);
+    ASSERT(scan.advance(first, &next, &readSeq, nullptr) == Step::kFollow);
+    ASSERT_EQ(next, second);
+
+    scan.leave();
+    scan.leave();
+}
+
+TEST(EloqSharedScanTest, JoinAfterTheLastBatchStartsOver) {
+    EloqSharedScan scan;
+    uint64_t joinSeq;
+    scan.join(&joinSeq);
+    auto last = readAndPublish(scan, nullptr, true);
+
+    ASSERT(!scan.join(&joinSeq));
+    ASSERT_EQ(joinSeq, 1U);
+
+    // The next read from the beginning starts a new chain.
+    auto first = readAndPublish(scan, nullptr);
+    ASSERT_EQ(first->readSeq, 2U);
+    std::shared_ptr<const Batch> next;
+    uint64_t readSeq;
+    ASSERT(scan.advance(nullptr, &next, &readSeq, nullptr) == Step::kFollow);
+    ASSERT_EQ(next, first);
+
+    scan.leave();
+    scan.leave();
+}
+
+TEST(EloqSharedScanTest, WaiterIsResumedByPublish) {
+    EloqSharedScan scan;
+    uint64_t joinSeq;
+    scan.join(&joinSeq);
+    scan.join(&joinSeq);
+
+    std::shared_ptr<const Batch> next;
+    uint64_t readSeq;
+    ASSERT(scan.advance(nullptr, &next, &readSeq, nullptr) == Step::kRead);
+
+    int resumed = 0;
+    const std::function<void()> resume = [&] { ++resumed; };
+    uint64_t waiterSeq = 0;
+    ASSERT(scan.advance(nullptr, &next, &waiterSeq, &resume) == Step::kWait);
+    ASSERT_EQ(resumed, 0);
+
+    auto batch = makeBatch(readSeq);
+    scan.publish(nullptr, batch);
+    ASSERT_EQ(resumed, 1);
+
+    ASSERT(scan.advance(nullptr, &next, &waiterSeq, &resume) == Step::kFollow);
+    ASSERT_EQ(next, batch);
+    ASSERT_EQ(resumed, 1);
+
+    scan.leave();
+    scan.leave();
+}
+
+TEST(EloqSharedScanTest, WaiterReadsAfterAbandonedRead) {
+    EloqSharedScan scan;
+    uint64_t joinSeq;
+    scan.join(&joinSeq);
+    scan.join(&joinSeq);
+    auto first = readAndPublish(scan, nullptr);
+
+    std::shared_ptr<const Batch> next;
+    uint64_t readSeq;
+    ASSERT(scan.advance(first, &next, &readSeq, nullptr) == Step::kRead);
+    ASSERT_EQ(readSeq, 2U);
+
+    int resumed = 0;
+    const std::function<void()> resume = [&] { ++resumed; };
+    ASSERT(scan.advance(first, &next, &readSeq, &resume) == Step::kWait);
+
+    scan.abandonRead();
+    ASSERT_EQ(resumed, 1);
+
+    // The waiter reads the batch itself, after everything the abandoned read could have seen.
+    ASSERT(scan.advance(first, &next, &readSeq, &resume) == Step::kRead);
+    ASSERT_EQ(readSeq, 3U);
+    scan.abandonRead();
+    ASSERT_EQ(resumed, 1);
+
+    scan.leave();
+    scan.leave();
+}
+
+TEST(EloqSharedScanTest, LaggingScanDetachesOnceItsNextBatchIsDropped) {
+    EloqSharedScan scan;
+    uint64_t joinSeq;
+    scan.join(&joinSeq);
+    scan.join(&joinSeq);
+
+    // The lagging scan holds on to the first batch only, so the batches after it are freed as
+    // newer ones push them out of the retained ones.
+    auto first = readAndPublish(scan, nullptr);
+    std::shared_ptr<const Batch> last = first;
+    std::weak_ptr<const Batch> second;
+    for (int i = 0; i < 20; ++i) {
+        last = readAndPublish(scan, last);
+        if (i == 0) {
+            second = last;
+        }
+    }
+    ASSERT(second.expired());
+
+    std::shared_ptr<const Batch> next;
+    uint64_t readSeq;
+    ASSERT(scan.advance(first, &next, &readSeq, nullptr) == Step::kDetached);
+
+    // A scan starting over still finds the first batch while someone holds on to it.
+    ASSERT(scan.advance(nullptr, &next, &readSeq, nullptr) == Step::kFollow);
+    ASSERT_EQ(next, first);
+
+    // The scan at the tail still reads on.
+    ASSERT(scan.advance(last, &next, &readSeq, nullptr) == Step::kRead);
+    scan.abandonRead();
+
+    scan.leave();
+    scan.leave();
+}
+
+TEST(EloqSharedScanTest, LastLeaveDropsTheBatches) {
+    EloqSharedScan scan;
+    uint64_t joinSeq;
+    scan.join(&joinSeq);
+    scan.join(&joinSeq);
+    std::weak_ptr<const Batch> first = readAndPublish(scan, nullptr);
+
+    scan.leave();
+    ASSERT(!first.expired());
+
+    scan.leave();
+    ASSERT(first.expired());
+
+    // The next scan starts a new chain.
+    ASSERT(!scan.join(&joinSeq));
+    ASSERT_EQ(joinSeq, 1U);
+    std::shared_ptr<const Batch> next;
+    uint64_t readSeq;
+    ASSERT(scan.advance(nullptr, &next, &readSeq, nullptr) == Step::kRead);
+    ASSERT_EQ(readSeq, 2U);
+    scan.abandonRead();
+    scan.leave();
+}
+
+TEST(EloqSharedScanTest, Stats) {
+    EloqSharedScan scan;
+    uint64_t joinSeq;
+    scan.join(&joinSeq);
+    readAndPublish(scan, nullptr);
+    scan.noteFollowed(true);
+    scan.noteFollowed(true);
+    scan.noteFollowed(false);
+    scan.leave();
+
+    BSONObjBuilder builder;
+    scan.appendStats(&builder);
+    ASSERT_BSONOBJ_EQ(
+        builder.obj(),
+        BSON("sharedScans" << BSON("batchesPublished" << 1 << "batchesShared" << 2
+                                                      << "batchesReread" << 1)));
+}
+
+}  // namespace
+}  // namespace mongo
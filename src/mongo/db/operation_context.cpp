@@ -119,6 +119,7 @@ void OperationContext::reset(Client* client, unsigned int opId) {
     _maxTime = Microseconds::max();
     _writesAreReplicated = true;
     _coroFunctors = CoroutineFunctors::Unavailable;
+    _coroWaitStats.reset();
     _isolationLevel = 0;
     _isUpsert = false;
 }
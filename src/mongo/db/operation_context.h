@@ -75,6 +75,52 @@ struct CoroutineFunctors {
     const static CoroutineFunctors Unavailable;
 };
 
+/**
+ * Time an operation's coroutine spent suspended, split by what it was waiting for:
+ *  - storageWait: yielded on a tx service request until the request resumed it,
+ *  - txCommit: the same, for commit requests,
+ *  - queueWait: resumable, but waiting in its ThreadGroup's queue to run again.
+ *
+ * Recorded by the ServiceStateMachine around every yield; read concurrently by $currentOp.
+ */
+class CoroutineWaitStats {
+public:
+    enum class WaitType { kStorage, kTxCommit };
+
+    void record(WaitType type, Microseconds suspended, Microseconds queued) {
+        auto& counter = type == WaitType::kTxCommit ? _txCommitMicros : _storageWaitMicros;
+        counter.fetchAndAdd(durationCount<Microseconds>(suspended));
+        _queueWaitMicros.fetchAndAdd(durationCount<Microseconds>(queued));
+    }
+
+    void reset() {
+        _storageWaitMicros.store(0);
+        _queueWaitMicros.store(0);
+        _txCommitMicros.store(0);
+        waitType = WaitType::kStorage;
+    }
+
+    long long storageWaitMicros() const {
+        return _storageWaitMicros.load();
+    }
+
+    long long queueWaitMicros() const {
+        return _queueWaitMicros.load();
+    }
+
+    long long txCommitMicros() const {
+        return _txCommitMicros.load();
+    }
+
+    // What the operation is about to wait for; see CoroutineWaitTypeBlock.
+    WaitType waitType{WaitType::kStorage};
+
+private:
+    AtomicInt64 _storageWaitMicros;
+    AtomicInt64 _queueWaitMicros;
+    AtomicInt64 _txCommitMicros;
+};
+
 /**
  * This class encompasses the state required by an operation and lives from the time a network
  * operation is dispatched until its execution is finished. Note that each "getmore" on a cursor
@@ -462,6 +508,14 @@ public:
         }
     }
 
+    CoroutineWaitStats& coroutineWaitStats() {
+        return _coroWaitStats;
+    }
+
+    const CoroutineWaitStats& coroutineWaitStats() const {
+        return _coroWaitStats;
+    }
+
     int getIsolationLevel() const {
         return _isolationLevel;
     }
@@ -584,6 +638,7 @@ private:
     bool _writesAreReplicated = true;
 
     CoroutineFunctors _coroFunctors;
+    CoroutineWaitStats _coroWaitStats;
     int _isolationLevel{0};
     bool _isUpsert{false};
 
@@ -629,4 +684,26 @@ private:
     const bool _shouldReplicateWrites;
 };
 }  // namespace repl
+
+/**
+ * RAII-style class that attributes the coroutine waits of an operation to 'type' while the object
+ * is in scope.
+ */
+class CoroutineWaitTypeBlock {
+    MONGO_DISALLOW_COPYING(CoroutineWaitTypeBlock);
+
+public:
+    CoroutineWaitTypeBlock(OperationContext* opCtx, CoroutineWaitStats::WaitType type)
+        : _stats(opCtx->coroutineWaitStats()), _previous(_stats.waitType) {
+        _stats.waitType = type;
+    }
+
+    ~CoroutineWaitTypeBlock() {
+        _stats.waitType = _previous;
+    }
+
+private:
+    CoroutineWaitStats& _stats;
+    const CoroutineWaitStats::WaitType _previous;
+};
 }  // namespace mongo
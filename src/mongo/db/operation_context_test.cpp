@@ -139,6 +139,29 @@ DEATH_TEST(OperationContextTest, SettingTransactionNumberWithoutSessionIdShouldC
     opCtx->setTxnNumber(5);
 }
 
+TEST(OperationContextTest, CoroutineWaitStatsAreSplitByWaitType) {
+    auto serviceCtx = ServiceContext::make();
+    auto client = serviceCtx->makeClient("OperationContextTest");
+    auto opCtx = client->makeOperationContext();
+
+    auto& waitStats = opCtx->coroutineWaitStats();
+    waitStats.record(waitStats.waitType, Microseconds(100), Microseconds(10));
+    {
+        CoroutineWaitTypeBlock commit(opCtx.get(), CoroutineWaitStats::WaitType::kTxCommit);
+        waitStats.record(waitStats.waitType, Microseconds(300), Microseconds(20));
+    }
+    waitStats.record(waitStats.waitType, Microseconds(5), Microseconds(0));
+
+    ASSERT_EQ(waitStats.storageWaitMicros(), 105);
+    ASSERT_EQ(waitStats.txCommitMicros(), 300);
+    ASSERT_EQ(waitStats.queueWaitMicros(), 30);
+
+    waitStats.reset();
+    ASSERT_EQ(waitStats.storageWaitMicros(), 0);
+    ASSERT_EQ(waitStats.txCommitMicros(), 0);
+    ASSERT_EQ(waitStats.queueWaitMicros(), 0);
+}
+
 TEST(OperationContextTest, OpCtxGroup) {
     OperationContextGroup group1;
     ASSERT_TRUE(group1.isEmpty());
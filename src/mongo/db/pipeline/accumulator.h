@@ -163,6 +163,19 @@ private:
 
 class AccumulatorSum final : public Accumulator {
 public:
+    /**
+     * The running total. It is a separate trivially copyable type so that GroupTable can store it
+     * inline without allocating an Accumulator per group.
+     */
+    struct State {
+        void process(const Value& input, bool merging);
+        Value getValue(bool toBeMerged) const;
+
+        BSONType totalType = NumberInt;
+        DoubleDoubleSummation nonDecimalTotal;
+        Decimal128 decimalTotal;
+    };
+
     explicit AccumulatorSum(const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
     void processInternal(const Value& input, bool merging) final;
@@ -182,9 +195,7 @@ public:
     }
 
 private:
-    BSONType totalType = NumberInt;
-    DoubleDoubleSummation nonDecimalTotal;
-    Decimal128 decimalTotal;
+    State _state;
 };
 
 
@@ -251,6 +262,25 @@ private:
 
 class AccumulatorAvg final : public Accumulator {
 public:
+    /**
+     * The running total and count. Like AccumulatorSum::State, GroupTable stores it inline.
+     */
+    struct State {
+        void process(const Value& input, bool merging);
+        Value getValue(bool toBeMerged) const;
+
+        /**
+         * The total of all values is partitioned between those that are decimals, and those that
+         * are not decimals, so the decimal total needs to add the non-decimal.
+         */
+        Decimal128 getDecimalTotal() const;
+
+        bool isDecimal = false;
+        DoubleDoubleSummation nonDecimalTotal;
+        Decimal128 decimalTotal;
+        long long count = 0;
+    };
+
     explicit AccumulatorAvg(const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
     void processInternal(const Value& input, bool merging) final;
@@ -262,16 +292,7 @@ public:
         const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
 private:
-    /**
-     * The total of all values is partitioned between those that are decimals, and those that are
-     * not decimals, so the decimal total needs to add the non-decimal.
-     */
-    Decimal128 _getDecimalTotal() const;
-
-    bool _isDecimal;
-    DoubleDoubleSummation _nonDecimalTotal;
-    Decimal128 _decimalTotal;
-    long long _count;
+    State _state;
 };
 
 
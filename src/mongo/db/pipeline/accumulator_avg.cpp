@@ -54,7 +54,7 @@ const char subTotalErrorName[] = "subTotalError";  // Used for extra precision
 const char countName[] = "count";
 }  // namespace
 
-void AccumulatorAvg::processInternal(const Value& input, bool merging) {
+void AccumulatorAvg::State::process(const Value& input, bool merging) {
     if (merging) {
         // We expect an object that contains both a subtotal and a count. Additionally there may
         // be an error value, that allows for additional precision.
@@ -62,75 +62,80 @@ void AccumulatorAvg::processInternal(const Value& input, bool merging) {
         verify(input.getType() == Object);
         // We're recursively adding the subtotal to get the proper type treatment, but this only
         // increments the count by one, so adjust the count afterwards. Similarly for 'error'.
-        processInternal(input[subTotalName], false);
-        _count += input[countName].getLong() - 1;
+        process(input[subTotalName], false);
+        count += input[countName].getLong() - 1;
         Value error = input[subTotalErrorName];
         if (!error.missing()) {
-            processInternal(error, false);
-            _count--;  // The error correction only adjusts the total, not the number of items.
+            process(error, false);
+            count--;  // The error correction only adjusts the total, not the number of items.
         }
         return;
     }
 
     switch (input.getType()) {
         case NumberDecimal:
-            _decimalTotal = _decimalTotal.add(input.getDecimal());
-            _isDecimal = true;
+            decimalTotal = decimalTotal.add(input.getDecimal());
+            isDecimal = true;
             break;
         case NumberLong:
             // Avoid summation using double as that loses precision.
-            _nonDecimalTotal.addLong(input.getLong());
+            nonDecimalTotal.addLong(input.getLong());
             break;
         case NumberInt:
         case NumberDouble:
-            _nonDecimalTotal.addDouble(input.getDouble());
+            nonDecimalTotal.addDouble(input.getDouble());
             break;
         default:
             dassert(!input.numeric());
             return;
     }
-    _count++;
+    count++;
 }
 
-intrusive_ptr<Accumulator> AccumulatorAvg::create(
-    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
-    return new AccumulatorAvg(expCtx);
+Decimal128 AccumulatorAvg::State::getDecimalTotal() const {
+    return decimalTotal.add(nonDecimalTotal.getDecimal());
 }
 
-Decimal128 AccumulatorAvg::_getDecimalTotal() const {
-    return _decimalTotal.add(_nonDecimalTotal.getDecimal());
-}
-
-Value AccumulatorAvg::getValue(bool toBeMerged) {
+Value AccumulatorAvg::State::getValue(bool toBeMerged) const {
     if (toBeMerged) {
-        if (_isDecimal)
-            return Value(Document{{subTotalName, _getDecimalTotal()}, {countName, _count}});
+        if (isDecimal)
+            return Value(Document{{subTotalName, getDecimalTotal()}, {countName, count}});
 
         double total, error;
-        std::tie(total, error) = _nonDecimalTotal.getDoubleDouble();
+        std::tie(total, error) = nonDecimalTotal.getDoubleDouble();
         return Value(
-            Document{{subTotalName, total}, {countName, _count}, {subTotalErrorName, error}});
+            Document{{subTotalName, total}, {countName, count}, {subTotalErrorName, error}});
     }
 
-    if (_count == 0)
+    if (count == 0)
         return Value(BSONNULL);
 
-    if (_isDecimal)
-        return Value(_getDecimalTotal().divide(Decimal128(static_cast<int64_t>(_count))));
+    if (isDecimal)
+        return Value(getDecimalTotal().divide(Decimal128(static_cast<int64_t>(count))));
+
+    return Value(nonDecimalTotal.getDouble() / static_cast<double>(count));
+}
+
+void AccumulatorAvg::processInternal(const Value& input, bool merging) {
+    _state.process(input, merging);
+}
 
-    return Value(_nonDecimalTotal.getDouble() / static_cast<double>(_count));
+intrusive_ptr<Accumulator> AccumulatorAvg::create(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    return new AccumulatorAvg(expCtx);
+}
+
+Value AccumulatorAvg::getValue(bool toBeMerged) {
+    return _state.getValue(toBeMerged);
 }
 
 AccumulatorAvg::AccumulatorAvg(const boost::intrusive_ptr<ExpressionContext>& expCtx)
-    : Accumulator(expCtx), _isDecimal(false), _count(0) {
+    : Accumulator(expCtx) {
     // This is a fixed size Accumulator so we never need to update this
     _memUsageBytes = sizeof(*this);
 }
 
 void AccumulatorAvg::reset() {
-    _isDecimal = false;
-    _nonDecimalTotal = {};
-    _decimalTotal = {};
-    _count = 0;
+    _state = State();
 }
 }
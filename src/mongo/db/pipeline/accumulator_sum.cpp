@@ -55,13 +55,13 @@ const char subTotalErrorName[] = "subTotalError";  // Used for extra precision.
 }  // namespace
 
 
-void AccumulatorSum::processInternal(const Value& input, bool merging) {
+void AccumulatorSum::State::process(const Value& input, bool merging) {
     if (!input.numeric()) {
         if (merging && input.getType() == Object) {
             // Process merge document, see getValue() below.
             nonDecimalTotal.addDouble(
-                input[subTotalName].getDouble());              // Sum without adjusting type.
-            processInternal(input[subTotalErrorName], false);  // Sum adjusting for type of error.
+                input[subTotalName].getDouble());      // Sum without adjusting type.
+            process(input[subTotalErrorName], false);  // Sum adjusting for type of error.
         }
         return;
     }
@@ -84,12 +84,7 @@ void AccumulatorSum::processInternal(const Value& input, bool merging) {
     }
 }
 
-intrusive_ptr<Accumulator> AccumulatorSum::create(
-    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
-    return new AccumulatorSum(expCtx);
-}
-
-Value AccumulatorSum::getValue(bool toBeMerged) {
+Value AccumulatorSum::State::getValue(bool toBeMerged) const {
     switch (totalType) {
         case NumberInt:
             if (nonDecimalTotal.fitsLong())
@@ -134,6 +129,19 @@ Value AccumulatorSum::getValue(bool toBeMerged) {
     }
 }
 
+void AccumulatorSum::processInternal(const Value& input, bool merging) {
+    _state.process(input, merging);
+}
+
+intrusive_ptr<Accumulator> AccumulatorSum::create(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    return new AccumulatorSum(expCtx);
+}
+
+Value AccumulatorSum::getValue(bool toBeMerged) {
+    return _state.getValue(toBeMerged);
+}
+
 AccumulatorSum::AccumulatorSum(const boost::intrusive_ptr<ExpressionContext>& expCtx)
     : Accumulator(expCtx) {
     // This is a fixed size Accumulator so we never need to update this.
@@ -141,8 +149,6 @@ AccumulatorSum::AccumulatorSum(const boost::intrusive_ptr<ExpressionContext>& ex
 }
 
 void AccumulatorSum::reset() {
-    totalType = NumberInt;
-    nonDecimalTotal = {};
-    decimalTotal = {};
+    _state = State();
 }
 }  // namespace mongo
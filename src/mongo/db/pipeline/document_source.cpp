@@ -85,6 +85,18 @@ const char* DocumentSource::getSourceName() const {
     return unknown;
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSource::getNextBatch(
+    std::vector<Document>* batch, size_t maxDocs) {
+    for (size_t i = 0; i < maxDocs; ++i) {
+        auto next = getNext();
+        if (!next.isAdvanced()) {
+            return next.getStatus();
+        }
+        batch->push_back(next.releaseDocument());
+    }
+    return GetNextResult::ReturnStatus::kAdvanced;
+}
+
 intrusive_ptr<DocumentSource> DocumentSource::optimize() {
     return this;
 }
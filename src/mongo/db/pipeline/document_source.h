@@ -433,6 +433,17 @@ public:
      */
     virtual GetNextResult getNext() = 0;
 
+    /**
+     * Appends up to 'maxDocs' results of this DocumentSource to 'batch'. Returns kAdvanced if the
+     * batch was filled and more results may follow, or else the status, kEOF or kPauseExecution,
+     * that ended the batch.
+     *
+     * A consumer of batches holds on to the documents of a batch until it is complete. The default
+     * implementation calls getNext(); a stage whose output is expensive to retain across calls to
+     * getNext() can override it to return smaller batches.
+     */
+    virtual GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch, size_t maxDocs);
+
     /**
      * Returns a struct containing information about any special constraints imposed on using this
      * stage. Input parameter Pipeline::SplitState is used by stages whose requirements change
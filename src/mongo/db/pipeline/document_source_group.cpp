@@ -28,6 +28,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <numeric>
+
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
@@ -38,6 +40,7 @@
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
 
 namespace mongo {
@@ -115,6 +118,18 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
 
 DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     // Not spilled, and not streaming.
+    if (_groupTable) {
+        if (_groupTableOutputPos >= _groupTable->size())
+            return GetNextResult::makeEOF();
+
+        Document out = makeDocument(_groupTableOutputPos, pExpCtx->needsMerge);
+
+        if (++_groupTableOutputPos == _groupTable->size())
+            dispose();
+
+        return std::move(out);
+    }
+
     if (_groups->empty())
         return GetNextResult::makeEOF();
 
@@ -167,6 +182,9 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
 void DocumentSourceGroup::doDispose() {
     // Free our resources.
     _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+    if (_groupTable) {
+        _groupTable->clear();
+    }
     _sorterIterator.reset();
 
     // Make us look done.
@@ -385,6 +403,16 @@ private:
     ValueComparator _valueComparator;
 };
 
+/**
+ * Returns the memory used by an entry of a GroupsMap with 'numAccumulators' accumulators besides
+ * the memory reported by the key and the accumulators themselves: the hash node with its cached
+ * hash and next pointer, its bucket, and the vector of accumulator pointers.
+ */
+size_t groupsMapEntryOverheadBytes(size_t numAccumulators) {
+    return sizeof(GroupsMap::value_type) - sizeof(Value) + sizeof(void*) + sizeof(size_t) +
+        sizeof(void*) + numAccumulators * sizeof(intrusive_ptr<Accumulator>);
+}
+
 bool containsOnlyFieldPathsAndConstants(ExpressionObject* expressionObj) {
     for (auto&& it : expressionObj->getChildExpressions()) {
         const intrusive_ptr<Expression>& childExp = it.second;
@@ -478,84 +506,80 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     }
 
 
-    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
-    GetNextResult input = pSource->getNext();
-    for (; input.isAdvanced(); input = pSource->getNext()) {
-        if (_memoryUsageBytes > _maxMemoryUsageBytes) {
-            uassert(16945,
-                    "Exceeded memory limit for $group, but didn't allow external sort."
-                    " Pass allowDiskUse:true to opt in.",
-                    _allowDiskUse);
-            _sortedFiles.push_back(spill());
-            _memoryUsageBytes = 0;
+    // Group into the compact table when every accumulator keeps fixed-size state. This is decided
+    // before any input is consumed, since the two representations are not interchangeable.
+    if (!_groupTable && _groups->empty() && _sortedFiles.empty()) {
+        if (auto kinds = GroupTable::getAccumulatorKinds(_accumulatedFields, pExpCtx)) {
+            _groupTable.emplace(pExpCtx->getValueComparator(), std::move(*kinds));
         }
+    }
 
-        // We release the result document here so that it does not outlive the end of this loop
-        // iteration. Not releasing could lead to an array copy when this group follows an unwind.
-        auto rootDocument = input.releaseDocument();
-        Value id = computeId(rootDocument);
-
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<Accumulator>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
-
-        if (inserted) {
-            _memoryUsageBytes += id.getApproximateSize();
-
-            // Add the accumulators
-            group.reserve(numAccumulators);
-            for (auto&& accumulatedField : _accumulatedFields) {
-                group.push_back(accumulatedField.makeAccumulator(pExpCtx));
-            }
-        } else {
-            for (auto&& groupObj : group) {
-                // subtract old mem usage. New usage added back after processing.
-                _memoryUsageBytes -= groupObj->memUsageForSorter();
-            }
+    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'. The input is
+    // consumed in batches, over which the _id and accumulator expressions are evaluated a column at
+    // a time.
+    const size_t batchSize = std::max(internalDocumentSourceGroupBatchSize.load(), 1);
+    std::vector<Document> batch;
+    std::vector<Value> ids;
+    std::vector<std::vector<Value>> args(numAccumulators);
+    auto status = GetNextResult::ReturnStatus::kAdvanced;
+    while (status == GetNextResult::ReturnStatus::kAdvanced) {
+        batch.clear();
+        status = pSource->getNextBatch(&batch, batchSize);
+
+        computeIds(batch, &ids);
+        for (size_t i = 0; i < numAccumulators; i++) {
+            _accumulatedFields[i].expression->evaluateBatch(batch, &args[i]);
         }
 
-        /* tickle all the accumulators for the group we found */
-        dassert(numAccumulators == group.size());
+        // We release the input documents here so that they do not outlive the evaluation of the
+        // batch. Holding on to them could lead to an array copy when this group follows an unwind.
+        const size_t numDocs = batch.size();
+        batch.clear();
+
+        for (size_t row = 0; row < numDocs; row++) {
+            if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+                uassert(16945,
+                        "Exceeded memory limit for $group, but didn't allow external sort."
+                        " Pass allowDiskUse:true to opt in.",
+                        _allowDiskUse);
+                _sortedFiles.push_back(spill());
+                _memoryUsageBytes = 0;
+            }
 
-        for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(_accumulatedFields[i].expression->evaluate(rootDocument),
-                              _doingMerge);
+            const bool inserted = _groupTable ? processInGroupTable(ids[row], args, row)
+                                              : processInGroupsMap(ids[row], args, row);
 
-            _memoryUsageBytes += group[i]->memUsageForSorter();
-        }
+            if (kDebugBuild && !storageGlobalParams.readOnly) {
+                // In debug mode, spill every time we have a duplicate id to stress merge logic.
+                if (!inserted &&                 // is a dup
+                    !pExpCtx->inMongos &&        // can't spill to disk in mongos
+                    !_allowDiskUse &&            // don't change behavior when testing external sort
+                    _sortedFiles.size() < 20) {  // don't open too many FDs
 
-        if (kDebugBuild && !storageGlobalParams.readOnly) {
-            // In debug mode, spill every time we have a duplicate id to stress merge logic.
-            if (!inserted &&                 // is a dup
-                !pExpCtx->inMongos &&        // can't spill to disk in mongos
-                !_allowDiskUse &&            // don't change behavior when testing external sort
-                _sortedFiles.size() < 20) {  // don't open too many FDs
-
-                _sortedFiles.push_back(spill());
+                    _sortedFiles.push_back(spill());
+                }
             }
         }
     }
 
-    switch (input.getStatus()) {
+    switch (status) {
         case DocumentSource::GetNextResult::ReturnStatus::kAdvanced: {
             MONGO_UNREACHABLE;  // We consumed all advances above.
         }
         case DocumentSource::GetNextResult::ReturnStatus::kPauseExecution: {
-            return input;  // Propagate pause.
+            return GetNextResult::makePauseExecution();  // Propagate pause.
         }
         case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
             // Do any final steps necessary to prepare to output results.
             if (!_sortedFiles.empty()) {
                 _spilled = true;
-                if (!_groups->empty()) {
+                if (hasGroups()) {
                     _sortedFiles.push_back(spill());
                 }
 
                 // We won't be using groups again so free its memory.
                 _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+                _groupTable = boost::none;
 
                 _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
                     _sortedFiles, SortOptions(), SorterComparator(pExpCtx->getValueComparator())));
@@ -571,18 +595,77 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
             } else {
                 // start the group iterator
                 groupsIterator = _groups->begin();
+                _groupTableOutputPos = 0;
             }
 
             // This must happen last so that, unless control gets here, we will re-enter
             // initialization after getting a GetNextResult::ResultState::kPauseExecution.
             _initialized = true;
-            return input;
+            return GetNextResult::makeEOF();
         }
     }
     MONGO_UNREACHABLE;
 }
 
+bool DocumentSourceGroup::processInGroupTable(const Value& id,
+                                              const vector<vector<Value>>& args,
+                                              size_t row) {
+    bool inserted;
+    const size_t group = _groupTable->findOrInsert(id, &inserted);
+
+    for (size_t i = 0; i < _accumulatedFields.size(); i++) {
+        _groupTable->process(group, i, args[i][row], _doingMerge);
+    }
+
+    _memoryUsageBytes = _groupTable->memoryUsageBytes();
+    return inserted;
+}
+
+bool DocumentSourceGroup::processInGroupsMap(const Value& id,
+                                             const vector<vector<Value>>& args,
+                                             size_t row) {
+    const size_t numAccumulators = _accumulatedFields.size();
+
+    // Look for the _id value in the map. If it's not there, add a new entry with a blank
+    // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
+    // looking it up in '_groups' multiple times.
+    const size_t oldSize = _groups->size();
+    vector<intrusive_ptr<Accumulator>>& group = (*_groups)[id];
+    const bool inserted = _groups->size() != oldSize;
+
+    if (inserted) {
+        _memoryUsageBytes += id.getApproximateSize();
+        _memoryUsageBytes += groupsMapEntryOverheadBytes(numAccumulators);
+
+        // Add the accumulators
+        group.reserve(numAccumulators);
+        for (auto&& accumulatedField : _accumulatedFields) {
+            group.push_back(accumulatedField.makeAccumulator(pExpCtx));
+        }
+    } else {
+        for (auto&& groupObj : group) {
+            // subtract old mem usage. New usage added back after processing.
+            _memoryUsageBytes -= groupObj->memUsageForSorter();
+        }
+    }
+
+    /* tickle all the accumulators for the group we found */
+    dassert(numAccumulators == group.size());
+
+    for (size_t i = 0; i < numAccumulators; i++) {
+        group[i]->process(args[i][row], _doingMerge);
+
+        _memoryUsageBytes += group[i]->memUsageForSorter();
+    }
+
+    return inserted;
+}
+
 shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
+    if (_groupTable) {
+        return spillGroupTable();
+    }
+
     vector<const GroupsMap::value_type*> ptrs;  // using pointers to speed sorting
     ptrs.reserve(_groups->size());
     for (GroupsMap::const_iterator it = _groups->begin(), end = _groups->end(); it != end; ++it) {
@@ -622,6 +705,45 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     return shared_ptr<Sorter<Value, Value>::Iterator>(writer.done());
 }
 
+shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spillGroupTable() {
+    vector<size_t> groups(_groupTable->size());
+    std::iota(groups.begin(), groups.end(), 0);
+
+    const ValueComparator& valueComparator = pExpCtx->getValueComparator();
+    const GroupTable& table = *_groupTable;
+    std::stable_sort(groups.begin(), groups.end(), [&](size_t lhs, size_t rhs) {
+        return valueComparator.evaluate(table.getKey(lhs) < table.getKey(rhs));
+    });
+
+    // Uses the same format as spill() so that both can be merged by getNextSpilled().
+    const size_t numAccumulators = _accumulatedFields.size();
+    SortedFileWriter<Value, Value> writer(SortOptions().TempDir(pExpCtx->tempDir));
+    for (size_t group : groups) {
+        switch (numAccumulators) {
+            case 0:
+                writer.addAlreadySorted(table.getKey(group), Value());
+                break;
+            case 1:
+                writer.addAlreadySorted(table.getKey(group),
+                                        table.getValue(group, 0, /*toBeMerged=*/true));
+                break;
+            default: {
+                vector<Value> accums;
+                accums.reserve(numAccumulators);
+                for (size_t i = 0; i < numAccumulators; i++) {
+                    accums.push_back(table.getValue(group, i, /*toBeMerged=*/true));
+                }
+                writer.addAlreadySorted(table.getKey(group), Value(std::move(accums)));
+                break;
+            }
+        }
+    }
+
+    _groupTable->clear();
+
+    return shared_ptr<Sorter<Value, Value>::Iterator>(writer.done());
+}
+
 boost::optional<BSONObj> DocumentSourceGroup::findRelevantInputSort() const {
     if (true) {
         // Until streaming $group correctly handles nullish values, the streaming behavior is
@@ -786,6 +908,34 @@ Value DocumentSourceGroup::computeId(const Document& root) {
     return Value(std::move(vals));
 }
 
+void DocumentSourceGroup::computeIds(const vector<Document>& roots, vector<Value>* ids) {
+    if (_idExpressions.size() == 1) {
+        _idExpressions[0]->evaluateBatch(roots, ids);
+        for (auto&& id : *ids) {
+            if (id.missing()) {
+                id = Value(BSONNULL);
+            }
+        }
+        return;
+    }
+
+    vector<vector<Value>> columns(_idExpressions.size());
+    for (size_t i = 0; i < _idExpressions.size(); i++) {
+        _idExpressions[i]->evaluateBatch(roots, &columns[i]);
+    }
+
+    ids->clear();
+    ids->reserve(roots.size());
+    for (size_t row = 0; row < roots.size(); row++) {
+        vector<Value> vals;
+        vals.reserve(columns.size());
+        for (auto&& column : columns) {
+            vals.push_back(std::move(column[row]));
+        }
+        ids->push_back(Value(std::move(vals)));
+    }
+}
+
 Value DocumentSourceGroup::expandId(const Value& val) {
     // _id doesn't get wrapped in a document
     if (_idFieldNames.empty())
@@ -828,6 +978,21 @@ Document DocumentSourceGroup::makeDocument(const Value& id,
     return out.freeze();
 }
 
+Document DocumentSourceGroup::makeDocument(size_t group, bool mergeableOutput) {
+    const size_t n = _accumulatedFields.size();
+    MutableDocument out(1 + n);
+
+    out.addField("_id", expandId(_groupTable->getKey(group)));
+
+    for (size_t i = 0; i < n; ++i) {
+        Value val = _groupTable->getValue(group, i, mergeableOutput);
+        // Like the overload above, output null rather than missing.
+        out.addField(_accumulatedFields[i].fieldName, val.missing() ? Value(BSONNULL) : val);
+    }
+
+    return out.freeze();
+}
+
 intrusive_ptr<DocumentSource> DocumentSourceGroup::getShardSource() {
     return this;  // No modifications necessary when on shard
 }
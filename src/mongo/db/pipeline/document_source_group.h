@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/group_table.h"
 #include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
@@ -143,14 +144,38 @@ private:
      * store of documents at any one time, only an unsorted group can spill to disk.
      */
     std::shared_ptr<Sorter<Value, Value>::Iterator> spill();
+    std::shared_ptr<Sorter<Value, Value>::Iterator> spillGroupTable();
 
     Document makeDocument(const Value& id, const Accumulators& accums, bool mergeableOutput);
+    Document makeDocument(size_t group, bool mergeableOutput);
+
+    /**
+     * Adds the input document at 'row' of a batch to its group 'id' in '_groupTable' or '_groups'
+     * and updates '_memoryUsageBytes'. The argument of accumulator i is args[i][row]. Returns
+     * true if a new group was created.
+     */
+    bool processInGroupTable(const Value& id,
+                             const std::vector<std::vector<Value>>& args,
+                             size_t row);
+    bool processInGroupsMap(const Value& id,
+                            const std::vector<std::vector<Value>>& args,
+                            size_t row);
+
+    bool hasGroups() const {
+        return _groupTable ? !_groupTable->empty() : !_groups->empty();
+    }
 
     /**
      * Computes the internal representation of the group key.
      */
     Value computeId(const Document& root);
 
+    /**
+     * Replaces the contents of 'ids' with the internal representations of the group keys of the
+     * documents in 'roots', as computeId() would compute them.
+     */
+    void computeIds(const std::vector<Document>& roots, std::vector<Value>* ids);
+
     /**
      * Converts the internal representation of the group key to the _id shape specified by the
      * user.
@@ -177,6 +202,11 @@ private:
     // definition of equality.
     boost::optional<GroupsMap> _groups;
 
+    // Used instead of '_groups' by an unsorted $group whose accumulators all keep fixed-size state.
+    // Created by initialize().
+    boost::optional<GroupTable> _groupTable;
+    size_t _groupTableOutputPos = 0;
+
     std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> _sortedFiles;
     bool _spilled;
 
@@ -47,12 +47,14 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -189,6 +191,124 @@ TEST_F(DocumentSourceGroupTest, ShouldCorrectlyTrackMemoryUsageBetweenPauses) {
     ASSERT_THROWS_CODE(group->getNext(), AssertionException, 16945);
 }
 
+TEST_F(DocumentSourceGroupTest, CompactGroupsShouldProduceSameResultsWhenSpilled) {
+    auto expCtx = getExpCtx();
+
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+
+    // Every accumulator keeps fixed-size state, so the groups are kept in a GroupTable.
+    VariablesParseState vps = expCtx->variablesParseState;
+    auto valueExpression = ExpressionFieldPath::parse(expCtx, "$v", vps);
+    std::vector<AccumulationStatement> statements;
+    for (auto&& op : {"$sum", "$avg", "$min", "$max", "$first", "$last"}) {
+        statements.emplace_back(StringData(op).substr(1).toString(),
+                                valueExpression,
+                                AccumulationStatement::getFactory(op));
+    }
+
+    const int numGroups = 500;
+    const int docsPerGroup = 4;
+    deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < numGroups * docsPerGroup; ++i) {
+        inputs.emplace_back(Document{{"k", i % numGroups}, {"v", i}});
+    }
+
+    // Run once without and once with spilling.
+    for (size_t maxMemoryUsageBytes : {size_t(100 * 1024 * 1024), size_t(4 * 1024)}) {
+        auto group = DocumentSourceGroup::create(expCtx,
+                                                 ExpressionFieldPath::parse(expCtx, "$k", vps),
+                                                 statements,
+                                                 maxMemoryUsageBytes);
+        auto mock = DocumentSourceMock::create(inputs);
+        group->setSource(mock.get());
+
+        stdx::unordered_set<int> seen;
+        for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+            auto doc = result.releaseDocument();
+            const int k = doc["_id"].coerceToInt();
+            const int last = k + (docsPerGroup - 1) * numGroups;
+            ASSERT_VALUE_EQ(doc["sum"], Value((k + last) * docsPerGroup / 2));
+            ASSERT_VALUE_EQ(doc["avg"], Value((k + last) / 2.0));
+            ASSERT_VALUE_EQ(doc["min"], Value(k));
+            ASSERT_VALUE_EQ(doc["max"], Value(last));
+            ASSERT_VALUE_EQ(doc["first"], Value(k));
+            ASSERT_VALUE_EQ(doc["last"], Value(last));
+            ASSERT_TRUE(seen.insert(k).second);
+        }
+        ASSERT_EQ(seen.size(), size_t(numGroups));
+        ASSERT_TRUE(group->getNext().isEOF());
+    }
+}
+
+TEST_F(DocumentSourceGroupTest, CompactGroupsShouldCountMemoryOfValuesTheyHold) {
+    auto expCtx = getExpCtx();
+    const size_t maxMemoryUsageBytes = 1000;
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+
+    VariablesParseState vps = expCtx->variablesParseState;
+    AccumulationStatement maxStatement{"spaceHog",
+                                       ExpressionFieldPath::parse(expCtx, "$largeStr", vps),
+                                       AccumulationStatement::getFactory("$max")};
+    auto groupByExpression = ExpressionFieldPath::parse(expCtx, "$_id", vps);
+    auto group = DocumentSourceGroup::create(
+        expCtx, groupByExpression, {maxStatement}, maxMemoryUsageBytes);
+
+    string largeStr(maxMemoryUsageBytes, 'x');
+    auto mock = DocumentSourceMock::create({Document{{"_id", 0}, {"largeStr", largeStr}},
+                                            Document{{"_id", 1}, {"largeStr", largeStr}}});
+    group->setSource(mock.get());
+
+    ASSERT_THROWS_CODE(group->getNext(), AssertionException, 16945);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldProduceSameResultsForAnyBatchSize) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+
+    // The input is paused now and then, which ends a batch early.
+    deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 100; ++i) {
+        if (i % 7 == 0) {
+            inputs.emplace_back(DocumentSource::GetNextResult::makePauseExecution());
+        }
+        inputs.emplace_back(i % 5 == 0 ? Document{{"k", i % 3}}
+                                       : Document{{"k", i % 3}, {"p", i % 2}, {"v", i}});
+    }
+
+    const int originalBatchSize = internalDocumentSourceGroupBatchSize.load();
+    ON_BLOCK_EXIT([&] { internalDocumentSourceGroupBatchSize.store(originalBatchSize); });
+
+    const BSONObj spec = fromjson(
+        "{$group: {_id: {k: '$k', p: '$p'}, total: {$sum: {$add: ['$v', 1]}}, "
+        "big: {$sum: {$cond: [{$gt: ['$v', 50]}, 1, 0]}}}}");
+    std::map<std::string, Document> expected;
+    for (int batchSize : {1, 3, 128}) {
+        internalDocumentSourceGroupBatchSize.store(batchSize);
+        auto group = DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+        auto mock = DocumentSourceMock::create(inputs);
+        group->setSource(mock.get());
+
+        std::map<std::string, Document> results;
+        for (auto result = group->getNext(); !result.isEOF(); result = group->getNext()) {
+            if (result.isAdvanced()) {
+                auto doc = result.releaseDocument();
+                results[doc["_id"].toString()] = doc;
+            }
+        }
+        ASSERT_EQ(results.size(), 9UL);
+        if (expected.empty()) {
+            expected = results;
+        }
+        for (auto&& entry : expected) {
+            ASSERT_DOCUMENT_EQ(results[entry.first], entry.second);
+        }
+    }
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
@@ -40,6 +40,7 @@
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/stringutils.h"
 
 namespace mongo {
 
@@ -95,6 +96,12 @@ DocumentSourceLookUp::DocumentSourceLookUp(NamespaceString fromNs,
     : DocumentSourceLookUp(fromNs, as, pExpCtx) {
     _localField = std::move(localField);
     _foreignField = std::move(foreignField);
+    _foreignFieldIsHashable = true;
+    for (size_t i = 0; i < _foreignField->getPathLength(); ++i) {
+        if (parseUnsignedBase10Integer(_foreignField->getFieldName(i))) {
+            _foreignFieldIsHashable = false;
+        }
+    }
     // We append an additional BSONObj to '_resolvedPipeline' as a placeholder for the $match stage
     // we'll eventually construct from the input document.
     _resolvedPipeline.reserve(_resolvedPipeline.size() + 1);
@@ -201,6 +208,24 @@ BSONObj buildEqualityOrQuery(const std::string& fieldName, const BSONArray& valu
     return orBuilder.obj();
 }
 
+/**
+ * Returns true if an equality predicate on 'value' matches exactly the foreign documents having
+ * 'value' among the values found along the foreign path. This does not hold for null (which also
+ * matches missing fields), for arrays (which also match the whole array) or for regexes.
+ */
+bool isHashJoinable(const Value& value) {
+    switch (value.getType()) {
+        case BSONType::jstNULL:
+        case BSONType::Undefined:
+        case BSONType::EOO:
+        case BSONType::Array:
+        case BSONType::RegEx:
+            return false;
+        default:
+            return true;
+    }
+}
+
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
@@ -210,17 +235,23 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
         return unwindResult();
     }
 
+    // If we have not absorbed a $unwind, we cannot absorb a $match. If we have absorbed a $unwind,
+    // '_unwindSrc' would be non-null, and we would not have made it here.
+    invariant(!_matchSrc);
+
+    if (canBatchJoin()) {
+        return batchJoinResult();
+    }
+
     auto nextInput = pSource->getNext();
     if (!nextInput.isAdvanced()) {
         return nextInput;
     }
 
-    auto inputDoc = nextInput.releaseDocument();
-
-    // If we have not absorbed a $unwind, we cannot absorb a $match. If we have absorbed a $unwind,
-    // '_unwindSrc' would be non-null, and we would not have made it here.
-    invariant(!_matchSrc);
+    return lookUpSingleInput(nextInput.releaseDocument());
+}
 
+Document DocumentSourceLookUp::lookUpSingleInput(Document inputDoc) {
     if (!wasConstructedWithPipelineSyntax()) {
         auto matchStage =
             makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
@@ -249,6 +280,146 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
     return output.freeze();
 }
 
+bool DocumentSourceLookUp::canBatchJoin() const {
+    // Keep draining a batch that was started before batching was disabled.
+    if (!_batchOutput.empty() || _batchStopResult) {
+        return true;
+    }
+    return !wasConstructedWithPipelineSyntax() && _foreignFieldIsHashable && !_batchingAbandoned &&
+        internalDocumentSourceLookupBatchSize.load() > 1;
+}
+
+DocumentSource::GetNextResult DocumentSourceLookUp::batchJoinResult() {
+    if (_batchOutput.empty() && !_batchStopResult) {
+        fillJoinBatch();
+    }
+
+    if (!_batchOutput.empty()) {
+        auto next = std::move(_batchOutput.front());
+        _batchOutput.pop_front();
+        return std::move(next);
+    }
+
+    invariant(_batchStopResult);
+    auto stopResult = std::move(*_batchStopResult);
+    _batchStopResult = boost::none;
+    return stopResult;
+}
+
+void DocumentSourceLookUp::fillJoinBatch() {
+    // Start with small batches so that a $limit later in the pipeline does not cause us to join
+    // many documents that will never be returned.
+    const size_t maxBatchSize = std::max(internalDocumentSourceLookupBatchSize.load(), 1);
+    const size_t batchSize = std::min(_nextBatchSize, maxBatchSize);
+    _nextBatchSize = std::min(_nextBatchSize * 2, maxBatchSize);
+
+    std::vector<Document> inputs;
+    inputs.reserve(batchSize);
+    while (inputs.size() < batchSize) {
+        auto nextInput = pSource->getNext();
+        if (!nextInput.isAdvanced()) {
+            _batchStopResult = std::move(nextInput);
+            break;
+        }
+        inputs.push_back(nextInput.releaseDocument());
+    }
+
+    // Map every distinct join key to the inputs that contain it. Inputs with a key that the hash
+    // join cannot handle are looked up individually.
+    auto inputsByKey = pExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>();
+    std::vector<bool> isBatched(inputs.size(), false);
+    BSONArrayBuilder keys;
+    std::vector<Value> inputKeys;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        inputKeys.clear();
+        bool hashable = true;
+        document_path_support::visitAllValuesAtPath(
+            inputs[i], *_localField, [&](const Value& nextValue) {
+                hashable = hashable && isHashJoinable(nextValue);
+                inputKeys.push_back(nextValue);
+            });
+        if (!hashable || inputKeys.empty()) {
+            continue;
+        }
+
+        isBatched[i] = true;
+        for (auto&& key : inputKeys) {
+            auto& keyInputs = inputsByKey[key];
+            if (keyInputs.empty()) {
+                keys << key;
+            }
+            if (keyInputs.empty() || keyInputs.back() != i) {
+                keyInputs.push_back(i);
+            }
+        }
+    }
+
+    std::vector<std::vector<Value>> results(inputs.size());
+    if (!inputsByKey.empty()) {
+        BSONObjBuilder match;
+        {
+            BSONObjBuilder query(match.subobjStart("$match"));
+            BSONObjBuilder inObj(query.subobjStart(_foreignField->fullPath()));
+            inObj.append("$in", keys.arr());
+        }
+        // We've already allocated space for the trailing $match stage in '_resolvedPipeline'.
+        _resolvedPipeline.back() = match.obj();
+
+        auto pipeline = buildPipeline(Document());
+
+        std::vector<int> objsizes(inputs.size(), 0);
+        // Used to add a foreign document only once to an input which has several matching keys.
+        std::vector<size_t> lastJoined(inputs.size(), std::numeric_limits<size_t>::max());
+        size_t foreignIndex = 0;
+        long long batchBytes = 0;
+        while (auto result = pipeline->getNext()) {
+            const auto resultSize = result->getApproximateSize();
+            batchBytes += resultSize;
+            if (batchBytes > internalDocumentSourceLookupCacheSizeBytes.load()) {
+                // Too much matching data to join in memory. Finish this batch and the rest of the
+                // input one document at a time.
+                _batchingAbandoned = true;
+                std::fill(isBatched.begin(), isBatched.end(), false);
+                break;
+            }
+
+            const Value resultValue(*result);
+            document_path_support::visitAllValuesAtPath(
+                *result, *_foreignField, [&](const Value& foreignValue) {
+                    auto it = inputsByKey.find(foreignValue);
+                    if (it == inputsByKey.end()) {
+                        return;
+                    }
+                    for (auto i : it->second) {
+                        if (lastJoined[i] == foreignIndex) {
+                            continue;
+                        }
+                        lastJoined[i] = foreignIndex;
+                        objsizes[i] += resultSize;
+                        uassert(4568,
+                                str::stream() << "Total size of documents in " << _fromNs.coll()
+                                              << " matching pipeline "
+                                              << getUserPipelineDefinition()
+                                              << " exceeds maximum document size",
+                                objsizes[i] <= BSONObjMaxInternalSize);
+                        results[i].push_back(resultValue);
+                    }
+                });
+            ++foreignIndex;
+        }
+    }
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (!isBatched[i]) {
+            _batchOutput.push_back(lookUpSingleInput(std::move(inputs[i])));
+            continue;
+        }
+        MutableDocument output(std::move(inputs[i]));
+        output.setNestedField(_as, Value(std::move(results[i])));
+        _batchOutput.push_back(output.freeze());
+    }
+}
+
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
     const Document& inputDoc) {
     // Copy all 'let' variables into the foreign pipeline's expression context.
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_match.h"
@@ -244,6 +245,25 @@ private:
 
     GetNextResult unwindResult();
 
+    /**
+     * Returns true if this stage may join several input documents with one query against the
+     * foreign collection. Only localField/foreignField lookups qualify.
+     */
+    bool canBatchJoin() const;
+
+    /**
+     * getNext() for the batched join: reads a batch of input documents, fetches the foreign
+     * documents matching any of their join keys with a single $in query, and hash-joins them in
+     * memory.
+     */
+    GetNextResult batchJoinResult();
+    void fillJoinBatch();
+
+    /**
+     * Joins a single input document by running the foreign pipeline for it.
+     */
+    Document lookUpSingleInput(Document inputDoc);
+
     /**
      * Copies 'vars' and 'vps' to the Variables and VariablesParseState objects in 'expCtx'. These
      * copies provide access to 'let' defined variables in sub-pipeline execution.
@@ -295,6 +315,17 @@ private:
     boost::optional<FieldPath> _localField;
     boost::optional<FieldPath> _foreignField;
 
+    // State of the batched join. '_batchOutput' holds joined documents not yet returned, and
+    // '_batchStopResult' the EOF or pause which ended the current batch. Batching is abandoned for
+    // the rest of the stage if a batch matches too much foreign data to hold in memory.
+    std::deque<Document> _batchOutput;
+    boost::optional<GetNextResult> _batchStopResult;
+    size_t _nextBatchSize = 8;
+    bool _batchingAbandoned = false;
+    // False if 'foreignField' has a component that may be a positional array index, which the
+    // in-memory join cannot evaluate like the query system does.
+    bool _foreignFieldIsHashable = false;
+
     // Holds 'let' defined variables defined both in this stage and in parent pipelines. These are
     // copied to the '_fromExpCtx' ExpressionContext's 'variables' and 'variablesParseState' for use
     // in foreign pipeline execution.
@@ -588,6 +588,57 @@ TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
     lookup->dispose();
 }
 
+TEST_F(DocumentSourceLookUpTest, ShouldJoinBatchOfInputsWithSameResultsAsPerDocumentLookup) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespace_forTest(fromNs, {fromNs, std::vector<BSONObj>{}});
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "x"_sd},
+                                         {"foreignField", "y"_sd},
+                                         {"as", "joined"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    // The input with a missing 'x' cannot be hash joined and is looked up on its own.
+    auto mockLocalSource =
+        DocumentSourceMock::create({Document{{"_id", 0}, {"x", 1}},
+                                    Document{{"_id", 1}, {"x", 2.0}},
+                                    Document{{"_id", 2}},
+                                    Document{{"_id", 3}, {"x", BSON_ARRAY(1 << 3)}},
+                                    Document{{"_id", 4}, {"x", 1}}});
+    lookup->setSource(mockLocalSource.get());
+
+    const Document a{{"_id", "a"_sd}, {"y", 1}};
+    const Document b{{"_id", "b"_sd}, {"y", BSON_ARRAY(2 << 3)}};
+    const Document c{{"_id", "c"_sd}, {"y", 4}};
+    const Document d{{"_id", "d"_sd}, {"y", BSONNULL}};
+    deque<DocumentSource::GetNextResult> mockForeignContents{
+        Document(a), Document(b), Document(c), Document(d)};
+    expCtx->mongoProcessInterface =
+        std::make_shared<MockMongoInterface>(std::move(mockForeignContents));
+
+    auto assertJoined = [&](Document input, std::vector<Value> joined) {
+        auto next = lookup->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        MutableDocument expected(std::move(input));
+        expected.addField("joined", Value(std::move(joined)));
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(), expected.freeze());
+    };
+
+    assertJoined(Document{{"_id", 0}, {"x", 1}}, {Value(a)});
+    assertJoined(Document{{"_id", 1}, {"x", 2.0}}, {Value(b)});
+    assertJoined(Document{{"_id", 2}}, {Value(d)});
+    assertJoined(Document{{"_id", 3}, {"x", BSON_ARRAY(1 << 3)}}, {Value(a), Value(b)});
+    assertJoined(Document{{"_id", 4}, {"x", 1}}, {Value(a)});
+
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    lookup->dispose();
+}
+
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePausesWhileUnwinding) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "foreign");
@@ -58,6 +58,12 @@ DocumentSource::GetNextResult DocumentSourceTeeConsumer::getNext() {
     return _bufferSource->getNext(_facetId);
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceTeeConsumer::getNextBatch(
+    std::vector<Document>* batch, size_t maxDocs) {
+    pExpCtx->checkForInterrupt();
+    return _bufferSource->getNextBatch(_facetId, batch, maxDocs);
+}
+
 void DocumentSourceTeeConsumer::doDispose() {
     _bufferSource->dispose(_facetId);
 }
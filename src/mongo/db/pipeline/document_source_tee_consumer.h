@@ -63,6 +63,7 @@ public:
     }
 
     GetNextResult getNext() final;
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch, size_t maxDocs) final;
 
     /**
      * Returns SEE_NEXT, since it requires no fields, and changes nothing about the documents.
@@ -206,6 +206,11 @@ DocumentSource::GetNextResult DocumentSourceUnwind::getNext() {
     return nextOut;
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceUnwind::getNextBatch(
+    std::vector<Document>* batch, size_t maxDocs) {
+    return DocumentSource::getNextBatch(batch, std::min<size_t>(maxDocs, 1));
+}
+
 BSONObjSet DocumentSourceUnwind::getOutputSorts() {
     BSONObjSet out = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
     std::string unwoundPath = getUnwindPath();
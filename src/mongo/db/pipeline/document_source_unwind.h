@@ -37,6 +37,12 @@ class DocumentSourceUnwind final : public DocumentSource {
 public:
     // virtuals from DocumentSource
     GetNextResult getNext() final;
+
+    /**
+     * Returns one document at a time: the next document is built in place of the previous one,
+     * which would have to be copied if the consumer still held it.
+     */
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch, size_t maxDocs) final;
     const char* getSourceName() const final;
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
     BSONObjSet getOutputSorts() final;
@@ -33,7 +33,9 @@
 
 #include <algorithm>
 #include <boost/algorithm/string.hpp>
+#include <cmath>
 #include <cstdio>
+#include <numeric>
 #include <vector>
 
 #include "mongo/db/commands/feature_compatibility_version_documentation.h"
@@ -88,6 +90,135 @@ string Expression::removeFieldPrefix(const string& prefixedField) {
     return string(pPrefixedField + 1);
 }
 
+void Expression::evaluateBatch(const vector<Document>& roots, vector<Value>* out) const {
+    out->clear();
+    out->reserve(roots.size());
+    for (auto&& root : roots) {
+        out->push_back(evaluate(root));
+    }
+}
+
+namespace {
+/**
+ * Evaluates 'expr' with respect to roots[i] for each row i in 'rows', which must be increasing, and
+ * stores the result in (*out)[i]. The entries of 'out' for the other rows are left untouched.
+ */
+void evaluateBatchRows(const Expression& expr,
+                       const vector<Document>& roots,
+                       const vector<size_t>& rows,
+                       vector<Value>* out) {
+    dassert(out->size() == roots.size());
+    if (rows.size() == roots.size()) {
+        expr.evaluateBatch(roots, out);
+        return;
+    }
+
+    vector<Document> subset;
+    subset.reserve(rows.size());
+    for (size_t row : rows) {
+        subset.push_back(roots[row]);
+    }
+
+    vector<Value> results;
+    expr.evaluateBatch(subset, &results);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        (*out)[rows[i]] = std::move(results[i]);
+    }
+}
+
+/**
+ * Evaluates the operands of a variadic arithmetic expression column by column, storing the value
+ * of operand i for row r in (*columns)[i][r]. Like evaluate(), which stops at the first null or
+ * missing operand, each operand is only evaluated for the rows whose earlier operands were all
+ * accepted by 'checkOperand'. It returns false for a null or missing value, making the row's
+ * result null, and throws for a value the expression does not support.
+ *
+ * Returns the rows whose operands were all accepted. The entries of 'out' for the other rows are
+ * set to null.
+ */
+template <typename CheckOperand>
+vector<size_t> evaluateOperandColumns(const vector<intrusive_ptr<Expression>>& operands,
+                                      const vector<Document>& roots,
+                                      CheckOperand checkOperand,
+                                      vector<vector<Value>>* columns,
+                                      vector<Value>* out) {
+    const size_t numRows = roots.size();
+    out->assign(numRows, Value(BSONNULL));
+    columns->assign(operands.size(), vector<Value>(numRows));
+
+    vector<size_t> rows(numRows);
+    std::iota(rows.begin(), rows.end(), 0);
+    for (size_t i = 0; i < operands.size() && !rows.empty(); ++i) {
+        vector<Value>& column = (*columns)[i];
+        evaluateBatchRows(*operands[i], roots, rows, &column);
+
+        size_t numAccepted = 0;
+        for (size_t row : rows) {
+            if (checkOperand(column[row])) {
+                rows[numAccepted++] = row;
+            }
+        }
+        rows.resize(numAccepted);
+    }
+    return rows;
+}
+
+/**
+ * Returns true if operand value of every row in 'rows' of every column in 'columns' has BSON type
+ * 'type'.
+ */
+bool allOfType(const vector<vector<Value>>& columns, const vector<size_t>& rows, BSONType type) {
+    for (auto&& column : columns) {
+        for (size_t row : rows) {
+            if (column[row].getType() != type) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Unboxes the values of 'column' at 'rows' into 'values', which is resized to match, using
+ * 'unbox'. The arithmetic kernels then work on contiguous arrays of machine numbers, in loops the
+ * compiler can vectorize.
+ */
+template <typename T, typename Unbox>
+void unboxColumn(const vector<Value>& column,
+                 const vector<size_t>& rows,
+                 Unbox unbox,
+                 vector<T>* values) {
+    values->resize(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        (*values)[i] = unbox(column[rows[i]]);
+    }
+}
+
+/**
+ * Computes op(lhs[row], rhs[row]) for each row in 'rows' on the unboxed operand values and stores
+ * the boxed result in (*out)[row].
+ */
+template <typename T, typename Unbox, typename Op, typename Box>
+void binaryKernel(const vector<Value>& lhs,
+                  const vector<Value>& rhs,
+                  const vector<size_t>& rows,
+                  Unbox unbox,
+                  Op op,
+                  Box box,
+                  vector<Value>* out) {
+    vector<T> left;
+    vector<T> right;
+    unboxColumn(lhs, rows, unbox, &left);
+    unboxColumn(rhs, rows, unbox, &right);
+    for (size_t i = 0; i < left.size(); ++i) {
+        left[i] = op(left[i], right[i]);
+    }
+    for (size_t i = 0; i < rows.size(); ++i) {
+        (*out)[rows[i]] = box(left[i]);
+    }
+}
+}  // namespace
+
 intrusive_ptr<Expression> Expression::parseObject(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     BSONObj obj,
@@ -263,20 +394,20 @@ const char* ExpressionAbs::getOpName() const {
 
 /* ------------------------- ExpressionAdd ----------------------------- */
 
-Value ExpressionAdd::evaluate(const Document& root) const {
-    // We'll try to return the narrowest possible result value while avoiding overflow, loss
-    // of precision due to intermediate rounding or implicit use of decimal types. To do that,
-    // compute a compensated sum for non-decimal values and a separate decimal sum for decimal
-    // values, and track the current narrowest type.
-    DoubleDoubleSummation nonDecimalTotal;
-    Decimal128 decimalTotal;
-    BSONType totalType = NumberInt;
-    bool haveDate = false;
-
-    const size_t n = vpOperand.size();
-    for (size_t i = 0; i < n; ++i) {
-        Value val = vpOperand[i]->evaluate(root);
-
+namespace {
+/**
+ * Computes the result of $add from its operand values. We'll try to return the narrowest possible
+ * result value while avoiding overflow, loss of precision due to intermediate rounding or implicit
+ * use of decimal types. To do that, compute a compensated sum for non-decimal values and a separate
+ * decimal sum for decimal values, and track the current narrowest type.
+ */
+class AddState {
+public:
+    /**
+     * Adds the operand 'val'. Returns false if 'val' is null or missing, in which case the result
+     * of the $add is null whatever the other operands are.
+     */
+    bool add(const Value& val) {
         switch (val.getType()) {
             case NumberDecimal:
                 decimalTotal = decimalTotal.add(val.getDecimal());
@@ -301,40 +432,111 @@ Value ExpressionAdd::evaluate(const Document& root) const {
                 nonDecimalTotal.addLong(val.getDate().toMillisSinceEpoch());
                 break;
             default:
-                uassert(16554,
-                        str::stream() << "$add only supports numeric or date types, not "
-                                      << typeName(val.getType()),
-                        val.nullish());
-                return Value(BSONNULL);
+                return checkOperand(val);
         }
+        return true;
     }
 
-    if (haveDate) {
-        int64_t longTotal;
-        if (totalType == NumberDecimal) {
-            longTotal = decimalTotal.add(nonDecimalTotal.getDecimal()).toLong();
-        } else {
-            uassert(ErrorCodes::Overflow, "date overflow in $add", nonDecimalTotal.fitsLong());
-            longTotal = nonDecimalTotal.getLong();
+    /**
+     * Returns true if 'val' is a valid operand of $add, and false if it is null or missing. Throws
+     * for any other value.
+     */
+    static bool checkOperand(const Value& val) {
+        uassert(16554,
+                str::stream() << "$add only supports numeric or date types, not "
+                              << typeName(val.getType()),
+                val.numeric() || val.getType() == Date || val.nullish());
+        return !val.nullish();
+    }
+
+    Value getValue() const {
+        if (haveDate) {
+            int64_t longTotal;
+            if (totalType == NumberDecimal) {
+                longTotal = decimalTotal.add(nonDecimalTotal.getDecimal()).toLong();
+            } else {
+                uassert(ErrorCodes::Overflow, "date overflow in $add", nonDecimalTotal.fitsLong());
+                longTotal = nonDecimalTotal.getLong();
+            }
+            return Value(Date_t::fromMillisSinceEpoch(longTotal));
+        }
+        switch (totalType) {
+            case NumberDecimal:
+                return Value(decimalTotal.add(nonDecimalTotal.getDecimal()));
+            case NumberLong:
+                dassert(nonDecimalTotal.isInteger());
+                if (nonDecimalTotal.fitsLong())
+                    return Value(nonDecimalTotal.getLong());
+            // Fallthrough.
+            case NumberInt:
+                if (nonDecimalTotal.fitsLong())
+                    return Value::createIntOrLong(nonDecimalTotal.getLong());
+            // Fallthrough.
+            case NumberDouble:
+                return Value(nonDecimalTotal.getDouble());
+            default:
+                massert(16417, "$add resulted in a non-numeric type", false);
         }
-        return Value(Date_t::fromMillisSinceEpoch(longTotal));
     }
-    switch (totalType) {
-        case NumberDecimal:
-            return Value(decimalTotal.add(nonDecimalTotal.getDecimal()));
-        case NumberLong:
-            dassert(nonDecimalTotal.isInteger());
-            if (nonDecimalTotal.fitsLong())
-                return Value(nonDecimalTotal.getLong());
-        // Fallthrough.
-        case NumberInt:
-            if (nonDecimalTotal.fitsLong())
-                return Value::createIntOrLong(nonDecimalTotal.getLong());
-        // Fallthrough.
-        case NumberDouble:
-            return Value(nonDecimalTotal.getDouble());
-        default:
-            massert(16417, "$add resulted in a non-numeric type", false);
+
+private:
+    DoubleDoubleSummation nonDecimalTotal;
+    Decimal128 decimalTotal;
+    BSONType totalType = NumberInt;
+    bool haveDate = false;
+};
+}  // namespace
+
+Value ExpressionAdd::evaluate(const Document& root) const {
+    AddState state;
+    for (auto&& operand : vpOperand) {
+        if (!state.add(operand->evaluate(root))) {
+            return Value(BSONNULL);
+        }
+    }
+    return state.getValue();
+}
+
+void ExpressionAdd::evaluateBatch(const vector<Document>& roots, vector<Value>* out) const {
+    vector<vector<Value>> columns;
+    const vector<size_t> rows =
+        evaluateOperandColumns(vpOperand, roots, AddState::checkOperand, &columns, out);
+
+    if (allOfType(columns, rows, NumberInt)) {
+        // Any number of ints adds up exactly in a long.
+        vector<long long> totals(rows.size(), 0);
+        vector<long long> operand;
+        for (auto&& column : columns) {
+            unboxColumn(column, rows, [](const Value& val) { return val.getInt(); }, &operand);
+            for (size_t i = 0; i < totals.size(); ++i) {
+                totals[i] += operand[i];
+            }
+        }
+        for (size_t i = 0; i < rows.size(); ++i) {
+            (*out)[rows[i]] = Value::createIntOrLong(totals[i]);
+        }
+        return;
+    }
+
+    if (columns.size() == 2 && allOfType(columns, rows, NumberDouble)) {
+        binaryKernel<double>(columns[0],
+                             columns[1],
+                             rows,
+                             [](const Value& val) { return val.getDouble(); },
+                             // Starting from 0.0, as the compensated sum does, makes -0.0 + -0.0
+                             // come out as 0.0.
+                             [](double lhs, double rhs) { return (0.0 + lhs) + rhs; },
+                             [](double sum) { return Value(sum); },
+                             out);
+        return;
+    }
+
+    for (size_t row : rows) {
+        AddState state;
+        for (auto&& column : columns) {
+            state.add(column[row]);
+        }
+        (*out)[row] = state.getValue();
     }
 }
 
@@ -807,14 +1009,11 @@ static const CmpLookup cmpLookup[7] = {
     // CMP is special. Only name is used.
     /* CMP */ {{false, false, false}, ExpressionCompare::CMP, "$cmp"},
 };
-}
-
-Value ExpressionCompare::evaluate(const Document& root) const {
-    Value pLeft(vpOperand[0]->evaluate(root));
-    Value pRight(vpOperand[1]->evaluate(root));
-
-    int cmp = getExpressionContext()->getValueComparator().compare(pLeft, pRight);
 
+/**
+ * Returns the result of the comparison 'cmpOp' given the result 'cmp' of comparing its operands.
+ */
+Value cmpResult(ExpressionCompare::CmpOp cmpOp, int cmp) {
     // Make cmp one of 1, 0, or -1.
     if (cmp == 0) {
         // leave as 0
@@ -824,13 +1023,55 @@ Value ExpressionCompare::evaluate(const Document& root) const {
         cmp = 1;
     }
 
-    if (cmpOp == CMP)
+    if (cmpOp == ExpressionCompare::CMP)
         return Value(cmp);
 
     bool returnValue = cmpLookup[cmpOp].truthValue[cmp + 1];
     return Value(returnValue);
 }
 
+bool isIntegral(BSONType type) {
+    return type == NumberInt || type == NumberLong;
+}
+}  // namespace
+
+Value ExpressionCompare::evaluate(const Document& root) const {
+    Value pLeft(vpOperand[0]->evaluate(root));
+    Value pRight(vpOperand[1]->evaluate(root));
+
+    return cmpResult(cmpOp, getExpressionContext()->getValueComparator().compare(pLeft, pRight));
+}
+
+void ExpressionCompare::evaluateBatch(const vector<Document>& roots, vector<Value>* out) const {
+    vector<Value> lhs;
+    vector<Value> rhs;
+    vpOperand[0]->evaluateBatch(roots, &lhs);
+    vpOperand[1]->evaluateBatch(roots, &rhs);
+
+    // Numbers compare the same under any collation, so pairs of integers and pairs of non-NaN
+    // doubles, the bulk of most numeric columns, are compared directly.
+    const auto& comparator = getExpressionContext()->getValueComparator();
+    out->resize(roots.size());
+    for (size_t i = 0; i < roots.size(); ++i) {
+        const BSONType lhsType = lhs[i].getType();
+        const BSONType rhsType = rhs[i].getType();
+        int cmp;
+        if (isIntegral(lhsType) && isIntegral(rhsType)) {
+            const long long left = lhs[i].coerceToLong();
+            const long long right = rhs[i].coerceToLong();
+            cmp = left < right ? -1 : (left > right ? 1 : 0);
+        } else if (lhsType == NumberDouble && rhsType == NumberDouble &&
+                   !std::isnan(lhs[i].getDouble()) && !std::isnan(rhs[i].getDouble())) {
+            const double left = lhs[i].getDouble();
+            const double right = rhs[i].getDouble();
+            cmp = left < right ? -1 : (left > right ? 1 : 0);
+        } else {
+            cmp = comparator.compare(lhs[i], rhs[i]);
+        }
+        (*out)[i] = cmpResult(cmpOp, cmp);
+    }
+}
+
 const char* ExpressionCompare::getOpName() const {
     return cmpLookup[cmpOp].name;
 }
@@ -897,6 +1138,26 @@ Value ExpressionCond::evaluate(const Document& root) const {
     return vpOperand[idx]->evaluate(root);
 }
 
+void ExpressionCond::evaluateBatch(const vector<Document>& roots, vector<Value>* out) const {
+    vector<Value> conds;
+    vpOperand[0]->evaluateBatch(roots, &conds);
+
+    // Each branch is only evaluated for the rows that take it.
+    vector<size_t> thenRows;
+    vector<size_t> elseRows;
+    for (size_t i = 0; i < conds.size(); ++i) {
+        (conds[i].coerceToBool() ? thenRows : elseRows).push_back(i);
+    }
+
+    out->assign(roots.size(), Value());
+    if (!thenRows.empty()) {
+        evaluateBatchRows(*vpOperand[1], roots, thenRows, out);
+    }
+    if (!elseRows.empty()) {
+        evaluateBatchRows(*vpOperand[2], roots, elseRows, out);
+    }
+}
+
 intrusive_ptr<Expression> ExpressionCond::parse(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     BSONElement expr,
@@ -969,6 +1230,10 @@ Value ExpressionConstant::evaluate(const Document& root) const {
     return _value;
 }
 
+void ExpressionConstant::evaluateBatch(const vector<Document>& roots, vector<Value>* out) const {
+    out->assign(roots.size(), _value);
+}
+
 Value ExpressionConstant::serialize(bool explain) const {
     return serializeConstant(_value);
 }
@@ -2092,6 +2357,27 @@ Value ExpressionFieldPath::evaluate(const Document& root) const {
     }
 }
 
+void ExpressionFieldPath::evaluateBatch(const vector<Document>& roots, vector<Value>* out) const {
+    if (_variable != Variables::kRootId || _fieldPath.getPathLength() == 1) {
+        Expression::evaluateBatch(roots, out);
+        return;
+    }
+
+    out->clear();
+    out->reserve(roots.size());
+    if (_fieldPath.getPathLength() == 2) {
+        // A top-level field, such as "$a", is a single lookup in each document.
+        const StringData fieldName = _fieldPath.getFieldName(1);
+        for (auto&& root : roots) {
+            out->push_back(root[fieldName]);
+        }
+        return;
+    }
+    for (auto&& root : roots) {
+        out->push_back(evaluatePath(1, root));
+    }
+}
+
 Value ExpressionFieldPath::serialize(bool explain) const {
     if (_fieldPath.getFieldName(0) == "CURRENT" && _fieldPath.getPathLength() > 1) {
         // use short form for "$$CURRENT.foo" but not just "$$CURRENT"
@@ -2597,60 +2883,125 @@ const char* ExpressionMod::getOpName() const {
 
 /* ------------------------- ExpressionMultiply ----------------------------- */
 
-Value ExpressionMultiply::evaluate(const Document& root) const {
-    /*
-      We'll try to return the narrowest possible result value.  To do that
-      without creating intermediate Values, do the arithmetic for double
-      and integral types in parallel, tracking the current narrowest
-      type.
+namespace {
+/**
+ * Computes the result of $multiply from its operand values. We'll try to return the narrowest
+ * possible result value. To do that without creating intermediate Values, do the arithmetic for
+ * double and integral types in parallel, tracking the current narrowest type.
+ */
+class MultiplyState {
+public:
+    /**
+     * Multiplies by the operand 'val'. Returns false if 'val' is null or missing, in which case the
+     * result of the $multiply is null whatever the other operands are.
+     */
+    bool multiply(const Value& val) {
+        if (!checkOperand(val)) {
+            return false;
+        }
+
+        BSONType oldProductType = productType;
+        productType = Value::getWidestNumeric(productType, val.getType());
+        if (productType == NumberDecimal) {
+            // On finding the first decimal, convert the partial product to decimal.
+            if (oldProductType != NumberDecimal) {
+                decimalProduct = oldProductType == NumberDouble
+                    ? Decimal128(doubleProduct, Decimal128::kRoundTo15Digits)
+                    : Decimal128(static_cast<int64_t>(longProduct));
+            }
+            decimalProduct = decimalProduct.multiply(val.coerceToDecimal());
+        } else {
+            doubleProduct *= val.coerceToDouble();
+            if (mongoSignedMultiplyOverflow64(longProduct, val.coerceToLong(), &longProduct)) {
+                // The 'longProduct' would have overflowed, so we're abandoning it.
+                productType = NumberDouble;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Returns true if 'val' is a valid operand of $multiply, and false if it is null or missing.
+     * Throws for any other value.
      */
+    static bool checkOperand(const Value& val) {
+        if (val.numeric()) {
+            return true;
+        } else if (val.nullish()) {
+            return false;
+        }
+        uasserted(16555,
+                  str::stream() << "$multiply only supports numeric types, not "
+                                << typeName(val.getType()));
+    }
+
+    Value getValue() const {
+        if (productType == NumberDouble)
+            return Value(doubleProduct);
+        else if (productType == NumberLong)
+            return Value(longProduct);
+        else if (productType == NumberInt)
+            return Value::createIntOrLong(longProduct);
+        else if (productType == NumberDecimal)
+            return Value(decimalProduct);
+        else
+            massert(16418, "$multiply resulted in a non-numeric type", false);
+    }
+
+private:
     double doubleProduct = 1;
     long long longProduct = 1;
     Decimal128 decimalProduct;  // This will be initialized on encountering the first decimal.
 
     BSONType productType = NumberInt;
+};
+}  // namespace
 
-    const size_t n = vpOperand.size();
-    for (size_t i = 0; i < n; ++i) {
-        Value val = vpOperand[i]->evaluate(root);
-
-        if (val.numeric()) {
-            BSONType oldProductType = productType;
-            productType = Value::getWidestNumeric(productType, val.getType());
-            if (productType == NumberDecimal) {
-                // On finding the first decimal, convert the partial product to decimal.
-                if (oldProductType != NumberDecimal) {
-                    decimalProduct = oldProductType == NumberDouble
-                        ? Decimal128(doubleProduct, Decimal128::kRoundTo15Digits)
-                        : Decimal128(static_cast<int64_t>(longProduct));
-                }
-                decimalProduct = decimalProduct.multiply(val.coerceToDecimal());
-            } else {
-                doubleProduct *= val.coerceToDouble();
-                if (mongoSignedMultiplyOverflow64(longProduct, val.coerceToLong(), &longProduct)) {
-                    // The 'longProduct' would have overflowed, so we're abandoning it.
-                    productType = NumberDouble;
-                }
-            }
-        } else if (val.nullish()) {
+Value ExpressionMultiply::evaluate(const Document& root) const {
+    MultiplyState state;
+    for (auto&& operand : vpOperand) {
+        if (!state.multiply(operand->evaluate(root))) {
             return Value(BSONNULL);
-        } else {
-            uasserted(16555,
-                      str::stream() << "$multiply only supports numeric types, not "
-                                    << typeName(val.getType()));
         }
     }
-
-    if (productType == NumberDouble)
-        return Value(doubleProduct);
-    else if (productType == NumberLong)
-        return Value(longProduct);
-    else if (productType == NumberInt)
-        return Value::createIntOrLong(longProduct);
-    else if (productType == NumberDecimal)
-        return Value(decimalProduct);
-    else
-        massert(16418, "$multiply resulted in a non-numeric type", false);
+    return state.getValue();
+}
+
+void ExpressionMultiply::evaluateBatch(const vector<Document>& roots, vector<Value>* out) const {
+    vector<vector<Value>> columns;
+    const vector<size_t> rows =
+        evaluateOperandColumns(vpOperand, roots, MultiplyState::checkOperand, &columns, out);
+
+    if (columns.size() == 2 && allOfType(columns, rows, NumberInt)) {
+        // The product of two ints always fits in a long.
+        binaryKernel<long long>(columns[0],
+                                columns[1],
+                                rows,
+                                [](const Value& val) { return val.getInt(); },
+                                [](long long lhs, long long rhs) { return lhs * rhs; },
+                                [](long long product) { return Value::createIntOrLong(product); },
+                                out);
+        return;
+    }
+
+    if (columns.size() == 2 && allOfType(columns, rows, NumberDouble)) {
+        binaryKernel<double>(columns[0],
+                             columns[1],
+                             rows,
+                             [](const Value& val) { return val.getDouble(); },
+                             [](double lhs, double rhs) { return lhs * rhs; },
+                             [](double product) { return Value(product); },
+                             out);
+        return;
+    }
+
+    for (size_t row : rows) {
+        MultiplyState state;
+        for (auto&& column : columns) {
+            state.multiply(column[row]);
+        }
+        (*out)[row] = state.getValue();
+    }
 }
 
 REGISTER_EXPRESSION(multiply, ExpressionMultiply::parse);
@@ -4313,10 +4664,8 @@ const char* ExpressionStrLenCP::getOpName() const {
 
 /* ----------------------- ExpressionSubtract ---------------------------- */
 
-Value ExpressionSubtract::evaluate(const Document& root) const {
-    Value lhs = vpOperand[0]->evaluate(root);
-    Value rhs = vpOperand[1]->evaluate(root);
-
+namespace {
+Value subtractValues(const Value& lhs, const Value& rhs) {
     BSONType diffType = Value::getWidestNumeric(rhs.getType(), lhs.getType());
 
     if (diffType == NumberDecimal) {
@@ -4353,6 +4702,50 @@ Value ExpressionSubtract::evaluate(const Document& root) const {
                                 << typeName(lhs.getType()));
     }
 }
+}  // namespace
+
+Value ExpressionSubtract::evaluate(const Document& root) const {
+    Value lhs = vpOperand[0]->evaluate(root);
+    Value rhs = vpOperand[1]->evaluate(root);
+    return subtractValues(lhs, rhs);
+}
+
+void ExpressionSubtract::evaluateBatch(const vector<Document>& roots, vector<Value>* out) const {
+    // Both operands are always evaluated, so there are no rows to skip.
+    vector<vector<Value>> columns(2);
+    vpOperand[0]->evaluateBatch(roots, &columns[0]);
+    vpOperand[1]->evaluateBatch(roots, &columns[1]);
+
+    vector<size_t> rows(roots.size());
+    std::iota(rows.begin(), rows.end(), 0);
+    out->resize(roots.size());
+
+    if (allOfType(columns, rows, NumberInt)) {
+        binaryKernel<long long>(columns[0],
+                                columns[1],
+                                rows,
+                                [](const Value& val) { return val.getInt(); },
+                                [](long long lhs, long long rhs) { return lhs - rhs; },
+                                [](long long diff) { return Value::createIntOrLong(diff); },
+                                out);
+        return;
+    }
+
+    if (allOfType(columns, rows, NumberDouble)) {
+        binaryKernel<double>(columns[0],
+                             columns[1],
+                             rows,
+                             [](const Value& val) { return val.getDouble(); },
+                             [](double lhs, double rhs) { return lhs - rhs; },
+                             [](double diff) { return Value(diff); },
+                             out);
+        return;
+    }
+
+    for (size_t row : rows) {
+        (*out)[row] = subtractValues(columns[0][row], columns[1][row]);
+    }
+}
 
 REGISTER_EXPRESSION(subtract, ExpressionSubtract::parse);
 const char* ExpressionSubtract::getOpName() const {
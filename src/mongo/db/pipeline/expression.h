@@ -146,6 +146,17 @@ public:
      */
     virtual Value evaluate(const Document& root) const = 0;
 
+    /**
+     * Evaluate expression with respect to each of the Documents in 'roots', replacing the contents
+     * of 'out' with the results: (*out)[i] is the result for roots[i].
+     *
+     * The results are those evaluate() would return for each Document in turn. The only difference
+     * is which error is reported when several Documents, or several operands of one Document, fail
+     * to evaluate. The default implementation simply calls evaluate(); expressions that can save
+     * work by processing a whole column of operand values at once override it.
+     */
+    virtual void evaluateBatch(const std::vector<Document>& roots, std::vector<Value>* out) const;
+
     /**
      * Returns information about the paths computed by this expression. This only needs to be
      * overridden by expressions that have renaming semantics, where optimization code could take
@@ -458,6 +469,7 @@ class ExpressionConstant final : public Expression {
 public:
     boost::intrusive_ptr<Expression> optimize() final;
     Value evaluate(const Document& root) const final;
+    void evaluateBatch(const std::vector<Document>& roots, std::vector<Value>* out) const final;
     Value serialize(bool explain) const final;
 
     const char* getOpName() const;
@@ -547,6 +559,75 @@ public:
         return evaluateDate(date, timeZone);
     }
 
+    void evaluateBatch(const std::vector<Document>& roots, std::vector<Value>* out) const final {
+        const size_t numRows = roots.size();
+        _date->evaluateBatch(roots, out);
+
+        // Rows whose date is null or missing evaluate to null. The timezone is only evaluated for
+        // the remaining ones.
+        std::vector<Date_t> dates(numRows);
+        std::vector<size_t> rows;
+        rows.reserve(numRows);
+        for (size_t i = 0; i < numRows; ++i) {
+            Value& dateVal = (*out)[i];
+            if (dateVal.nullish()) {
+                dateVal = Value(BSONNULL);
+                continue;
+            }
+            dates[i] = dateVal.coerceToDate();
+            rows.push_back(i);
+        }
+
+        // Calls through SubClass, whose evaluateDate() is final, to avoid a virtual call per row.
+        const SubClass& self = static_cast<const SubClass&>(*this);
+        if (!_timeZone) {
+            const TimeZone utc = TimeZoneDatabase::utcZone();
+            for (size_t i : rows) {
+                (*out)[i] = self.evaluateDate(dates[i], utc);
+            }
+            return;
+        }
+
+        std::vector<Document> tzRoots;
+        tzRoots.reserve(rows.size());
+        for (size_t i : rows) {
+            tzRoots.push_back(roots[i]);
+        }
+        std::vector<Value> timeZoneIds;
+        _timeZone->evaluateBatch(tzRoots, &timeZoneIds);
+
+        // The timezone is nearly always the same for every row, so it is looked up again only
+        // when it changes.
+        invariant(getExpressionContext()->timeZoneDatabase);
+        boost::optional<TimeZone> timeZone;
+        std::string timeZoneName;
+        for (size_t j = 0; j < rows.size(); ++j) {
+            const Value& timeZoneId = timeZoneIds[j];
+            Value& result = (*out)[rows[j]];
+            if (timeZoneId.nullish()) {
+                result = Value(BSONNULL);
+                continue;
+            }
+
+            uassert(40533,
+                    str::stream() << _opName
+                                  << " requires a string for the timezone argument, but was "
+                                     "given a "
+                                  << typeName(timeZoneId.getType())
+                                  << " ("
+                                  << timeZoneId.toString()
+                                  << ")",
+                    timeZoneId.getType() == BSONType::String);
+
+            if (!timeZone || timeZoneId.getStringData() != timeZoneName) {
+                timeZoneName = timeZoneId.getString();
+                timeZone.emplace(
+                    getExpressionContext()->timeZoneDatabase->getTimeZone(timeZoneName));
+            }
+            result = self.evaluateDate(dates[rows[j]], *timeZone);
+        }
+    }
+
     /**
      * Always serializes to the full {date: <date arg>, timezone: <timezone arg>} format, leaving
      * off the timezone if not specified.
@@ -670,6 +751,7 @@ public:
         : ExpressionVariadic<ExpressionAdd>(expCtx) {}
 
     Value evaluate(const Document& root) const final;
+    void evaluateBatch(const std::vector<Document>& roots, std::vector<Value>* out) const final;
     const char* getOpName() const final;
 
     bool isAssociative() const final {
@@ -811,6 +893,7 @@ public:
         : ExpressionFixedArity<ExpressionCompare, 2>(expCtx), cmpOp(cmpOp) {}
 
     Value evaluate(const Document& root) const final;
+    void evaluateBatch(const std::vector<Document>& roots, std::vector<Value>* out) const final;
     const char* getOpName() const final;
 
     CmpOp getOp() const {
@@ -867,6 +950,7 @@ public:
     explicit ExpressionCond(const boost::intrusive_ptr<ExpressionContext>& expCtx) : Base(expCtx) {}
 
     Value evaluate(const Document& root) const final;
+    void evaluateBatch(const std::vector<Document>& roots, std::vector<Value>* out) const final;
     const char* getOpName() const final;
 
     static boost::intrusive_ptr<Expression> parse(
@@ -1084,6 +1168,7 @@ public:
 
     boost::intrusive_ptr<Expression> optimize() final;
     Value evaluate(const Document& root) const final;
+    void evaluateBatch(const std::vector<Document>& roots, std::vector<Value>* out) const final;
     Value serialize(bool explain) const final;
 
     /*
@@ -1432,6 +1517,7 @@ public:
         : ExpressionVariadic<ExpressionMultiply>(expCtx) {}
 
     Value evaluate(const Document& root) const final;
+    void evaluateBatch(const std::vector<Document>& roots, std::vector<Value>* out) const final;
     const char* getOpName() const final;
 
     bool isAssociative() const final {
@@ -1783,6 +1869,7 @@ public:
         : ExpressionFixedArity<ExpressionSubtract, 2>(expCtx) {}
 
     Value evaluate(const Document& root) const final;
+    void evaluateBatch(const std::vector<Document>& roots, std::vector<Value>* out) const final;
     const char* getOpName() const final;
 };
 
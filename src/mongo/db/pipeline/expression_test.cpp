@@ -5486,6 +5486,183 @@ TEST(GetComputedPathsTest, ExpressionMapNotConsideredRenameWithDottedInputPath)
 
 }  // namespace GetComputedPathsTest
 
+namespace EvaluateBatch {
+
+/**
+ * Asserts that evaluateBatch() on 'docs' returns what evaluate() returns for each of them.
+ */
+void assertBatchMatchesEvaluate(const intrusive_ptr<Expression>& expr,
+                                const vector<Document>& docs) {
+    vector<Value> results;
+    expr->evaluateBatch(docs, &results);
+    ASSERT_EQ(results.size(), docs.size());
+    for (size_t i = 0; i < docs.size(); ++i) {
+        Value expected = expr->evaluate(docs[i]);
+        ASSERT_VALUE_EQ(results[i], expected);
+        ASSERT_EQ(results[i].getType(), expected.getType());
+        if (expected.getType() == NumberDouble) {
+            ASSERT_EQ(std::signbit(results[i].getDouble()), std::signbit(expected.getDouble()));
+        }
+    }
+}
+
+void assertBatchMatchesEvaluate(const BSONObj& exprSpec, const vector<Document>& docs) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    assertBatchMatchesEvaluate(
+        Expression::parseObject(expCtx, exprSpec, expCtx->variablesParseState), docs);
+}
+
+TEST(ExpressionEvaluateBatchTest, AddOfIntsMatchesEvaluate) {
+    vector<Document> docs{Document{{"a", 1}, {"b", 2}},
+                          Document{{"a", numeric_limits<int>::max()},
+                                   {"b", numeric_limits<int>::max()}},
+                          Document{{"a", numeric_limits<int>::min()}, {"b", -1}}};
+    assertBatchMatchesEvaluate(BSON("$add" << BSON_ARRAY("$a"
+                                                         << "$b")),
+                               docs);
+    assertBatchMatchesEvaluate(BSON("$add" << BSON_ARRAY("$a"
+                                                         << "$b"
+                                                         << 1)),
+                               docs);
+}
+
+TEST(ExpressionEvaluateBatchTest, AddOfDoublesMatchesEvaluate) {
+    vector<Document> docs{Document{{"a", 1.5}, {"b", 2.25}},
+                          Document{{"a", -0.0}, {"b", -0.0}},
+                          Document{{"a", numeric_limits<double>::infinity()},
+                                   {"b", -numeric_limits<double>::infinity()}},
+                          Document{{"a", 0.1}, {"b", 0.2}}};
+    assertBatchMatchesEvaluate(BSON("$add" << BSON_ARRAY("$a"
+                                                         << "$b")),
+                               docs);
+    assertBatchMatchesEvaluate(BSON("$add" << BSON_ARRAY("$a"
+                                                         << "$b"
+                                                         << "$a")),
+                               docs);
+}
+
+TEST(ExpressionEvaluateBatchTest, AddOfMixedTypesMatchesEvaluate) {
+    vector<Document> docs{Document{{"a", 1}, {"b", 2.5}},
+                          Document{{"a", 3LL}, {"b", Date_t::fromMillisSinceEpoch(1000)}},
+                          Document{{"a", Decimal128("1.5")}, {"b", 2}},
+                          Document{{"a", numeric_limits<long long>::max()}, {"b", 1LL}},
+                          Document{{"a", BSONNULL}, {"b", 1}},
+                          Document{{"b", 1}}};
+    assertBatchMatchesEvaluate(BSON("$add" << BSON_ARRAY("$a"
+                                                         << "$b")),
+                               docs);
+}
+
+TEST(ExpressionEvaluateBatchTest, AddDoesNotEvaluateOperandsAfterANull) {
+    // Dividing by 'b' would fail for the first document, whose sum is null because of 'a'.
+    vector<Document> docs{Document{{"a", BSONNULL}, {"b", 0}}, Document{{"a", 1}, {"b", 2}}};
+    assertBatchMatchesEvaluate(
+        BSON("$add" << BSON_ARRAY("$a" << BSON("$divide" << BSON_ARRAY(1 << "$b")))), docs);
+}
+
+TEST(ExpressionEvaluateBatchTest, AddRejectsUnsupportedOperandBeforeALaterNull) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto expr = Expression::parseObject(expCtx,
+                                        BSON("$add" << BSON_ARRAY("$a"
+                                                                  << "$b")),
+                                        expCtx->variablesParseState);
+    vector<Document> docs{Document{{"a", 1}, {"b", 2}}, Document{{"a", "x"_sd}, {"b", BSONNULL}}};
+    vector<Value> results;
+    ASSERT_THROWS_CODE(expr->evaluateBatch(docs, &results), AssertionException, 16554);
+}
+
+TEST(ExpressionEvaluateBatchTest, MultiplyAndSubtractMatchEvaluate) {
+    vector<Document> docs{Document{{"a", 3}, {"b", 4}},
+                          Document{{"a", numeric_limits<int>::max()}, {"b", 2}},
+                          Document{{"a", 1.5}, {"b", -2.0}},
+                          Document{{"a", Date_t::fromMillisSinceEpoch(5000)}, {"b", 1000}},
+                          Document{{"a", 2}, {"b", BSONNULL}}};
+    assertBatchMatchesEvaluate(BSON("$subtract" << BSON_ARRAY("$a"
+                                                              << "$b")),
+                               docs);
+    // Keep the dates out of $multiply, which does not accept them.
+    docs.erase(docs.begin() + 3);
+    assertBatchMatchesEvaluate(BSON("$multiply" << BSON_ARRAY("$a"
+                                                              << "$b")),
+                               docs);
+    assertBatchMatchesEvaluate(BSON("$multiply" << BSON_ARRAY("$a"
+                                                              << "$b"
+                                                              << 2LL)),
+                               docs);
+
+    // Batches of a single type take the unboxed kernels.
+    vector<Document> doubles{Document{{"a", 1.5}, {"b", -2.0}}, Document{{"a", -0.0}, {"b", 3.0}}};
+    assertBatchMatchesEvaluate(BSON("$multiply" << BSON_ARRAY("$a"
+                                                              << "$b")),
+                               doubles);
+    assertBatchMatchesEvaluate(BSON("$subtract" << BSON_ARRAY("$a"
+                                                              << "$b")),
+                               doubles);
+}
+
+TEST(ExpressionEvaluateBatchTest, CompareMatchesEvaluate) {
+    const double nan = numeric_limits<double>::quiet_NaN();
+    vector<Document> docs{Document{{"a", 1}, {"b", 2LL}},
+                          Document{{"a", 2.5}, {"b", 2.5}},
+                          Document{{"a", nan}, {"b", 1.0}},
+                          Document{{"a", nan}, {"b", nan}},
+                          Document{{"a", "abc"_sd}, {"b", 3}},
+                          Document{{"a", 7LL}, {"b", 6.5}},
+                          Document{{"b", BSONNULL}}};
+    for (auto&& op : {"$eq", "$ne", "$gt", "$gte", "$lt", "$lte", "$cmp"}) {
+        assertBatchMatchesEvaluate(BSON(op << BSON_ARRAY("$a"
+                                                         << "$b")),
+                                   docs);
+    }
+}
+
+TEST(ExpressionEvaluateBatchTest, CondOnlyEvaluatesTheBranchTaken) {
+    // Dividing by 'a' would fail for the documents that take the else branch.
+    vector<Document> docs{Document{{"a", 0}}, Document{{"a", 2}}, Document{}, Document{{"a", 4}}};
+    assertBatchMatchesEvaluate(
+        BSON("$cond" << BSON_ARRAY(BSON("$gt" << BSON_ARRAY("$a" << 0))
+                                   << BSON("$divide" << BSON_ARRAY(1 << "$a"))
+                                   << "$a")),
+        docs);
+}
+
+TEST(ExpressionEvaluateBatchTest, DatePartMatchesEvaluate) {
+    const auto date = Date_t::fromMillisSinceEpoch(1500000000000LL);
+    vector<Document> docs{Document{{"d", date}, {"tz", "+02:00"_sd}},
+                          Document{{"d", date}, {"tz", "+02:00"_sd}},
+                          Document{{"d", date}, {"tz", "UTC"_sd}},
+                          Document{{"d", BSONNULL}, {"tz", "UTC"_sd}},
+                          Document{{"d", date}},
+                          Document{{"d", date + Hours(3)}, {"tz", "-05:30"_sd}}};
+    assertBatchMatchesEvaluate(BSON("$hour"
+                                    << "$d"),
+                               docs);
+    assertBatchMatchesEvaluate(BSON("$hour" << BSON("date"
+                                                    << "$d"
+                                                    << "timezone"
+                                                    << "$tz")),
+                               docs);
+    assertBatchMatchesEvaluate(BSON("$dayOfYear" << BSON("date"
+                                                         << "$d"
+                                                         << "timezone"
+                                                         << "$tz")),
+                               docs);
+}
+
+TEST(ExpressionEvaluateBatchTest, FieldPathMatchesEvaluate) {
+    vector<Document> docs{Document{{"a", Document{{"b", 1}}}},
+                          Document{{"a", vector<Value>{Value(Document{{"b", 2}}), Value(3)}}},
+                          Document{{"a", 4}},
+                          Document{}};
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    for (auto&& path : {"$a", "$a.b", "$$ROOT", "$$CURRENT.a"}) {
+        assertBatchMatchesEvaluate(
+            ExpressionFieldPath::parse(expCtx, path, expCtx->variablesParseState), docs);
+    }
+}
+
+}  // namespace EvaluateBatch
+
 class All : public Suite {
 public:
     All() : Suite("expression") {}
@@ -0,0 +1,344 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/group_table.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "mongo/db/pipeline/accumulator.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace {
+
+using AccumulatorKind = GroupTable::AccumulatorKind;
+
+// Number of records in the first arena block and target size of the largest ones. Records never
+// straddle blocks.
+const size_t kFirstBlockRecords = 8;
+const size_t kMaxBlockBytes = 64 * 1024;
+
+// Smallest non-empty size of the index.
+const size_t kMinIndexSize = 16;
+
+struct FirstState {
+    Value value;
+    bool haveFirst = false;
+};
+
+size_t alignUp(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+size_t stateSize(AccumulatorKind kind) {
+    switch (kind) {
+        case AccumulatorKind::kSum:
+            return sizeof(AccumulatorSum::State);
+        case AccumulatorKind::kAvg:
+            return sizeof(AccumulatorAvg::State);
+        case AccumulatorKind::kFirst:
+            return sizeof(FirstState);
+        case AccumulatorKind::kMin:
+        case AccumulatorKind::kMax:
+        case AccumulatorKind::kLast:
+            return sizeof(Value);
+    }
+    MONGO_UNREACHABLE;
+}
+
+size_t stateAlignment(AccumulatorKind kind) {
+    switch (kind) {
+        case AccumulatorKind::kSum:
+            return alignof(AccumulatorSum::State);
+        case AccumulatorKind::kAvg:
+            return alignof(AccumulatorAvg::State);
+        case AccumulatorKind::kFirst:
+            return alignof(FirstState);
+        case AccumulatorKind::kMin:
+        case AccumulatorKind::kMax:
+        case AccumulatorKind::kLast:
+            return alignof(Value);
+    }
+    MONGO_UNREACHABLE;
+}
+
+void constructState(AccumulatorKind kind, char* state) {
+    switch (kind) {
+        case AccumulatorKind::kSum:
+            new (state) AccumulatorSum::State();
+            return;
+        case AccumulatorKind::kAvg:
+            new (state) AccumulatorAvg::State();
+            return;
+        case AccumulatorKind::kFirst:
+            new (state) FirstState();
+            return;
+        case AccumulatorKind::kMin:
+        case AccumulatorKind::kMax:
+        case AccumulatorKind::kLast:
+            new (state) Value();
+            return;
+    }
+    MONGO_UNREACHABLE;
+}
+
+void destroyState(AccumulatorKind kind, char* state) {
+    switch (kind) {
+        case AccumulatorKind::kSum:
+            reinterpret_cast<AccumulatorSum::State*>(state)->~State();
+            return;
+        case AccumulatorKind::kAvg:
+            reinterpret_cast<AccumulatorAvg::State*>(state)->~State();
+            return;
+        case AccumulatorKind::kFirst:
+            reinterpret_cast<FirstState*>(state)->~FirstState();
+            return;
+        case AccumulatorKind::kMin:
+        case AccumulatorKind::kMax:
+        case AccumulatorKind::kLast:
+            reinterpret_cast<Value*>(state)->~Value();
+            return;
+    }
+    MONGO_UNREACHABLE;
+}
+
+size_t& hashOf(char* record) {
+    return *reinterpret_cast<size_t*>(record);
+}
+
+Value& keyOf(char* record) {
+    return *reinterpret_cast<Value*>(record + sizeof(size_t));
+}
+
+}  // namespace
+
+boost::optional<std::vector<AccumulatorKind>> GroupTable::getAccumulatorKinds(
+    const std::vector<AccumulationStatement>& accumulators,
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    std::vector<AccumulatorKind> kinds;
+    kinds.reserve(accumulators.size());
+    for (auto&& accumulator : accumulators) {
+        const StringData opName = accumulator.makeAccumulator(expCtx)->getOpName();
+        if (opName == "$sum") {
+            kinds.push_back(AccumulatorKind::kSum);
+        } else if (opName == "$avg") {
+            kinds.push_back(AccumulatorKind::kAvg);
+        } else if (opName == "$min") {
+            kinds.push_back(AccumulatorKind::kMin);
+        } else if (opName == "$max") {
+            kinds.push_back(AccumulatorKind::kMax);
+        } else if (opName == "$first") {
+            kinds.push_back(AccumulatorKind::kFirst);
+        } else if (opName == "$last") {
+            kinds.push_back(AccumulatorKind::kLast);
+        } else {
+            return boost::none;
+        }
+    }
+    return kinds;
+}
+
+GroupTable::GroupTable(const ValueComparator& comparator, std::vector<AccumulatorKind> kinds)
+    : _comparator(comparator), _kinds(std::move(kinds)) {
+    size_t offset = sizeof(size_t) + sizeof(Value);
+    size_t recordAlignment = std::max(alignof(size_t), alignof(Value));
+    for (auto kind : _kinds) {
+        offset = alignUp(offset, stateAlignment(kind));
+        _stateOffsets.push_back(offset);
+        offset += stateSize(kind);
+        recordAlignment = std::max(recordAlignment, stateAlignment(kind));
+    }
+    invariant(recordAlignment <= alignof(std::max_align_t));
+    _recordBytes = alignUp(offset, recordAlignment);
+
+    _maxBlockShift = 0;
+    while ((kFirstBlockRecords << (_maxBlockShift + 1)) * _recordBytes <= kMaxBlockBytes) {
+        _maxBlockShift++;
+    }
+    _smallBlocksRecords = kFirstBlockRecords * ((size_t(1) << _maxBlockShift) - 1);
+}
+
+GroupTable::~GroupTable() {
+    clear();
+}
+
+char* GroupTable::record(size_t group) const {
+    dassert(group < _numGroups);
+    size_t block;
+    size_t offset;
+    if (group < _smallBlocksRecords) {
+        // Block b starts at group kFirstBlockRecords * (2^b - 1).
+        block = 63 - countLeadingZeros64(group / kFirstBlockRecords + 1);
+        offset = group - kFirstBlockRecords * ((size_t(1) << block) - 1);
+    } else {
+        const size_t maxBlockRecords = kFirstBlockRecords << _maxBlockShift;
+        block = _maxBlockShift + (group - _smallBlocksRecords) / maxBlockRecords;
+        offset = (group - _smallBlocksRecords) % maxBlockRecords;
+    }
+    return _blocks[block].get() + offset * _recordBytes;
+}
+
+char* GroupTable::allocateRecord() {
+    if (_numGroups == _capacity) {
+        const size_t blockRecords = kFirstBlockRecords
+            << std::min(_blocks.size(), _maxBlockShift);
+        const size_t blockBytes = blockRecords * _recordBytes;
+        _blocks.emplace_back(new char[blockBytes]);
+        _capacity += blockRecords;
+        _arenaBytes += blockBytes;
+    }
+    return record(_numGroups++);
+}
+
+void GroupTable::growIndex() {
+    const size_t newSize = std::max(kMinIndexSize, _index.size() * 2);
+    std::vector<uint32_t> newIndex(newSize, 0);
+    const size_t mask = newSize - 1;
+    for (size_t group = 0; group < _numGroups; group++) {
+        size_t pos = hashOf(record(group)) & mask;
+        while (newIndex[pos] != 0) {
+            pos = (pos + 1) & mask;
+        }
+        newIndex[pos] = group + 1;
+    }
+    _index.swap(newIndex);
+}
+
+size_t GroupTable::findOrInsert(const Value& key, bool* inserted) {
+    // Keep the load factor at most 3/4 so that probe sequences stay short.
+    if ((_numGroups + 1) * 4 > _index.size() * 3) {
+        invariant(_numGroups < std::numeric_limits<uint32_t>::max());
+        growIndex();
+    }
+
+    const size_t hash = _comparator.hash(key);
+    const size_t mask = _index.size() - 1;
+    size_t pos = hash & mask;
+    for (; _index[pos] != 0; pos = (pos + 1) & mask) {
+        const size_t group = _index[pos] - 1;
+        char* rec = record(group);
+        if (hashOf(rec) == hash && _comparator.evaluate(keyOf(rec) == key)) {
+            *inserted = false;
+            return group;
+        }
+    }
+
+    char* rec = allocateRecord();
+    const size_t group = _numGroups - 1;
+    new (rec) size_t(hash);
+    new (rec + sizeof(size_t)) Value(key);
+    for (size_t i = 0; i < _kinds.size(); i++) {
+        constructState(_kinds[i], rec + _stateOffsets[i]);
+    }
+    _outOfLineBytes += key.getApproximateSize() - sizeof(Value);
+    _index[pos] = group + 1;
+
+    *inserted = true;
+    return group;
+}
+
+void GroupTable::assign(Value* slot, const Value& value) {
+    _outOfLineBytes -= slot->getApproximateSize() - sizeof(Value);
+    _outOfLineBytes += value.getApproximateSize() - sizeof(Value);
+    *slot = value;
+}
+
+void GroupTable::process(size_t group, size_t accumulator, const Value& input, bool merging) {
+    char* state = record(group) + _stateOffsets[accumulator];
+    switch (_kinds[accumulator]) {
+        case AccumulatorKind::kSum:
+            reinterpret_cast<AccumulatorSum::State*>(state)->process(input, merging);
+            return;
+        case AccumulatorKind::kAvg:
+            reinterpret_cast<AccumulatorAvg::State*>(state)->process(input, merging);
+            return;
+        case AccumulatorKind::kMin:
+        case AccumulatorKind::kMax: {
+            // Same as AccumulatorMinMax: nullish values have no impact on the result and missing
+            // is lower than all other values.
+            if (input.nullish()) {
+                return;
+            }
+            Value* val = reinterpret_cast<Value*>(state);
+            const int sense = _kinds[accumulator] == AccumulatorKind::kMin ? 1 : -1;
+            if (val->missing() || _comparator.compare(*val, input) * sense > 0) {
+                assign(val, input);
+            }
+            return;
+        }
+        case AccumulatorKind::kFirst: {
+            FirstState* first = reinterpret_cast<FirstState*>(state);
+            if (!first->haveFirst) {
+                first->haveFirst = true;
+                assign(&first->value, input);
+            }
+            return;
+        }
+        case AccumulatorKind::kLast:
+            assign(reinterpret_cast<Value*>(state), input);
+            return;
+    }
+    MONGO_UNREACHABLE;
+}
+
+const Value& GroupTable::getKey(size_t group) const {
+    return keyOf(record(group));
+}
+
+Value GroupTable::getValue(size_t group, size_t accumulator, bool toBeMerged) const {
+    const char* state = record(group) + _stateOffsets[accumulator];
+    switch (_kinds[accumulator]) {
+        case AccumulatorKind::kSum:
+            return reinterpret_cast<const AccumulatorSum::State*>(state)->getValue(toBeMerged);
+        case AccumulatorKind::kAvg:
+            return reinterpret_cast<const AccumulatorAvg::State*>(state)->getValue(toBeMerged);
+        case AccumulatorKind::kMin:
+        case AccumulatorKind::kMax: {
+            const Value& val = *reinterpret_cast<const Value*>(state);
+            return val.missing() ? Value(BSONNULL) : val;
+        }
+        case AccumulatorKind::kFirst:
+            return reinterpret_cast<const FirstState*>(state)->value;
+        case AccumulatorKind::kLast:
+            return *reinterpret_cast<const Value*>(state);
+    }
+    MONGO_UNREACHABLE;
+}
+
+void GroupTable::clear() {
+    for (size_t group = 0; group < _numGroups; group++) {
+        char* rec = record(group);
+        keyOf(rec).~Value();
+        for (size_t i = 0; i < _kinds.size(); i++) {
+            destroyState(_kinds[i], rec + _stateOffsets[i]);
+        }
+    }
+    _numGroups = 0;
+    _capacity = 0;
+    _blocks.clear();
+    std::vector<uint32_t>().swap(_index);
+    _arenaBytes = 0;
+    _outOfLineBytes = 0;
+}
+
+}  // namespace mongo
@@ -0,0 +1,136 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/db/pipeline/value_comparator.h"
+
+namespace mongo {
+
+/**
+ * The groups of a $group stage whose accumulators all keep fixed-size state ($sum, $avg, $min,
+ * $max, $first and $last), stored without an allocation per group.
+ *
+ * Each group is a fixed-size record holding its key and the state of every accumulator inline.
+ * Records are carved out of arena blocks, which double in size up to 64KB so that small $group
+ * stages stay small, and are located through an open-addressing index of record numbers.
+ * memoryUsageBytes() is the size of the blocks and the index plus the memory referenced by the
+ * Values held in the records, which is what the table really costs.
+ *
+ * Groups are numbered in insertion order, starting at zero.
+ */
+class GroupTable {
+    MONGO_DISALLOW_COPYING(GroupTable);
+
+public:
+    enum class AccumulatorKind : uint8_t { kSum, kAvg, kMin, kMax, kFirst, kLast };
+
+    /**
+     * Returns the kind of each accumulator in 'accumulators', or boost::none if any of them does
+     * not keep fixed-size state.
+     */
+    static boost::optional<std::vector<AccumulatorKind>> getAccumulatorKinds(
+        const std::vector<AccumulationStatement>& accumulators,
+        const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    GroupTable(const ValueComparator& comparator, std::vector<AccumulatorKind> kinds);
+    ~GroupTable();
+
+    /**
+     * Returns the number of the group with key 'key', adding a group with fresh accumulators if
+     * there is none yet. Sets '*inserted' to whether a group was added.
+     */
+    size_t findOrInsert(const Value& key, bool* inserted);
+
+    /**
+     * Feeds 'input' to accumulator 'accumulator' of group 'group', with the same semantics as
+     * Accumulator::process().
+     */
+    void process(size_t group, size_t accumulator, const Value& input, bool merging);
+
+    const Value& getKey(size_t group) const;
+
+    /**
+     * Returns the result of accumulator 'accumulator' of group 'group', with the same semantics as
+     * Accumulator::getValue().
+     */
+    Value getValue(size_t group, size_t accumulator, bool toBeMerged) const;
+
+    size_t size() const {
+        return _numGroups;
+    }
+
+    bool empty() const {
+        return _numGroups == 0;
+    }
+
+    /**
+     * Removes all groups and releases the arena.
+     */
+    void clear();
+
+    size_t memoryUsageBytes() const {
+        return _arenaBytes + _index.capacity() * sizeof(uint32_t) + _outOfLineBytes;
+    }
+
+private:
+    char* record(size_t group) const;
+
+    char* allocateRecord();
+
+    /**
+     * Replaces the Value in 'slot', keeping track of the memory it references.
+     */
+    void assign(Value* slot, const Value& value);
+
+    void growIndex();
+
+    const ValueComparator _comparator;
+    const std::vector<AccumulatorKind> _kinds;
+
+    // Layout of a record: the hash of the key, the key and then the state of each accumulator at
+    // the offset in '_stateOffsets'.
+    std::vector<size_t> _stateOffsets;
+    size_t _recordBytes;
+
+    // Block b holds kFirstBlockRecords << min(b, _maxBlockShift) records, so the blocks before
+    // _maxBlockShift hold the first _smallBlocksRecords groups.
+    size_t _maxBlockShift;
+    size_t _smallBlocksRecords;
+
+    std::vector<std::unique_ptr<char[]>> _blocks;
+    size_t _capacity = 0;
+    size_t _numGroups = 0;
+
+    // Open-addressing index with linear probing. Holds a group number plus one, or zero for an
+    // empty slot. Its size is zero or a power of two.
+    std::vector<uint32_t> _index;
+
+    size_t _arenaBytes = 0;
+    size_t _outOfLineBytes = 0;
+};
+
+}  // namespace mongo
@@ -49,42 +49,62 @@ boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(size_t nConsumers, int bufferS
 }
 
 DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
-    size_t nConsumersStillProcessingThisBatch =
-        std::count_if(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
-            return info.nLeftToReturn > 0;
-        });
+    auto next = getNextUnreleased(consumerId);
+    if (next.isAdvanced()) {
+        releaseConsumed();
+    }
+    return next;
+}
 
-    if (_buffer.empty() || nConsumersStillProcessingThisBatch == 0) {
-        loadNextBatch();
+DocumentSource::GetNextResult::ReturnStatus TeeBuffer::getNextBatch(size_t consumerId,
+                                                                    std::vector<Document>* batch,
+                                                                    size_t maxDocs) {
+    auto status = DocumentSource::GetNextResult::ReturnStatus::kAdvanced;
+    for (size_t i = 0; i < maxDocs; ++i) {
+        auto next = getNextUnreleased(consumerId);
+        if (!next.isAdvanced()) {
+            status = next.getStatus();
+            break;
+        }
+        batch->push_back(next.releaseDocument());
     }
+    releaseConsumed();
+    return status;
+}
 
-    if (_buffer.empty()) {
-        // If we've loaded the next batch and it's still empty, then we've exhausted our input.
+DocumentSource::GetNextResult TeeBuffer::getNextUnreleased(size_t consumerId) {
+    ConsumerInfo& consumer = _consumers[consumerId];
+    if (!consumer.stillInUse) {
         return DocumentSource::GetNextResult::makeEOF();
     }
 
-    if (_consumers[consumerId].nLeftToReturn == 0) {
-        // This consumer has reached the end of this batch, but there are still other consumers that
-        // haven't seen this whole batch.
-        return DocumentSource::GetNextResult::makePauseExecution();
+    if (consumer.position == _bufferStart + _buffer.size()) {
+        // Make room for more input, unless the other consumers still need all of it.
+        releaseConsumed();
+        if (!loadMore()) {
+            // If the input is exhausted, then so is this consumer. Otherwise the buffer is full of
+            // documents other consumers haven't seen yet.
+            return _sourceExhausted ? DocumentSource::GetNextResult::makeEOF()
+                                    : DocumentSource::GetNextResult::makePauseExecution();
+        }
     }
 
-    const size_t bufferIndex = _buffer.size() - _consumers[consumerId].nLeftToReturn;
-    --_consumers[consumerId].nLeftToReturn;
-
-    return _buffer[bufferIndex];
+    return Document(_buffer[consumer.position++ - _bufferStart].doc);
 }
 
-void TeeBuffer::loadNextBatch() {
-    _buffer.clear();
-    size_t bytesInBuffer = 0;
+bool TeeBuffer::loadMore() {
+    if (_sourceExhausted || _bytesInBuffer >= _bufferSizeBytes) {
+        return false;
+    }
 
+    const size_t oldSize = _buffer.size();
     auto input = _source->getNext();
     for (; input.isAdvanced(); input = _source->getNext()) {
-        bytesInBuffer += input.getDocument().getApproximateSize();
-        _buffer.push_back(std::move(input));
+        const size_t size = input.getDocument().getApproximateSize();
+        _bytesInBuffer += size;
+        _buffer.push_back({input.releaseDocument(), size});
 
-        if (bytesInBuffer >= _bufferSizeBytes) {
+        if (_bytesInBuffer >= _bufferSizeBytes) {
             break;  // Need to break here so we don't get the next input and accidentally ignore it.
         }
     }
@@ -94,13 +114,23 @@ void TeeBuffer::loadNextBatch() {
     //   - The $facet stage is the only stage that uses TeeBuffer.
     //   - We currently disallow nested $facet stages.
     invariant(!input.isPaused());
+    _sourceExhausted = input.isEOF();
+
+    return _buffer.size() != oldSize;
+}
 
-    // Populate the pending returns.
-    for (size_t consumerId = 0; consumerId < _consumers.size(); ++consumerId) {
-        if (_consumers[consumerId].stillInUse) {
-            _consumers[consumerId].nLeftToReturn = _buffer.size();
+void TeeBuffer::releaseConsumed() {
+    size_t minPosition = _bufferStart + _buffer.size();
+    for (auto&& consumer : _consumers) {
+        if (consumer.stillInUse) {
+            minPosition = std::min(minPosition, consumer.position);
         }
     }
+
+    for (; _bufferStart < minPosition; ++_bufferStart) {
+        _bytesInBuffer -= _buffer.front().approximateSize;
+        _buffer.pop_front();
+    }
 }
 
 }  // namespace mongo
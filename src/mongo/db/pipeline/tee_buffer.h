@@ -30,6 +30,7 @@
 
 #include <algorithm>
 #include <boost/intrusive_ptr.hpp>
+#include <deque>
 #include <vector>
 
 #include "mongo/db/pipeline/document.h"
@@ -41,9 +42,9 @@ namespace mongo {
 
 /**
  * This stage takes a stream of input documents and makes them available to multiple consumers. To
- * do so, it will batch incoming documents and allow each consumer to consume one batch at a time.
- * As a consequence, consumers must be able to pause their execution to allow other consumers to
- * process the batch before moving to the next batch.
+ * do so, it buffers incoming documents until every consumer has read them, and releases each
+ * document as soon as the last consumer has. Consumers advance independently, but one that gets a
+ * full buffer ahead of the slowest consumer must pause its execution until the others catch up.
  */
 class TeeBuffer : public RefCountable {
 public:
@@ -64,14 +65,16 @@ public:
      */
     void dispose(size_t consumerId) {
         _consumers[consumerId].stillInUse = false;
-        _consumers[consumerId].nLeftToReturn = 0;
         if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
                 return info.stillInUse;
             })) {
             _buffer.clear();
+            _bytesInBuffer = 0;
             if (_source) {
                 _source->dispose();
             }
+        } else {
+            releaseConsumed();
         }
     }
 
@@ -82,24 +85,54 @@ public:
      */
     DocumentSource::GetNextResult getNext(size_t consumerId);
 
+    /**
+     * Like DocumentSource::getNextBatch(), appends up to 'maxDocs' of the documents meant to be
+     * consumed by the pipeline given by 'consumerId' to 'batch'.
+     */
+    DocumentSource::GetNextResult::ReturnStatus getNextBatch(size_t consumerId,
+                                                             std::vector<Document>* batch,
+                                                             size_t maxDocs);
+
 private:
     TeeBuffer(size_t nConsumers, size_t bufferSizeBytes);
 
     /**
-     * Clears '_buffer', then keeps requesting results from '_source' and pushing them all into
-     * '_buffer', until more than '_bufferSizeBytes' of documents have been returned, or until
-     * '_source' is exhausted.
+     * Retrieves the next document for 'consumerId' without releasing the documents every consumer
+     * has now read.
+     */
+    DocumentSource::GetNextResult getNextUnreleased(size_t consumerId);
+
+    /**
+     * Keeps requesting results from '_source' and appending them to '_buffer' until it holds more
+     * than '_bufferSizeBytes' of documents, or until '_source' is exhausted. Returns false if no
+     * document could be added.
      */
-    void loadNextBatch();
+    bool loadMore();
+
+    /**
+     * Removes the documents that every consumer still in use has read from '_buffer'.
+     */
+    void releaseConsumed();
 
     DocumentSource* _source = nullptr;
+    bool _sourceExhausted = false;
 
     const size_t _bufferSizeBytes;
-    std::vector<DocumentSource::GetNextResult> _buffer;
+
+    struct BufferedDocument {
+        Document doc;
+        size_t approximateSize;
+    };
+    // The documents some consumer still has to read. The first one is input document number
+    // '_bufferStart', counting from zero.
+    std::deque<BufferedDocument> _buffer;
+    size_t _bufferStart = 0;
+    size_t _bytesInBuffer = 0;
 
     struct ConsumerInfo {
         bool stillInUse = true;
-        int nLeftToReturn = 0;
+        // The number of the input document this consumer reads next.
+        size_t position = 0;
     };
     std::vector<ConsumerInfo> _consumers;
 };
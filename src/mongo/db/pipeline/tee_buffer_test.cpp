@@ -166,5 +166,51 @@ TEST(TeeBufferTest, ShouldAllowOtherConsumersToAdvanceOnceTrailingConsumerIsDisp
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
 }
+
+TEST(TeeBufferTest, ShouldLetConsumersReadAheadOnceEarlierDocumentsAreReleased) {
+    std::deque<DocumentSource::GetNextResult> inputs{
+        Document{{"a", 1}}, Document{{"a", 2}}, Document{{"a", 3}}};
+    auto mock = DocumentSourceMock::create(inputs);
+
+    const size_t nConsumers = 2;
+    const size_t bufferBytes = 1;  // Only one document fits in the buffer.
+    auto teeBuffer = TeeBuffer::create(nConsumers, bufferBytes);
+    teeBuffer->setSource(mock.get());
+
+    // Consumer #0 can only read the first document, which consumer #1 hasn't seen yet.
+    std::vector<Document> batch0;
+    ASSERT(teeBuffer->getNextBatch(0, &batch0, 10) ==
+           DocumentSource::GetNextResult::ReturnStatus::kPauseExecution);
+    ASSERT_EQ(batch0.size(), 1UL);
+    ASSERT_DOCUMENT_EQ(batch0[0], inputs[0].getDocument());
+
+    // Once consumer #1 reads it, the first document is released, making room for the second.
+    std::vector<Document> batch1;
+    ASSERT(teeBuffer->getNextBatch(1, &batch1, 10) ==
+           DocumentSource::GetNextResult::ReturnStatus::kPauseExecution);
+    ASSERT_EQ(batch1.size(), 2UL);
+    ASSERT_DOCUMENT_EQ(batch1[1], inputs[1].getDocument());
+
+    // A batch ends when it is full, even if more documents are available.
+    batch0.clear();
+    ASSERT(teeBuffer->getNextBatch(0, &batch0, 1) ==
+           DocumentSource::GetNextResult::ReturnStatus::kAdvanced);
+    ASSERT_EQ(batch0.size(), 1UL);
+    ASSERT_DOCUMENT_EQ(batch0[0], inputs[1].getDocument());
+
+    batch0.clear();
+    ASSERT(teeBuffer->getNextBatch(0, &batch0, 10) ==
+           DocumentSource::GetNextResult::ReturnStatus::kPauseExecution);
+    ASSERT_EQ(batch0.size(), 1UL);
+    ASSERT_DOCUMENT_EQ(batch0[0], inputs[2].getDocument());
+
+    batch1.clear();
+    ASSERT(teeBuffer->getNextBatch(1, &batch1, 10) ==
+           DocumentSource::GetNextResult::ReturnStatus::kEOF);
+    ASSERT_EQ(batch1.size(), 1UL);
+    ASSERT_DOCUMENT_EQ(batch1[0], inputs[2].getDocument());
+
+    ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
+}
 }  // namespace
 }  // namespace mongo
@@ -364,6 +364,9 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         }
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->docsTested);
+            if (spec->docsSkippedByThreshold > 0) {
+                bob->appendNumber("docsSkippedByThreshold", spec->docsSkippedByThreshold);
+            }
         }
     } else if (STAGE_COUNT == stats.stageType) {
         CountStats* spec = static_cast<CountStats*>(stats.specific.get());
@@ -567,6 +570,10 @@ void Explain::statsToBSON(const PlanStageStats& stats,
     } else if (STAGE_TEXT_OR == stats.stageType) {
         TextOrStats* spec = static_cast<TextOrStats*>(stats.specific.get());
 
+        if (spec->topK) {
+            bob->appendNumber("topK", spec->topK);
+        }
+
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->fetches);
         }
@@ -31,12 +31,16 @@
 #include <iostream>
 #include <unordered_set>
 
+#include <third_party/murmurhash3/MurmurHash3.h>
+
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/r2_region_coverer.h"
 #include "mongo/db/hasher.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/query/expression_index_knobs.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/lru_cache.h"
 #include "third_party/s2/s2cellid.h"
 #include "third_party/s2/s2region.h"
 #include "third_party/s2/s2regioncoverer.h"
@@ -108,28 +112,118 @@ void ExpressionMapping::cover2d(const R2Region& region,
     GeoHashsToIntervalsWithParents(unorderedCovering, oilOut);
 }
 
-std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
+namespace {
+/**
+ * Identifies a 2dsphere covering by the BSON description of the covered region and the coverer
+ * settings it was computed with.
+ */
+struct S2CoveringCacheKey {
+    bool operator==(const S2CoveringCacheKey& other) const {
+        return minLevel == other.minLevel && maxLevel == other.maxLevel &&
+            maxCells == other.maxCells && region.binaryEqual(other.region);
+    }
+
+    BSONObj region;
+    int minLevel;
+    int maxLevel;
+    int maxCells;
+};
+
+struct S2CoveringCacheKeyHasher {
+    size_t operator()(const S2CoveringCacheKey& key) const {
+        uint32_t hash;
+        MurmurHash3_x86_32(key.region.objdata(), key.region.objsize(), key.maxCells, &hash);
+        return hash;
+    }
+};
+
+/**
+ * Coverings computed for recently queried regions. Many clients tend to issue the same
+ * $geoWithin polygon or $geoNear annulus, and the S2 coverer is the most expensive part of
+ * building their bounds.
+ */
+class S2CoveringCache {
+public:
+    static constexpr size_t kMaxEntries = 1024;
+
+    bool find(const S2CoveringCacheKey& key, std::vector<S2CellId>* cover) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        auto it = _cache.find(key);
+        if (it == _cache.end()) {
+            return false;
+        }
+        *cover = it->second;
+        return true;
+    }
+
+    void add(S2CoveringCacheKey key, const std::vector<S2CellId>& cover) {
+        key.region = key.region.getOwned();
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _cache.add(key, cover);
+    }
+
+    void clear() {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _cache.clear();
+    }
+
+private:
+    stdx::mutex _mutex;
+    LRUCache<S2CoveringCacheKey, std::vector<S2CellId>, S2CoveringCacheKeyHasher> _cache{
+        kMaxEntries};
+};
+
+S2CoveringCache s2CoveringCache;
+
+std::vector<S2CellId> computeS2Covering(const S2Region& region,
+                                        const BSONObj& regionKey,
+                                        bool useCache) {
     auto minLevel = internalQueryS2GeoCoarsestLevel.load();
     auto maxLevel = internalQueryS2GeoFinestLevel.load();
+    auto maxCells = internalQueryS2GeoMaxCells.load();
 
     uassert(28739, "Geo coarsest level must be in range [0,30]", 0 <= minLevel && minLevel <= 30);
     uassert(28740, "Geo finest level must be in range [0,30]", 0 <= maxLevel && maxLevel <= 30);
     uassert(28741, "Geo coarsest level must be less than or equal to finest", minLevel <= maxLevel);
 
+    std::vector<S2CellId> cover;
+    S2CoveringCacheKey key{regionKey, minLevel, maxLevel, maxCells};
+    if (useCache && s2CoveringCache.find(key, &cover)) {
+        return cover;
+    }
+
     S2RegionCoverer coverer;
     coverer.set_min_level(minLevel);
     coverer.set_max_level(maxLevel);
-    coverer.set_max_cells(internalQueryS2GeoMaxCells.load());
-
-    std::vector<S2CellId> cover;
+    coverer.set_max_cells(maxCells);
     coverer.GetCovering(region, &cover);
+
+    if (useCache) {
+        s2CoveringCache.add(std::move(key), cover);
+    }
     return cover;
 }
+}  // namespace
+
+std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
+    return computeS2Covering(region, BSONObj(), false);
+}
+
+std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region,
+                                                             const BSONObj& regionKey) {
+    const bool useCache = !regionKey.isEmpty() && internalQueryS2GeoCacheCoverings.load();
+    return computeS2Covering(region, regionKey, useCache);
+}
+
+void ExpressionMapping::clear2dsphereCoveringCache() {
+    s2CoveringCache.clear();
+}
 
 void ExpressionMapping::cover2dsphere(const S2Region& region,
+                                      const BSONObj& regionKey,
                                       const S2IndexingParams& indexingParams,
                                       OrderedIntervalList* oilOut) {
-    std::vector<S2CellId> cover = get2dsphereCovering(region);
+    std::vector<S2CellId> cover = get2dsphereCovering(region, regionKey);
     S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
 }
 
@@ -64,6 +64,20 @@ public:
 
     static std::vector<S2CellId> get2dsphereCovering(const S2Region& region);
 
+    /**
+     * Like get2dsphereCovering(region), but first consults a process-wide LRU cache of coverings.
+     * 'regionKey' must be a BSON description that fully determines 'region', such as the geo
+     * predicate it was parsed from; the coarsest level, finest level, and maximum cell count in
+     * effect are added to the key. An empty 'regionKey' bypasses the cache.
+     */
+    static std::vector<S2CellId> get2dsphereCovering(const S2Region& region,
+                                                     const BSONObj& regionKey);
+
+    /**
+     * Drops every cached 2dsphere covering.
+     */
+    static void clear2dsphereCoveringCache();
+
     static void S2CellIdsToIntervals(const std::vector<S2CellId>& intervalSet,
                                      const S2IndexVersion indexVersion,
                                      OrderedIntervalList* oilOut);
@@ -75,6 +89,7 @@ public:
                                                 OrderedIntervalList* out);
 
     static void cover2dsphere(const S2Region& region,
+                              const BSONObj& regionKey,
                               const S2IndexingParams& indexParams,
                               OrderedIntervalList* oilOut);
 };
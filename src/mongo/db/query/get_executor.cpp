@@ -393,7 +393,8 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
                                                 canonicalQuery.get(),
                                                 plannerParams,
                                                 cs->decisionWorks,
-                                                rawRoot);
+                                                rawRoot,
+                                                cs->pinned);
             return PrepareExecutionResult(
                 std::move(canonicalQuery), std::move(querySolution), std::move(root));
         }
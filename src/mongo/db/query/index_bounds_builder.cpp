@@ -655,7 +655,7 @@ void IndexBoundsBuilder::translate(const MatchExpression* expr,
             const S2Region& region = gme->getGeoExpression().getGeometry().getS2Region();
             S2IndexingParams indexParams;
             ExpressionParams::initialize2dsphereParams(index.infoObj, index.collator, &indexParams);
-            ExpressionMapping::cover2dsphere(region, indexParams, oilOut);
+            ExpressionMapping::cover2dsphere(region, gme->getRawObj(), indexParams, oilOut);
             *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
         } else if (mongoutils::str::equals("2d", elt.valuestrsafe())) {
             verify(gme->getGeoExpression().getGeometry().hasR2Region());
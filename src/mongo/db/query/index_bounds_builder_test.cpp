@@ -39,6 +39,8 @@
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/expression_index.h"
 #include "mongo/unittest/unittest.h"
+#include "third_party/s2/s2cap.h"
+#include "third_party/s2/s2latlng.h"
 
 using namespace mongo;
 
@@ -2710,4 +2712,48 @@ TEST(IndexBoundsBuilderTest, IntersectizeBasic) {
     ASSERT_TRUE(oil2 == expectedIntersection);
 }
 
+TEST(IndexBoundsBuilderTest, TranslateGeoWithinOn2dsphereMatchesCachedCovering) {
+    ExpressionMapping::clear2dsphereCoveringCache();
+    IndexEntry testIndex = IndexEntry(BSON("a"
+                                           << "2dsphere"));
+    testIndex.infoObj = BSON("2dsphereIndexVersion" << 3);
+    BSONElement elt = testIndex.keyPattern.firstElement();
+    BSONObj obj = fromjson(
+        "{a: {$geoWithin: {$geometry: {type: 'Polygon', "
+        "coordinates: [[[0, 0], [0, 1], [1, 1], [1, 0], [0, 0]]]}}}}");
+    unique_ptr<MatchExpression> expr(parseMatchExpression(obj));
+
+    OrderedIntervalList computed;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &computed, &tightness);
+    ASSERT_FALSE(computed.intervals.empty());
+    ASSERT_EQUALS(tightness, IndexBoundsBuilder::INEXACT_FETCH);
+
+    OrderedIntervalList cached;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &cached, &tightness);
+    ASSERT_TRUE(computed == cached);
+}
+
+TEST(IndexBoundsBuilderTest, S2CoveringCacheIsKeyedByRegionKey) {
+    ExpressionMapping::clear2dsphereCoveringCache();
+    S2Point center = S2LatLng::FromDegrees(10, 10).ToPoint();
+    S2Cap small = S2Cap::FromAxisAngle(center, S1Angle::Degrees(0.1));
+    S2Cap large = S2Cap::FromAxisAngle(center, S1Angle::Degrees(10));
+    BSONObj key = BSON("cap" << 1);
+
+    std::vector<S2CellId> smallCover = ExpressionMapping::get2dsphereCovering(small);
+    std::vector<S2CellId> largeCover = ExpressionMapping::get2dsphereCovering(large);
+    ASSERT_TRUE(smallCover != largeCover);
+
+    // The key alone identifies the region, so a lookup with the same key is served the covering
+    // of the region it was first computed for.
+    ASSERT_TRUE(ExpressionMapping::get2dsphereCovering(small, key) == smallCover);
+    ASSERT_TRUE(ExpressionMapping::get2dsphereCovering(large, key) == smallCover);
+    ASSERT_TRUE(ExpressionMapping::get2dsphereCovering(large, BSONObj()) == largeCover);
+
+    ExpressionMapping::clear2dsphereCoveringCache();
+    ASSERT_TRUE(ExpressionMapping::get2dsphereCovering(large, key) == largeCover);
+    ExpressionMapping::clear2dsphereCoveringCache();
+}
+
 }  // namespace
@@ -38,10 +38,13 @@
 #include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
+#include "mongo/base/simple_string_data_comparator.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/client/dbclientinterface.h"  // For QueryOption_foobar
 #include "mongo/db/matcher/expression_array.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/plan_cache_store.h"
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_solution.h"
@@ -308,6 +311,84 @@ void encodeGeoNearMatchExpression(const GeoNearMatchExpression* tree, StringBuil
     }
 }
 
+// Stage name shown for the decision stats of entries restored from the PlanCacheStore, which only
+// keep the works and advanced counts of the winning plan.
+const char kPersistedPlanStageType[] = "PERSISTED_PLAN";
+
+double worksPerAdvanced(const CommonStats& stats) {
+    return static_cast<double>(stats.works) / std::max<size_t>(stats.advanced, 1);
+}
+
+/**
+ * Hashes the name, key pattern and spec of every index, independently of their order.
+ */
+long long computeIndexSetSignature(const std::vector<IndexEntry>& indexEntries) {
+    std::vector<std::string> descriptions;
+    descriptions.reserve(indexEntries.size());
+    for (const auto& ie : indexEntries) {
+        descriptions.push_back(str::stream() << ie.name << ie.keyPattern << ie.infoObj);
+    }
+    std::sort(descriptions.begin(), descriptions.end());
+
+    size_t hash = 0;
+    for (const auto& description : descriptions) {
+        SimpleStringDataComparator::kInstance.hash_combine(hash, description);
+    }
+    return static_cast<long long>(hash);
+}
+
+BSONObj persistedEntryToBSON(const PlanCacheEntry& entry, long long indexSetSignature) {
+    const CommonStats& stats = entry.decision->stats[0]->common;
+    BSONObjBuilder bob;
+    bob.append("indexSetSignature", indexSetSignature);
+    bob.append("query", entry.query);
+    bob.append("sort", entry.sort);
+    bob.append("projection", entry.projection);
+    bob.append("collation", entry.collation);
+    bob.append("timeOfCreation", entry.timeOfCreation);
+    bob.appendNumber("works", static_cast<long long>(stats.works));
+    bob.appendNumber("advanced", static_cast<long long>(stats.advanced));
+    bob.append("score", entry.decision->scores[0]);
+    bob.append("pinned", entry.pinned);
+    BSONObjBuilder planBob(bob.subobjStart("plan"));
+    entry.plannerData[0]->toBSON(&planBob);
+    planBob.doneFast();
+    return bob.obj();
+}
+
+/**
+ * Rebuilds a cache entry holding only the winning plan from the output of persistedEntryToBSON().
+ */
+StatusWith<std::unique_ptr<PlanCacheEntry>> persistedEntryFromBSON(
+    const BSONObj& obj, const std::vector<IndexEntry>& indexEntries) try {
+    auto swPlan = SolutionCacheData::fromBSON(obj["plan"].Obj(), indexEntries);
+    if (!swPlan.isOK()) {
+        return swPlan.getStatus();
+    }
+    QuerySolution qs;
+    qs.cacheData = std::move(swPlan.getValue());
+
+    CommonStats common(kPersistedPlanStageType);
+    common.works = obj["works"].safeNumberLong();
+    common.advanced = obj["advanced"].safeNumberLong();
+    auto decision = stdx::make_unique<PlanRankingDecision>();
+    decision->stats.push_back(stdx::make_unique<PlanStageStats>(common, STAGE_UNKNOWN));
+    decision->scores.push_back(obj["score"].numberDouble());
+    decision->candidateOrder.push_back(0);
+
+    auto entry = stdx::make_unique<PlanCacheEntry>(std::vector<QuerySolution*>{&qs},
+                                                   decision.release());
+    entry->query = obj["query"].Obj().getOwned();
+    entry->sort = obj["sort"].Obj().getOwned();
+    entry->projection = obj["projection"].Obj().getOwned();
+    entry->collation = obj["collation"].Obj().getOwned();
+    entry->timeOfCreation = obj["timeOfCreation"].Date();
+    entry->pinned = obj["pinned"].trueValue();
+    return {std::move(entry)};
+} catch (const DBException& ex) {
+    return ex.toStatus();
+}
+
 }  // namespace
 
 //
@@ -369,7 +450,8 @@ CachedSolution::CachedSolution(const PlanCacheKey& key, const PlanCacheEntry& en
       sort(entry.sort.getOwned()),
       projection(entry.projection.getOwned()),
       collation(entry.collation.getOwned()),
-      decisionWorks(entry.decision->stats[0]->common.works) {
+      decisionWorks(entry.decision->stats[0]->common.works),
+      pinned(entry.pinned) {
     // CachedSolution should not having any references into
     // cache entry. All relevant data should be cloned/copied.
     for (size_t i = 0; i < entry.plannerData.size(); ++i) {
@@ -432,6 +514,8 @@ PlanCacheEntry* PlanCacheEntry::clone() const {
     entry->projection = projection.getOwned();
     entry->collation = collation.getOwned();
     entry->timeOfCreation = timeOfCreation;
+    entry->pinned = pinned;
+    entry->driftingTrials = driftingTrials;
 
     // Copy performance stats.
     for (size_t i = 0; i < feedback.size(); ++i) {
@@ -516,6 +600,84 @@ std::string PlanCacheIndexTree::toString(int indents) const {
     return result.str();
 }
 
+void PlanCacheIndexTree::toBSON(BSONObjBuilder* bob) const {
+    if (entry) {
+        bob->append("index", entry->name);
+        bob->appendNumber("pos", static_cast<long long>(index_pos));
+        bob->append("canCombineBounds", canCombineBounds);
+    }
+    if (!orPushdowns.empty()) {
+        BSONArrayBuilder orPushdownsBob(bob->subarrayStart("orPushdowns"));
+        for (const auto& orPushdown : orPushdowns) {
+            BSONObjBuilder orPushdownBob(orPushdownsBob.subobjStart());
+            orPushdownBob.append("index", orPushdown.indexName);
+            orPushdownBob.appendNumber("pos", static_cast<long long>(orPushdown.position));
+            orPushdownBob.append("canCombineBounds", orPushdown.canCombineBounds);
+            BSONArrayBuilder routeBob(orPushdownBob.subarrayStart("route"));
+            for (auto position : orPushdown.route) {
+                routeBob.append(static_cast<long long>(position));
+            }
+        }
+    }
+    if (!children.empty()) {
+        BSONArrayBuilder childrenBob(bob->subarrayStart("children"));
+        for (const auto* child : children) {
+            BSONObjBuilder childBob(childrenBob.subobjStart());
+            child->toBSON(&childBob);
+        }
+    }
+}
+
+// static
+StatusWith<std::unique_ptr<PlanCacheIndexTree>> PlanCacheIndexTree::fromBSON(
+    const BSONObj& obj, const std::vector<IndexEntry>& indexEntries) try {
+    auto findIndex = [&](const std::string& name) -> const IndexEntry* {
+        for (const auto& ie : indexEntries) {
+            if (ie.name == name) {
+                return &ie;
+            }
+        }
+        return nullptr;
+    };
+
+    auto tree = stdx::make_unique<PlanCacheIndexTree>();
+    if (obj.hasField("index")) {
+        const IndexEntry* ie = findIndex(obj["index"].String());
+        if (!ie) {
+            return Status(ErrorCodes::IndexNotFound,
+                          str::stream() << "index " << obj["index"].String() << " not found");
+        }
+        tree->setIndexEntry(*ie);
+        tree->index_pos = obj["pos"].safeNumberLong();
+        tree->canCombineBounds = obj["canCombineBounds"].trueValue();
+    }
+    for (auto&& elem : obj["orPushdowns"].Array()) {
+        BSONObj orPushdownObj = elem.Obj();
+        OrPushdown orPushdown;
+        orPushdown.indexName = orPushdownObj["index"].String();
+        if (!findIndex(orPushdown.indexName)) {
+            return Status(ErrorCodes::IndexNotFound,
+                          str::stream() << "index " << orPushdown.indexName << " not found");
+        }
+        orPushdown.position = orPushdownObj["pos"].safeNumberLong();
+        orPushdown.canCombineBounds = orPushdownObj["canCombineBounds"].trueValue();
+        for (auto&& position : orPushdownObj["route"].Array()) {
+            orPushdown.route.push_back(position.safeNumberLong());
+        }
+        tree->orPushdowns.push_back(std::move(orPushdown));
+    }
+    for (auto&& elem : obj["children"].Array()) {
+        auto swChild = fromBSON(elem.Obj(), indexEntries);
+        if (!swChild.isOK()) {
+            return swChild.getStatus();
+        }
+        tree->children.push_back(swChild.getValue().release());
+    }
+    return {std::move(tree)};
+} catch (const DBException& ex) {
+    return ex.toStatus();
+}
+
 //
 // SolutionCacheData
 //
@@ -550,6 +712,42 @@ std::string SolutionCacheData::toString() const {
     MONGO_UNREACHABLE;
 }
 
+void SolutionCacheData::toBSON(BSONObjBuilder* bob) const {
+    bob->append("solnType", static_cast<int>(solnType));
+    bob->append("wholeIXSolnDir", wholeIXSolnDir);
+    bob->append("indexFilterApplied", indexFilterApplied);
+    if (tree) {
+        BSONObjBuilder treeBob(bob->subobjStart("tree"));
+        tree->toBSON(&treeBob);
+    }
+}
+
+// static
+StatusWith<std::unique_ptr<SolutionCacheData>> SolutionCacheData::fromBSON(
+    const BSONObj& obj, const std::vector<IndexEntry>& indexEntries) try {
+    auto scd = stdx::make_unique<SolutionCacheData>();
+    const int solnType = obj["solnType"].numberInt();
+    if (solnType < WHOLE_IXSCAN_SOLN || solnType > USE_INDEX_TAGS_SOLN) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "invalid cached solution type " << solnType);
+    }
+    scd->solnType = static_cast<SolutionType>(solnType);
+    scd->wholeIXSolnDir = obj["wholeIXSolnDir"].numberInt();
+    scd->indexFilterApplied = obj["indexFilterApplied"].trueValue();
+    if (obj.hasField("tree")) {
+        auto swTree = PlanCacheIndexTree::fromBSON(obj["tree"].Obj(), indexEntries);
+        if (!swTree.isOK()) {
+            return swTree.getStatus();
+        }
+        scd->tree = std::move(swTree.getValue());
+    } else if (scd->solnType != COLLSCAN_SOLN) {
+        return Status(ErrorCodes::BadValue, "cached index solution without a tree");
+    }
+    return {std::move(scd)};
+} catch (const DBException& ex) {
+    return ex.toStatus();
+}
+
 //
 // PlanCache
 //
@@ -747,14 +945,17 @@ Status PlanCache::add(const CanonicalQuery& query,
     }
     entry->projection = projBuilder.obj();
 
+    const PlanCacheKey key = computeKey(query);
     stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(computeKey(query), entry);
+    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(key, entry);
 
     if (NULL != evictedEntry.get()) {
         LOG(1) << _ns << ": plan cache maximum size exceeded - "
                << "removed least recently used entry " << redact(evictedEntry->toString());
     }
 
+    persistEntry(key, *entry);
+
     return Status::OK();
 }
 
@@ -790,6 +991,30 @@ Status PlanCache::feedback(const CanonicalQuery& cq, PlanCacheEntryFeedback* fee
     }
     invariant(entry);
 
+    if (entry->pinned) {
+        const PlanStageStats* trialStats = autoFeedback->stats->children.empty()
+            ? autoFeedback->stats.get()
+            : autoFeedback->stats->children[0].get();
+        const double baseline = worksPerAdvanced(entry->decision->stats[0]->common);
+        if (worksPerAdvanced(trialStats->common) >
+            baseline * internalQueryCachePinnedDriftRatio.load()) {
+            ++entry->driftingTrials;
+        } else {
+            entry->driftingTrials = 0;
+        }
+
+        if (entry->driftingTrials >= internalQueryCachePinnedDriftTrials.load()) {
+            LOG(1) << _ns << ": pinned plan drifted from its cached performance in "
+                   << entry->driftingTrials << " consecutive runs - evicting "
+                   << redact(entry->toString());
+            _cache.remove(ck).transitional_ignore();
+            if (!_ns.empty()) {
+                PlanCacheStore::get()->remove(_ns, ck);
+            }
+            return Status::OK();
+        }
+    }
+
     // We store up to a constant number of feedback entries.
     if (entry->feedback.size() < static_cast<size_t>(internalQueryCacheFeedbacksStored.load())) {
         entry->feedback.push_back(autoFeedback.release());
@@ -799,8 +1024,12 @@ Status PlanCache::feedback(const CanonicalQuery& cq, PlanCacheEntryFeedback* fee
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
+    const PlanCacheKey key = computeKey(canonicalQuery);
+    if (!_ns.empty()) {
+        PlanCacheStore::get()->remove(_ns, key);
+    }
     stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    return _cache.remove(key);
 }
 
 void PlanCache::clear() {
@@ -808,6 +1037,22 @@ void PlanCache::clear() {
     _cache.clear();
 }
 
+Status PlanCache::setPinned(const CanonicalQuery& cq, bool pinned) {
+    const PlanCacheKey key = computeKey(cq);
+    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    PlanCacheEntry* entry;
+    Status cacheStatus = _cache.get(key, &entry);
+    if (!cacheStatus.isOK()) {
+        return cacheStatus;
+    }
+    invariant(entry);
+
+    entry->pinned = pinned;
+    entry->driftingTrials = 0;
+    persistEntry(key, *entry);
+    return Status::OK();
+}
+
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
     StringBuilder keyBuilder;
     encodeKeyForMatch(cq.root(), &keyBuilder);
@@ -857,6 +1102,55 @@ size_t PlanCache::size() const {
 
 void PlanCache::notifyOfIndexEntries(const std::vector<IndexEntry>& indexEntries) {
     _indexabilityState.updateDiscriminators(indexEntries);
+    _indexSetSignature = computeIndexSetSignature(indexEntries);
+    if (!_ns.empty() && internalQueryCachePersistEntries.load()) {
+        restorePersistedEntries(indexEntries);
+    }
+}
+
+void PlanCache::persistEntry(const PlanCacheKey& key, const PlanCacheEntry& entry) const {
+    if (_ns.empty() || !internalQueryCachePersistEntries.load()) {
+        return;
+    }
+
+    // Index filters are not persisted, so neither are the plans they selected.
+    if (entry.plannerData[0]->indexFilterApplied) {
+        return;
+    }
+
+    PlanCacheStore::get()->save(_ns, key, persistedEntryToBSON(entry, _indexSetSignature));
+}
+
+void PlanCache::restorePersistedEntries(const std::vector<IndexEntry>& indexEntries) {
+    auto store = PlanCacheStore::get();
+    size_t numRestored = 0;
+    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    for (const auto& keyAndEntry : store->find(_ns)) {
+        const PlanCacheKey& key = keyAndEntry.first;
+        const BSONObj& obj = keyAndEntry.second;
+        if (obj["indexSetSignature"].safeNumberLong() != _indexSetSignature) {
+            // The entry was cached for indexes the collection no longer has.
+            store->remove(_ns, key);
+            continue;
+        }
+        if (_cache.hasKey(key)) {
+            continue;
+        }
+
+        auto swEntry = persistedEntryFromBSON(obj, indexEntries);
+        if (!swEntry.isOK()) {
+            LOG(1) << _ns << ": dropping persisted plan cache entry " << redact(obj) << ": "
+                   << swEntry.getStatus();
+            store->remove(_ns, key);
+            continue;
+        }
+        _cache.add(key, swEntry.getValue().release());
+        ++numRestored;
+    }
+
+    if (numRestored > 0) {
+        LOG(1) << _ns << ": restored " << numRestored << " persisted plan cache entries";
+    }
 }
 
 }  // namespace mongo
@@ -124,6 +124,18 @@ struct PlanCacheIndexTree {
      */
     std::string toString(int indents = 0) const;
 
+    /**
+     * Serializes the tree, referring to indexes by name, so that fromBSON() can restore it.
+     */
+    void toBSON(BSONObjBuilder* bob) const;
+
+    /**
+     * Restores a tree serialized by toBSON(), resolving index names against 'indexEntries'.
+     * Fails with IndexNotFound if the tree refers to an index which no longer exists.
+     */
+    static StatusWith<std::unique_ptr<PlanCacheIndexTree>> fromBSON(
+        const BSONObj& obj, const std::vector<IndexEntry>& indexEntries);
+
     // Children owned here.
     std::vector<PlanCacheIndexTree*> children;
 
@@ -159,6 +171,11 @@ struct SolutionCacheData {
     // For debugging.
     std::string toString() const;
 
+    // Serialization used to persist the plan cache. See PlanCacheIndexTree::toBSON().
+    void toBSON(BSONObjBuilder* bob) const;
+    static StatusWith<std::unique_ptr<SolutionCacheData>> fromBSON(
+        const BSONObj& obj, const std::vector<IndexEntry>& indexEntries);
+
     // Owned here. If 'wholeIXSoln' is false, then 'tree'
     // can be used to tag an isomorphic match expression. If 'wholeIXSoln'
     // is true, then 'tree' is used to store the relevant IndexEntry.
@@ -221,6 +238,9 @@ public:
     // The number of work cycles taken to decide on a winning plan when the plan was first
     // cached.
     size_t decisionWorks;
+
+    // Whether the plan is pinned, see PlanCacheEntry::pinned.
+    bool pinned;
 };
 
 /**
@@ -280,6 +300,16 @@ public:
     // Annotations from cached runs.  The CachedPlanStage provides these stats about its
     // runs when they complete.
     std::vector<PlanCacheEntryFeedback*> feedback;
+
+    // A pinned plan is not replanned when a trial run takes more works than expected. Instead
+    // the cache compares the works/advanced ratio of every trial with that of the original
+    // decision, and unpins and evicts the entry after internalQueryCachePinnedDriftTrials
+    // consecutive trials that are worse by more than internalQueryCachePinnedDriftRatio, so that
+    // the next run re-validates the plan.
+    bool pinned = false;
+
+    // The number of consecutive drifting trials of a pinned plan.
+    int driftingTrials = 0;
 };
 
 /**
@@ -361,9 +391,19 @@ public:
 
     /**
      * Remove *all* cached plans.  Does not clear index information.
+     *
+     * Persisted entries are kept, as the cache is also cleared whenever the collection's indexes
+     * change; the entries are dropped when notifyOfIndexEntries() finds them stale. Callers that
+     * want the plans gone for good must also remove them from the PlanCacheStore.
      */
     void clear();
 
+    /**
+     * Pins or unpins the cached plan of 'cq', see PlanCacheEntry::pinned. Returns an error Status
+     * if there is no entry for 'cq'.
+     */
+    Status setPinned(const CanonicalQuery& cq, bool pinned);
+
     /**
      * Get the cache key corresponding to the given canonical query.  The query need not already
      * be cached.
@@ -410,11 +450,22 @@ public:
      * Updates internal state kept about the collection's indexes.  Must be called when the set
      * of indexes on the associated collection have changed.
      *
+     * Also restores the entries persisted in the PlanCacheStore for this set of indexes, and drops
+     * the persisted entries that were cached for another set.
+     *
      * Callers must hold the collection lock in exclusive mode when calling this method.
      */
     void notifyOfIndexEntries(const std::vector<IndexEntry>& indexEntries);
 
 private:
+    /**
+     * Writes 'entry' through to the PlanCacheStore if persistence is enabled and the entry's
+     * winning plan can be restored later.
+     */
+    void persistEntry(const PlanCacheKey& key, const PlanCacheEntry& entry) const;
+
+    void restorePersistedEntries(const std::vector<IndexEntry>& indexEntries);
+
     void encodeKeyForMatch(const MatchExpression* tree, StringBuilder* keyBuilder) const;
     void encodeKeyForSort(const BSONObj& sortObj, StringBuilder* keyBuilder) const;
     void encodeKeyForProj(const BSONObj& projObj, StringBuilder* keyBuilder) const;
@@ -433,6 +484,10 @@ private:
     // Concurrent access is synchronized by the collection lock.  Multiple concurrent readers
     // are allowed.
     PlanCacheIndexabilityState _indexabilityState;
+
+    // Identifies the set of indexes the cached plans were chosen from. Persisted entries are only
+    // restored into a cache with the same signature.
+    long long _indexSetSignature = 0;
 };
 
 }  // namespace mongo
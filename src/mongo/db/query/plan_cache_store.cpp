@@ -0,0 +1,284 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cache_store.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "mongo/base/data_range_cursor.h"
+#include "mongo/base/data_type_validated.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/rpc/object_check.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/background.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+const char kNsField[] = "ns";
+const char kKeyField[] = "key";
+const char kEntryField[] = "entry";
+
+/**
+ * Flushes the file or directory at 'path' to disk.
+ */
+Status fsyncPath(const std::string& path) {
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return Status(ErrorCodes::FileOpenFailed,
+                      str::stream() << "Failed to open " << path << " to flush it: "
+                                    << errnoWithDescription());
+    }
+    const int ret = ::fsync(fd);
+    const int savedErrno = errno;
+    ::close(fd);
+    if (ret != 0) {
+        return Status(ErrorCodes::OperationFailed,
+                      str::stream() << "Failed to flush " << path << ": "
+                                    << errnoWithDescription(savedErrno));
+    }
+#endif
+    return Status::OK();
+}
+
+class PlanCacheStoreFlusher : public PeriodicTask {
+public:
+    explicit PlanCacheStoreFlusher(PlanCacheStore* store) : _store(store) {}
+
+    void taskDoWork() override {
+        Status status = _store->flush();
+        if (!status.isOK()) {
+            warning() << "Failed to persist the plan cache: " << status;
+        }
+    }
+
+    std::string taskName() const override {
+        return "PlanCacheStoreFlusher";
+    }
+
+private:
+    PlanCacheStore* const _store;
+};
+
+}  // namespace
+
+const char PlanCacheStore::kFileName[] = "plan_cache.bson";
+
+PlanCacheStore* PlanCacheStore::get() {
+    static PlanCacheStore store;
+    return &store;
+}
+
+PlanCacheStore::PlanCacheStore() = default;
+
+PlanCacheStore::~PlanCacheStore() = default;
+
+Status PlanCacheStore::open(const std::string& path) {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        invariant(_path.empty());
+        _path = path;
+    }
+    Status status = _load();
+    _flusher = stdx::make_unique<PlanCacheStoreFlusher>(this);
+    return status;
+}
+
+Status PlanCacheStore::_load() {
+    boost::filesystem::path path(_path);
+    if (!boost::filesystem::exists(path)) {
+        return Status::OK();
+    }
+
+    std::vector<char> buffer;
+    try {
+        buffer.resize(boost::filesystem::file_size(path));
+        std::ifstream ifs(_path.c_str(), std::ios_base::in | std::ios_base::binary);
+        ifs.read(buffer.data(), buffer.size());
+        if (!ifs) {
+            return Status(ErrorCodes::FileStreamFailed,
+                          str::stream() << "Unable to read BSON data from " << _path);
+        }
+    } catch (const std::exception& ex) {
+        return Status(ErrorCodes::FileStreamFailed,
+                      str::stream() << "Unexpected error reading BSON data from " << _path << ": "
+                                    << ex.what());
+    }
+
+    size_t numLoaded = 0;
+    ConstDataRangeCursor cursor(buffer.data(), buffer.data() + buffer.size());
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    while (cursor.length() > 0) {
+        auto swObj = cursor.readAndAdvance<Validated<BSONObj>>();
+        if (!swObj.isOK()) {
+            // Keep what was read so far; the remainder is rewritten on the next flush.
+            _dirty = true;
+            return swObj.getStatus().withContext(str::stream() << "Corrupt plan cache file "
+                                                               << _path);
+        }
+
+        BSONObj obj = swObj.getValue().val;
+        BSONElement ns = obj[kNsField];
+        BSONElement key = obj[kKeyField];
+        BSONElement entry = obj[kEntryField];
+        if (ns.type() != String || key.type() != String || entry.type() != Object) {
+            _dirty = true;
+            continue;
+        }
+        _entries[ns.valueStringData()][key.str()] = entry.Obj().getOwned();
+        ++numLoaded;
+    }
+
+    log() << "Loaded " << numLoaded << " plan cache entries from " << _path;
+    return Status::OK();
+}
+
+Status PlanCacheStore::flush() {
+    stdx::lock_guard<stdx::mutex> flushLock(_flushMutex);
+
+    // Serialize under the lock, write without it.
+    BufBuilder buffer;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        if (_path.empty() || !_dirty) {
+            return Status::OK();
+        }
+        for (auto&& collection : _entries) {
+            for (auto&& keyAndEntry : collection.second) {
+                BSONObjBuilder bob(buffer);
+                bob.append(kNsField, collection.first);
+                bob.append(kKeyField, keyAndEntry.first);
+                bob.append(kEntryField, keyAndEntry.second);
+            }
+        }
+        _dirty = false;
+    }
+
+    auto markDirty = [this] {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _dirty = true;
+    };
+
+    const std::string tempPath = _path + ".tmp";
+    {
+        std::ofstream ofs(tempPath.c_str(), std::ios_base::out | std::ios_base::binary);
+        ofs.write(buffer.buf(), buffer.len());
+        ofs.close();
+        if (!ofs) {
+            markDirty();
+            return Status(ErrorCodes::OperationFailed,
+                          str::stream() << "Failed to write BSON data to " << tempPath << ": "
+                                        << errnoWithDescription());
+        }
+    }
+
+    // The new file is on disk before the rename replaces the previous one atomically, and the
+    // directory is flushed after it, so a crash leaves either version intact.
+    Status status = fsyncPath(tempPath);
+    if (!status.isOK()) {
+        markDirty();
+        return status;
+    }
+    try {
+        boost::filesystem::rename(tempPath, _path);
+    } catch (const std::exception& ex) {
+        markDirty();
+        return Status(ErrorCodes::FileRenameFailed,
+                      str::stream() << "Unexpected error while renaming " << tempPath << " to "
+                                    << _path
+                                    << ": "
+                                    << ex.what());
+    }
+
+    const std::string directory = boost::filesystem::path(_path).parent_path().string();
+    status = fsyncPath(directory.empty() ? "." : directory);
+    if (!status.isOK()) {
+        markDirty();
+    }
+    return status;
+}
+
+void PlanCacheStore::save(StringData ns, const std::string& key, const BSONObj& entry) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto& entries = _entries[ns];
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        it->second = entry.getOwned();
+    } else {
+        // The plan cache of the collection is bounded by the same limit, so the store only fills
+        // up once the cache has started evicting, and dropping any entry is as good as another.
+        const auto maxEntries = static_cast<size_t>(std::max(internalQueryCacheSize.load(), 1));
+        while (entries.size() >= maxEntries) {
+            entries.erase(entries.begin());
+        }
+        entries.emplace(key, entry.getOwned());
+    }
+    _dirty = true;
+}
+
+void PlanCacheStore::remove(StringData ns, const std::string& key) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto collection = _entries.find(ns);
+    if (collection != _entries.end() && collection->second.erase(key)) {
+        if (collection->second.empty()) {
+            _entries.erase(collection);
+        }
+        _dirty = true;
+    }
+}
+
+void PlanCacheStore::removeAll(StringData ns) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (_entries.erase(ns)) {
+        _dirty = true;
+    }
+}
+
+std::vector<std::pair<std::string, BSONObj>> PlanCacheStore::find(StringData ns) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto collection = _entries.find(ns);
+    if (collection == _entries.end()) {
+        return {};
+    }
+    return {collection->second.begin(), collection->second.end()};
+}
+
+size_t PlanCacheStore::size() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    size_t size = 0;
+    for (auto&& collection : _entries) {
+        size += collection.second.size();
+    }
+    return size;
+}
+
+}  // namespace mongo
@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class PeriodicTask;
+
+/**
+ * Process-wide store of the plan cache entries of every collection, which lets the winning plans
+ * survive a restart. PlanCache writes an entry through to the store whenever it caches or evicts
+ * a plan, and reads the entries back when it learns about the collection's indexes.
+ *
+ * Entries live in memory and are written to a single BSON file by flush(), which runs
+ * periodically once open() was called and when the server shuts down. Since the entries only
+ * speed up planning, losing the latest changes on a crash is harmless.
+ *
+ * This class is thread-safe.
+ */
+class PlanCacheStore {
+    MONGO_DISALLOW_COPYING(PlanCacheStore);
+
+public:
+    // Name of the file, relative to the dbpath, that holds the persisted entries.
+    static const char kFileName[];
+
+    static PlanCacheStore* get();
+
+    PlanCacheStore();
+    ~PlanCacheStore();
+
+    /**
+     * Loads the entries persisted in the file at 'path' and starts writing them back there
+     * periodically. A missing file is not an error. Must be called at most once.
+     */
+    Status open(const std::string& path);
+
+    /**
+     * Writes all entries to the file passed to open() if they changed since the last flush. A
+     * no-op if the store was never opened.
+     */
+    Status flush();
+
+    /**
+     * Records 'entry' as the persisted form of the plan cache entry 'key' of collection 'ns',
+     * replacing any previous one. Each collection keeps at most internalQueryCacheSize entries.
+     */
+    void save(StringData ns, const std::string& key, const BSONObj& entry);
+
+    void remove(StringData ns, const std::string& key);
+
+    /**
+     * Removes the entries of collection 'ns'.
+     */
+    void removeAll(StringData ns);
+
+    /**
+     * Returns the persisted entries of collection 'ns' along with their plan cache keys.
+     */
+    std::vector<std::pair<std::string, BSONObj>> find(StringData ns) const;
+
+    /**
+     * Returns the number of persisted entries across all collections.
+     */
+    size_t size() const;
+
+private:
+    Status _load();
+
+    mutable stdx::mutex _mutex;
+
+    // Serializes flushes, which write the file outside of '_mutex'.
+    stdx::mutex _flushMutex;
+
+    // Entries by collection, then by plan cache key.
+    StringMap<std::map<std::string, BSONObj>> _entries;
+
+    // Whether '_entries' changed since the last flush.
+    bool _dirty = false;
+
+    // Empty until open() is called.
+    std::string _path;
+
+    // Calls flush() periodically once the store was opened.
+    std::unique_ptr<PeriodicTask> _flusher;
+};
+
+}  // namespace mongo
@@ -41,6 +41,7 @@
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/query/plan_cache_store.h"
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
@@ -1562,4 +1563,146 @@ TEST(PlanCacheTest, ComputeKeyCollationIndex) {
               planCache.computeKey(*inContainsStringHasCollation));
 }
 
+//
+// Persistence and pinning
+//
+
+/**
+ * Creates a solution whose cache data tags the first predicate with index 'indexEntry'.
+ */
+unique_ptr<QuerySolution> createIndexedSolution(const IndexEntry& indexEntry) {
+    auto qs = stdx::make_unique<QuerySolution>();
+    qs->cacheData.reset(new SolutionCacheData());
+    qs->cacheData->solnType = SolutionCacheData::USE_INDEX_TAGS_SOLN;
+    qs->cacheData->tree.reset(new PlanCacheIndexTree());
+    qs->cacheData->tree->setIndexEntry(indexEntry);
+    return qs;
+}
+
+PlanRankingDecision* createDecisionWithStats(size_t works, size_t advanced) {
+    PlanRankingDecision* why = createDecision(1U);
+    why->stats[0]->common.works = works;
+    why->stats[0]->common.advanced = advanced;
+    return why;
+}
+
+PlanCacheEntryFeedback* createFeedback(size_t works, size_t advanced) {
+    auto feedback = stdx::make_unique<PlanCacheEntryFeedback>();
+    CommonStats common("COLLSCAN");
+    common.works = works;
+    common.advanced = advanced;
+    feedback->stats = stdx::make_unique<PlanStageStats>(common, STAGE_COLLSCAN);
+    feedback->score = 0;
+    return feedback.release();
+}
+
+TEST(PlanCacheTest, IndexTreeRoundTripsThroughBSON) {
+    const std::vector<IndexEntry> indexEntries{IndexEntry(BSON("a" << 1), "a_1"),
+                                               IndexEntry(BSON("b" << 1 << "c" << 1), "b_1_c_1")};
+
+    PlanCacheIndexTree tree;
+    auto child = stdx::make_unique<PlanCacheIndexTree>();
+    child->setIndexEntry(indexEntries[1]);
+    child->index_pos = 1;
+    child->canCombineBounds = false;
+    PlanCacheIndexTree::OrPushdown orPushdown{"a_1", 0, true, {1, 0}};
+    child->orPushdowns.push_back(orPushdown);
+    tree.children.push_back(child.release());
+    tree.children.push_back(new PlanCacheIndexTree());
+
+    BSONObjBuilder bob;
+    tree.toBSON(&bob);
+    auto swTree = PlanCacheIndexTree::fromBSON(bob.obj(), indexEntries);
+    ASSERT_OK(swTree.getStatus());
+    ASSERT_EQ(tree.toString(), swTree.getValue()->toString());
+
+    // The tree cannot be restored once an index it refers to is gone.
+    BSONObjBuilder missingBob;
+    tree.toBSON(&missingBob);
+    auto swMissing = PlanCacheIndexTree::fromBSON(missingBob.obj(), {indexEntries[1]});
+    ASSERT_EQ(ErrorCodes::IndexNotFound, swMissing.getStatus());
+}
+
+TEST(PlanCacheTest, PersistedEntryIsRestoredForSameIndexes) {
+    PlanCacheStore::get()->removeAll(nss.ns());
+    ON_BLOCK_EXIT([] { PlanCacheStore::get()->removeAll(nss.ns()); });
+
+    const std::vector<IndexEntry> indexEntries{IndexEntry(BSON("a" << 1), "a_1")};
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+    QueryTestServiceContext serviceContext;
+    {
+        PlanCache planCache(nss.ns());
+        planCache.notifyOfIndexEntries(indexEntries);
+        auto qs = createIndexedSolution(indexEntries[0]);
+        ASSERT_OK(planCache.add(*cq, {qs.get()}, createDecisionWithStats(7, 2), Date_t{}));
+        ASSERT_OK(planCache.setPinned(*cq, true));
+    }
+    ASSERT_EQ(1U, PlanCacheStore::get()->find(nss.ns()).size());
+
+    PlanCache restored(nss.ns());
+    restored.notifyOfIndexEntries(indexEntries);
+    ASSERT_TRUE(restored.contains(*cq));
+
+    CachedSolution* rawCs;
+    ASSERT_OK(restored.get(*cq, &rawCs));
+    unique_ptr<CachedSolution> cs(rawCs);
+    ASSERT_EQ(7U, cs->decisionWorks);
+    ASSERT_TRUE(cs->pinned);
+    ASSERT_EQ(1U, cs->plannerData.size());
+    ASSERT_EQ("a_1", cs->plannerData[0]->tree->entry->name);
+
+    // A different set of indexes leads to different plans, so the entry is dropped.
+    PlanCache reindexed(nss.ns());
+    reindexed.notifyOfIndexEntries({IndexEntry(BSON("a" << 1 << "b" << 1), "a_1_b_1")});
+    ASSERT_FALSE(reindexed.contains(*cq));
+    ASSERT_TRUE(PlanCacheStore::get()->find(nss.ns()).empty());
+}
+
+TEST(PlanCacheTest, RemovedEntryIsNotRestored) {
+    PlanCacheStore::get()->removeAll(nss.ns());
+    ON_BLOCK_EXIT([] { PlanCacheStore::get()->removeAll(nss.ns()); });
+
+    const std::vector<IndexEntry> indexEntries{IndexEntry(BSON("a" << 1), "a_1")};
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+    QueryTestServiceContext serviceContext;
+    PlanCache planCache(nss.ns());
+    planCache.notifyOfIndexEntries(indexEntries);
+    auto qs = createIndexedSolution(indexEntries[0]);
+    ASSERT_OK(planCache.add(*cq, {qs.get()}, createDecisionWithStats(7, 2), Date_t{}));
+    ASSERT_OK(planCache.remove(*cq));
+
+    PlanCache restored(nss.ns());
+    restored.notifyOfIndexEntries(indexEntries);
+    ASSERT_FALSE(restored.contains(*cq));
+}
+
+TEST(PlanCacheTest, PinnedPlanIsEvictedAfterConsecutiveDriftingTrials) {
+    PlanCacheStore::get()->removeAll(nss.ns());
+    ON_BLOCK_EXIT([] { PlanCacheStore::get()->removeAll(nss.ns()); });
+
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+    QueryTestServiceContext serviceContext;
+    PlanCache planCache(nss.ns());
+    auto qs = createIndexedSolution(IndexEntry(BSON("a" << 1), "a_1"));
+    ASSERT_OK(planCache.add(*cq, {qs.get()}, createDecisionWithStats(10, 10), Date_t{}));
+    ASSERT_OK(planCache.setPinned(*cq, true));
+
+    const int driftTrials = internalQueryCachePinnedDriftTrials.load();
+    ASSERT_GT(driftTrials, 1);
+
+    // A trial that performs as expected resets the count of drifting trials.
+    for (int i = 0; i < driftTrials - 1; ++i) {
+        ASSERT_OK(planCache.feedback(*cq, createFeedback(1000, 1)));
+    }
+    ASSERT_OK(planCache.feedback(*cq, createFeedback(10, 10)));
+    for (int i = 0; i < driftTrials - 1; ++i) {
+        ASSERT_OK(planCache.feedback(*cq, createFeedback(1000, 1)));
+    }
+    ASSERT_TRUE(planCache.contains(*cq));
+
+    ASSERT_OK(planCache.feedback(*cq, createFeedback(1000, 1)));
+    ASSERT_FALSE(planCache.contains(*cq));
+    ASSERT_TRUE(PlanCacheStore::get()->find(nss.ns()).empty());
+}
+
 }  // namespace
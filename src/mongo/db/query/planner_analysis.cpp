@@ -610,6 +610,14 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         sort->limit = 0;
     }
 
+    // A limited sort on the text score alone only needs the highest scoring documents from a TEXT
+    // stage that feeds it directly, without any stage in between that could drop documents.
+    QuerySolutionNode* sortInput = keyGenNode->children[0];
+    if (sort->limit && STAGE_TEXT == sortInput->getType() && 1 == sortObj.nFields() &&
+        QueryRequest::isTextScoreMeta(sortObj.firstElement())) {
+        static_cast<TextNode*>(sortInput)->topK = sort->limit;
+    }
+
     *blockingSortOut = true;
 
     return solnRoot;
@@ -72,6 +72,17 @@ extern AtomicInt32 internalQueryCacheFeedbacksStored;
 // and replanning?
 extern AtomicDouble internalQueryCacheEvictionRatio;
 
+// Write plan cache entries through to the PlanCacheStore, which persists them across restarts, and
+// restore them when a collection's plan cache is created.
+extern AtomicBool internalQueryCachePersistEntries;
+
+// A trial run of a pinned plan drifts when its works/advanced ratio exceeds that of the original
+// decision by this factor.
+extern AtomicDouble internalQueryCachePinnedDriftRatio;
+
+// How many consecutive drifting trials unpin and evict a pinned plan?
+extern AtomicInt32 internalQueryCachePinnedDriftTrials;
+
 //
 // Planning and enumeration.
 //
@@ -98,12 +109,24 @@ extern AtomicBool internalQueryPlannerGenerateCoveredWholeIndexScans;
 // Ignore unknown JSON Schema keywords.
 extern AtomicBool internalQueryIgnoreUnknownJSONSchemaKeywords;
 
+// Evaluate supported collection scan and fetch filters with a CompiledFilter, which resolves every
+// referenced path in a single pass over the document.
+extern AtomicBool internalQueryEnableCompiledFilters;
+
 //
 // Query execution.
 //
 
 extern AtomicInt32 internalQueryExecMaxBlockingSortBytes;
 
+// The number of runs an external $sort may sort and spill in the background while it consumes
+// its input. 0 spills on the thread running the query.
+extern AtomicInt32 internalQueryExecSorterSpillThreads;
+
+// Let a SortStage with a limit pass the sort key of its k-th best document down to the
+// CollectionScan feeding it, which then drops documents that cannot make the cut.
+extern AtomicBool internalQueryExecEnableTopKThreshold;
+
 // Yield after this many "should yield?" checks.
 extern AtomicInt32 internalQueryExecYieldIterations;
 
@@ -122,5 +145,13 @@ extern AtomicInt32 internalDocumentSourceCursorBatchSizeBytes;
 
 extern AtomicInt32 internalDocumentSourceLookupCacheSizeBytes;
 
+// The maximum number of input documents a localField/foreignField $lookup joins with a single query
+// against the foreign collection. A value of 1 or less disables batching.
+extern AtomicInt32 internalDocumentSourceLookupBatchSize;
+
+// The maximum number of input documents an unsorted $group evaluates its _id and accumulator
+// expressions over at once. A value of 1 or less evaluates them one document at a time.
+extern AtomicInt32 internalDocumentSourceGroupBatchSize;
+
 extern AtomicBool internalQueryProhibitBlockingMergeOnMongoS;
 }  // namespace mongo
@@ -472,6 +472,60 @@ TEST_F(QueryPlannerTest, SortKeyMetaProjectionWithTextScoreMetaSort) {
         "{sortKeyGen: {node: {text: {search: 'foo'}}}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, LimitedTextScoreSortSetsTopKOnTextNode) {
+    addIndex(BSON("_fts"
+                  << "text"
+                  << "_ftsx"
+                  << 1));
+
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {$text: {$search: 'foo bar'}}, "
+                 "projection: {score: {$meta: 'textScore'}}, sort: {score: {$meta: 'textScore'}}, "
+                 "skip: 2, limit: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {score: {$meta: 'textScore'}}, node: {skip: {n: 2, node: "
+        "{sort: {limit: 7, pattern: {score: {$meta: 'textScore'}}, node: "
+        "{sortKeyGen: {node: {text: {search: 'foo bar', topK: 7}}}}}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, UnlimitedTextScoreSortDoesNotSetTopK) {
+    addIndex(BSON("_fts"
+                  << "text"
+                  << "_ftsx"
+                  << 1));
+
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {$text: {$search: 'foo'}}, "
+                 "projection: {score: {$meta: 'textScore'}}, "
+                 "sort: {score: {$meta: 'textScore'}}}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {score: {$meta: 'textScore'}}, node: "
+        "{sort: {limit: 0, pattern: {score: {$meta: 'textScore'}}, node: "
+        "{sortKeyGen: {node: {text: {search: 'foo', topK: 0}}}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, LimitedCompoundSortWithTextScoreDoesNotSetTopK) {
+    addIndex(BSON("_fts"
+                  << "text"
+                  << "_ftsx"
+                  << 1));
+
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {$text: {$search: 'foo'}}, "
+                 "projection: {score: {$meta: 'textScore'}}, "
+                 "sort: {score: {$meta: 'textScore'}, a: 1}, limit: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {score: {$meta: 'textScore'}}, node: "
+        "{sort: {limit: 5, pattern: {score: {$meta: 'textScore'}, a: 1}, node: "
+        "{sortKeyGen: {node: {text: {search: 'foo', topK: 0}}}}}}}}");
+}
+
 TEST_F(QueryPlannerTest, PredicatesOverLeadingFieldsWithSharedPathPrefixHandledCorrectly) {
     const bool multikey = true;
     addIndex(BSON("a.x" << 1 << "a.y" << 1 << "b.x" << 1 << "b.y" << 1 << "_fts"
@@ -261,6 +261,10 @@ struct TextNode : public QuerySolutionNode {
     // text node while creating the text leaf node and convert them into a BSONObj index prefix
     // when we finish the text leaf node.
     BSONObj indexPrefix;
+
+    // Set when the results are sorted by text score and limited, in which case only this many of
+    // the highest scoring documents are needed. Zero means that all documents are needed.
+    size_t topK = 0;
 };
 
 struct CollectionScanNode : public QuerySolutionNode {
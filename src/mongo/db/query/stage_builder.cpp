@@ -287,6 +287,7 @@ PlanStage* buildStages(OperationContext* opCtx,
             // fail in this case (this improvement is being tracked by SERVER-21510).
             params.query = static_cast<FTSQueryImpl&>(*node->ftsQuery);
             params.wantTextScore = (cq.getProj() && cq.getProj()->wantTextScore());
+            params.topK = node->topK;
             return new TextStage(opCtx, params, ws, node->filter.get());
         }
         case STAGE_SHARDING_FILTER: {
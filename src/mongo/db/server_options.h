@@ -82,6 +82,7 @@ struct ServerGlobalParams {
     bool enableCoroutine{true};
     size_t reservedThreadNum = 1;
     size_t adaptiveThreadNum = 1;
+    bool pipelineReadAhead = false;  // --pipelineReadAhead
 
     bool bootstrap{false};
 
@@ -142,6 +142,13 @@ Status addGeneralServerOptions(moe::OptionSection* options) {
                                "eloqAdaptiveThreadNum",
                                moe::Unsigned,
                                "set the thread num for adaptive service executor mode");
+    options
+        ->addOptionChaining("net.pipelineReadAhead",
+                            "pipelineReadAhead",
+                            moe::Bool,
+                            "read the next request from a connection while the current one is "
+                            "being processed")
+        .setDefault(moe::Value(false));
     options
         ->addOptionChaining(
             "storage.eloq.bootstrap", "eloqBootstrap", moe::Bool, "Bootstrap the Eloq cluster.")
@@ -592,6 +599,10 @@ Status storeServerOptions(const moe::Environment& params) {
         }
     }
 
+    if (params.count("net.pipelineReadAhead")) {
+        serverGlobalParams.pipelineReadAhead = params["net.pipelineReadAhead"].as<bool>();
+    }
+
     if (params.count("storage.eloq.bootstrap")) {
         serverGlobalParams.bootstrap = params["storage.eloq.bootstrap"].as<bool>();
         if (serverGlobalParams.bootstrap) {
@@ -59,8 +59,12 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/future.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/bufreader.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/destructor_guard.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/unowned_ptr.h"
@@ -102,6 +106,24 @@ void dassertCompIsSane(const Comparator& comp, const Data& lhs, const Data& rhs)
 #endif
 }
 
+/**
+ * The threads that sort and write runs in the background, shared by all sorters so that a spill
+ * does not start a thread of its own. Never destroyed, since sorters may still be spilling when
+ * static objects are.
+ */
+inline ThreadPool* spillThreadPool() {
+    static ThreadPool* const pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "SorterSpill";
+        options.minThreads = 0;
+        options.maxThreads = std::max(1U, stdx::thread::hardware_concurrency());
+        auto pool = new ThreadPool(std::move(options));
+        pool->startup();
+        return pool;
+    }();
+    return pool;
+}
+
 /** Ensures a named file is deleted when this object goes out of scope */
 class FileDeleter {
 public:
@@ -272,7 +294,14 @@ private:
     std::ifstream _file;
 };
 
-/** Merge-sorts results from 0 or more FileIterators */
+/**
+ * Merge-sorts results from 0 or more FileIterators.
+ *
+ * The inputs are merged with a tournament (loser) tree: each internal node remembers the loser
+ * of the match played there and the overall winner is kept in _tree[0]. Replacing the winner
+ * only replays the matches on the path from its leaf to the root, which takes log2(k)
+ * comparisons rather than the ~2*log2(k) of sifting a binary heap.
+ */
 template <typename Key, typename Value, typename Comparator>
 class MergeIterator : public SortIteratorInterface<Key, Value> {
 public:
@@ -286,32 +315,46 @@ public:
         : _opts(opts),
           _remaining(opts.limit ? opts.limit : std::numeric_limits<unsigned long long>::max()),
           _first(true),
-          _greater(comp) {
+          _live(0),
+          _comp(comp) {
         for (size_t i = 0; i < iters.size(); i++) {
             if (iters[i]->more()) {
-                _heap.push_back(std::make_shared<Stream>(i, iters[i]->next(), iters[i]));
+                _streams.push_back(stdx::make_unique<Stream>(i, iters[i]->next(), iters[i]));
             }
         }
 
-        if (_heap.empty()) {
+        _live = _streams.size();
+        if (_streams.empty()) {
             _remaining = 0;
             return;
         }
 
-        std::make_heap(_heap.begin(), _heap.end(), _greater);
-        std::pop_heap(_heap.begin(), _heap.end(), _greater);
-        _current = _heap.back();
-        _heap.pop_back();
+        // Leaf i of the tree is node k + i and the parent of node n is n / 2. Play every match
+        // bottom up, storing the loser in the node and passing the winner to the parent.
+        const size_t k = _streams.size();
+        std::vector<size_t> winners(2 * k);
+        for (size_t i = 0; i < k; i++) {
+            winners[k + i] = i;
+        }
+        _tree.resize(k);
+        for (size_t node = k - 1; node >= 1; node--) {
+            const size_t lhs = winners[2 * node];
+            const size_t rhs = winners[2 * node + 1];
+            const bool lhsWins = beats(lhs, rhs);
+            winners[node] = lhsWins ? lhs : rhs;
+            _tree[node] = lhsWins ? rhs : lhs;
+        }
+        _tree[0] = k == 1 ? 0 : winners[1];
     }
 
     bool more() {
-        if (_remaining > 0 && (_first || !_heap.empty() || _current->more()))
+        if (_remaining > 0 && (_first || _live > 1 || _streams[_tree[0]]->more()))
             return true;
 
         // We are done so clean up resources.
         // Can't do this in next() due to lifetime guarantees of unowned Data.
-        _heap.clear();
-        _current.reset();
+        _streams.clear();
+        _tree.clear();
         _remaining = 0;
 
         return false;
@@ -324,22 +367,26 @@ public:
 
         if (_first) {
             _first = false;
-            return _current->current();
+            return _streams[_tree[0]]->current();
         }
 
-        if (!_current->advance()) {
-            verify(!_heap.empty());
+        // Advance the stream that produced the previous result and replay its matches.
+        const size_t leaf = _tree[0];
+        if (!_streams[leaf]->advance()) {
+            _streams[leaf]->exhausted = true;
+            _live--;
+            verify(_live > 0);
+        }
 
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            _current = _heap.back();
-            _heap.pop_back();
-        } else if (!_heap.empty() && _greater(_current, _heap.front())) {
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            std::swap(_current, _heap.back());
-            std::push_heap(_heap.begin(), _heap.end(), _greater);
+        size_t winner = leaf;
+        for (size_t node = (_tree.size() + leaf) / 2; node >= 1; node /= 2) {
+            if (beats(_tree[node], winner)) {
+                std::swap(_tree[node], winner);
+            }
         }
+        _tree[0] = winner;
 
-        return _current->current();
+        return _streams[winner]->current();
     }
 
 
@@ -364,36 +411,40 @@ private:
         }
 
         const size_t fileNum;
+        bool exhausted = false;
 
     private:
         Data _current;
         std::shared_ptr<Input> _rest;
     };
 
-    class STLComparator {  // uses greater rather than less-than to maintain a MinHeap
-    public:
-        explicit STLComparator(const Comparator& comp) : _comp(comp) {}
-        bool operator()(unowned_ptr<const Stream> lhs, unowned_ptr<const Stream> rhs) const {
-            // first compare data
-            dassertCompIsSane(_comp, lhs->current(), rhs->current());
-            int ret = _comp(lhs->current(), rhs->current());
-            if (ret)
-                return ret > 0;
-
-            // then compare fileNums to ensure stability
-            return lhs->fileNum > rhs->fileNum;
-        }
-
-    private:
-        const Comparator _comp;
-    };
+    /**
+     * Returns true if stream 'lhs' should be output before stream 'rhs'. Exhausted streams lose
+     * every match.
+     */
+    bool beats(size_t lhs, size_t rhs) const {
+        const Stream& left = *_streams[lhs];
+        const Stream& right = *_streams[rhs];
+        if (left.exhausted || right.exhausted)
+            return !left.exhausted;
+
+        // first compare data
+        dassertCompIsSane(_comp, left.current(), right.current());
+        int ret = _comp(left.current(), right.current());
+        if (ret)
+            return ret < 0;
+
+        // then compare fileNums to ensure stability
+        return left.fileNum < right.fileNum;
+    }
 
     SortOptions _opts;
     unsigned long long _remaining;
     bool _first;
-    std::shared_ptr<Stream> _current;
-    std::vector<std::shared_ptr<Stream>> _heap;  // MinHeap
-    STLComparator _greater;                      // named so calls make sense
+    size_t _live;  // number of streams that are not exhausted
+    std::vector<std::unique_ptr<Stream>> _streams;
+    std::vector<size_t> _tree;  // _tree[0] is the winner, other nodes hold the loser of a match
+    const Comparator _comp;
 };
 
 template <typename Key, typename Value, typename Comparator>
@@ -408,33 +459,47 @@ public:
     NoLimitSorter(const SortOptions& opts,
                   const Comparator& comp,
                   const Settings& settings = Settings())
-        : _comp(comp), _settings(settings), _opts(opts), _memUsed(0) {
+        : _comp(comp),
+          _settings(settings),
+          _opts(opts),
+          _memUsed(0),
+          _spillThresholdBytes(opts.maxMemoryUsageBytes) {
         verify(_opts.limit == 0);
     }
 
+    ~NoLimitSorter() {
+        // The background spills use this sorter's state.
+        for (auto& spilled : _pendingSpills) {
+            spilled.wait();
+        }
+    }
+
     void add(const Key& key, const Value& val) {
         _data.push_back(std::make_pair(key, val));
 
         _memUsed += key.memUsageForSorter();
         _memUsed += val.memUsageForSorter();
 
-        if (_memUsed > _opts.maxMemoryUsageBytes)
+        if (_memUsed > _spillThresholdBytes)
             spill();
     }
 
     Iterator* done() {
-        if (_iters.empty()) {
-            sort();
+        if (_iters.empty() && _pendingSpills.empty()) {
+            sort(_data);
             return new InMemIterator<Key, Value>(_data);
         }
 
         spill();
+        while (!_pendingSpills.empty()) {
+            waitForOldestSpill();
+        }
         return Iterator::merge(_iters, _opts, _comp);
     }
 
     // TEMP these are here for compatibility. Will be replaced with a general stats API
     int numFiles() const {
-        return _iters.size();
+        return _iters.size() + _pendingSpills.size();
     }
     size_t memUsed() const {
         return _memUsed;
@@ -453,13 +518,38 @@ private:
         const Comparator& _comp;
     };
 
-    void sort() {
+    void sort(std::deque<Data>& data) const {
         STLComparator less(_comp);
-        std::stable_sort(_data.begin(), _data.end(), less);
+        std::stable_sort(data.begin(), data.end(), less);
 
         // Does 2x more compares than stable_sort
         // TODO test on windows
-        // std::sort(_data.begin(), _data.end(), comp);
+        // std::sort(data.begin(), data.end(), comp);
+    }
+
+    /**
+     * Sorts 'data' and writes it to a new file. May run on a background thread, so it only reads
+     * state that is immutable after construction.
+     */
+    std::shared_ptr<Iterator> sortAndWrite(std::deque<Data> data) const {
+        sort(data);
+
+        SortedFileWriter<Key, Value> writer(_opts, _settings);
+        for (; !data.empty(); data.pop_front()) {
+            writer.addAlreadySorted(data.front().first, data.front().second);
+        }
+
+        return std::shared_ptr<Iterator>(writer.done());
+    }
+
+    /**
+     * Waits for the oldest background spill and appends its file to '_iters'. Spills complete in
+     * the order they were started so that the merge stays stable.
+     */
+    void waitForOldestSpill() {
+        auto spilled = std::move(_pendingSpills.front());
+        _pendingSpills.pop_front();
+        _iters.push_back(spilled.get());
     }
 
     void spill() {
@@ -479,24 +569,44 @@ private:
                           << " Pass allowDiskUse:true to opt in.");
         }
 
-        sort();
+        _memUsed = 0;
 
-        SortedFileWriter<Key, Value> writer(_opts, _settings);
-        for (; !_data.empty(); _data.pop_front()) {
-            writer.addAlreadySorted(_data.front().first, _data.front().second);
-        }
+        // The first run is spilled on the calling thread, so a sort that spills once or not at
+        // all gets the whole memory budget.
+        if (_opts.spillThreads == 0 || (_iters.empty() && _pendingSpills.empty())) {
+            _iters.push_back(sortAndWrite(std::move(_data)));
+            _data.clear();
 
-        _iters.push_back(std::shared_ptr<Iterator>(writer.done()));
+            // Runs being spilled in the background still hold their memory, so split the
+            // budget between them and the run currently being filled.
+            _spillThresholdBytes = _opts.maxMemoryUsageBytes / (_opts.spillThreads + 1);
+            return;
+        }
 
-        _memUsed = 0;
+        // Sort and write this run in the background while the caller keeps adding data. Errors
+        // are rethrown from waitForOldestSpill().
+        if (_pendingSpills.size() >= _opts.spillThreads) {
+            waitForOldestSpill();
+        }
+        auto task = std::make_shared<stdx::packaged_task<std::shared_ptr<Iterator>()>>(
+            [ this, data = std::move(_data) ]() mutable { return sortAndWrite(std::move(data)); });
+        _data.clear();
+        _pendingSpills.push_back(task->get_future());
+        if (!spillThreadPool()->schedule([task] { (*task)(); }).isOK()) {
+            (*task)();
+        }
     }
 
     const Comparator _comp;
     const Settings _settings;
     SortOptions _opts;
     size_t _memUsed;
+    size_t _spillThresholdBytes;
     std::deque<Data> _data;                         // the "current" data
     std::vector<std::shared_ptr<Iterator>> _iters;  // data that has already been spilled
+
+    // Runs being sorted and spilled in the background, oldest first.
+    std::deque<stdx::future<std::shared_ptr<Iterator>>> _pendingSpills;
 };
 
 template <typename Key, typename Value, typename Comparator>
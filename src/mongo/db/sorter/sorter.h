@@ -98,8 +98,12 @@ struct SortOptions {
     bool extSortAllowed;         /// If false, uassert if more mem needed than allowed.
     std::string tempDir;         /// Directory to directly place files in.
                                  /// Must be explicitly set if extSortAllowed is true.
+    size_t spillThreads;         /// Max number of runs sorted and spilled in the background
+                                 /// while more data is added. 0 spills on the calling thread.
+                                 /// Only used when there is no limit.
 
-    SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
+    SortOptions()
+        : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false), spillThreads(0) {}
 
     /// Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -122,6 +126,11 @@ struct SortOptions {
         tempDir = newTempDir;
         return *this;
     }
+
+    SortOptions& SpillThreads(size_t newSpillThreads) {
+        spillThreads = newSpillThreads;
+        return *this;
+    }
 };
 
 /// This is the output from the sorting framework
@@ -0,0 +1,163 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <boost/filesystem/operations.hpp>
+#include <random>
+
+#include "mongo/base/data_type_endian.h"
+#include "mongo/db/sorter/sorter.h"
+
+// Need access to internal classes
+#include "mongo/db/sorter/sorter.cpp"
+
+namespace mongo {
+namespace {
+
+class IntWrapper {
+public:
+    IntWrapper(int i = 0) : _i(i) {}
+    operator const int&() const {
+        return _i;
+    }
+
+    /// members for Sorter
+    struct SorterDeserializeSettings {};  // unused
+    void serializeForSorter(BufBuilder& buf) const {
+        buf.appendNum(_i);
+    }
+    static IntWrapper deserializeForSorter(BufReader& buf, const SorterDeserializeSettings&) {
+        return buf.read<LittleEndian<int>>().value;
+    }
+    int memUsageForSorter() const {
+        return sizeof(IntWrapper);
+    }
+    IntWrapper getOwned() const {
+        return *this;
+    }
+
+private:
+    int _i;
+};
+
+typedef std::pair<IntWrapper, IntWrapper> IWPair;
+typedef SortIteratorInterface<IntWrapper, IntWrapper> IWIterator;
+typedef Sorter<IntWrapper, IntWrapper> IWSorter;
+
+class IWComparator {
+public:
+    int operator()(const IWPair& lhs, const IWPair& rhs) const {
+        if (lhs.first == rhs.first)
+            return 0;
+        return lhs.first < rhs.first ? -1 : 1;
+    }
+};
+
+std::vector<int> makeRandomInts(size_t count) {
+    std::mt19937 gen(42);
+    std::vector<int> values(count);
+    for (auto& value : values) {
+        value = gen();
+    }
+    return values;
+}
+
+/**
+ * Creates a fresh directory for spill files and removes it when going out of scope.
+ */
+class ScopedSpillDir {
+public:
+    ScopedSpillDir()
+        : _path(boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path("sorter_bm-%%%%-%%%%-%%%%")) {
+        boost::filesystem::create_directories(_path);
+    }
+    ~ScopedSpillDir() {
+        boost::filesystem::remove_all(_path);
+    }
+
+    std::string path() const {
+        return _path.string();
+    }
+
+private:
+    const boost::filesystem::path _path;
+};
+
+// Merges state.range(0) sorted in-memory runs of 1M values in total.
+void BM_MergeIterator(benchmark::State& state) {
+    const size_t numRuns = state.range(0);
+    const size_t totalValues = 1024 * 1024;
+    const auto values = makeRandomInts(totalValues);
+
+    std::vector<std::vector<IWPair>> runs(numRuns);
+    for (size_t i = 0; i < values.size(); i++) {
+        runs[i % numRuns].emplace_back(values[i], 0);
+    }
+    for (auto& run : runs) {
+        std::sort(run.begin(), run.end(), [](const IWPair& lhs, const IWPair& rhs) {
+            return IWComparator()(lhs, rhs) < 0;
+        });
+    }
+
+    for (auto _ : state) {
+        std::vector<std::shared_ptr<IWIterator>> inputs;
+        for (auto& run : runs) {
+            inputs.push_back(std::make_shared<sorter::InMemIterator<IntWrapper, IntWrapper>>(run));
+        }
+        std::unique_ptr<IWIterator> merged(
+            IWIterator::merge(inputs, SortOptions(), IWComparator()));
+        while (merged->more()) {
+            benchmark::DoNotOptimize(merged->next());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * totalValues);
+}
+
+// Sorts 4M values with a memory limit that forces 32 spills, with state.range(0) background
+// spill threads.
+void BM_ExternalSort(benchmark::State& state) {
+    const size_t totalValues = 4 * 1024 * 1024;
+    const auto values = makeRandomInts(totalValues);
+    ScopedSpillDir spillDir;
+    const auto opts = SortOptions()
+                          .TempDir(spillDir.path())
+                          .ExtSortAllowed()
+                          .MaxMemoryUsageBytes(totalValues * sizeof(IWPair) / 32)
+                          .SpillThreads(state.range(0));
+
+    for (auto _ : state) {
+        std::unique_ptr<IWSorter> sorter(IWSorter::make(opts, IWComparator()));
+        for (int value : values) {
+            sorter->add(value, 0);
+        }
+        std::unique_ptr<IWIterator> sorted(sorter->done());
+        while (sorted->more()) {
+            benchmark::DoNotOptimize(sorted->next());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * totalValues);
+}
+
+BENCHMARK(BM_MergeIterator)->RangeMultiplier(4)->Range(2, 512);
+BENCHMARK(BM_ExternalSort)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace mongo
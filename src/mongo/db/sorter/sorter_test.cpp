@@ -85,6 +85,7 @@ private:
 typedef pair<IntWrapper, IntWrapper> IWPair;
 typedef SortIteratorInterface<IntWrapper, IntWrapper> IWIterator;
 typedef Sorter<IntWrapper, IntWrapper> IWSorter;
+typedef sorter::InMemIterator<IntWrapper, IntWrapper> IWInMemIterator;
 
 enum Direction { ASC = 1, DESC = -1 };
 class IWComparator {
@@ -321,6 +322,39 @@ public:
                 mergeIterators(iterators, ASC, SortOptions().Limit(10)),
                 make_shared<LimitIterator>(10, make_shared<IntIterator>(0, 20, 1)));
         }
+        {  // test a number of inputs that is not a power of two, with inputs of different lengths
+            std::shared_ptr<IWIterator> iterators[] = {make_shared<IntIterator>(0, 50, 5),
+                                                       make_shared<IntIterator>(1, 20, 5),
+                                                       make_shared<EmptyIterator>(),
+                                                       make_shared<IntIterator>(2, 50, 5),
+                                                       make_shared<IntIterator>(3, 4, 5),
+                                                       make_shared<IntIterator>(4, 50, 5),
+                                                       make_shared<IntIterator>(21, 50, 5)};
+            // Every number below 50 except 8, 13, ... 48.
+            std::vector<IWPair> expected;
+            for (int i = 0; i < 50; i++) {
+                if (i % 5 != 3 || i == 3)
+                    expected.push_back(IWPair(i, -i));
+            }
+            std::shared_ptr<IWIterator> correct = make_shared<IWInMemIterator>(expected);
+            ASSERT_ITERATORS_EQUIVALENT(mergeIterators(iterators, ASC), correct);
+        }
+        {  // test that equal keys are returned in the order of their inputs
+            std::vector<std::shared_ptr<IWIterator>> vec;
+            for (int input = 0; input < 5; input++) {
+                vec.push_back(make_shared<IWInMemIterator>(
+                    std::vector<IWPair>{IWPair(0, input), IWPair(1, input)}));
+            }
+            std::vector<IWPair> expected;
+            for (int key = 0; key < 2; key++) {
+                for (int input = 0; input < 5; input++)
+                    expected.push_back(IWPair(key, input));
+            }
+            std::shared_ptr<IWIterator> merged(
+                IWIterator::merge(vec, SortOptions(), IWComparator()));
+            std::shared_ptr<IWIterator> correct = make_shared<IWInMemIterator>(expected);
+            ASSERT_ITERATORS_EQUIVALENT(merged, correct);
+        }
     }
 };
 
@@ -509,6 +543,49 @@ public:
 };
 
 
+template <bool Random = true>
+class LotsOfDataParallelSpills : public LotsOfDataLittleMemory<Random> {
+    SortOptions adjustSortOptions(SortOptions opts) {
+        return LotsOfDataLittleMemory<Random>::adjustSortOptions(opts).SpillThreads(2);
+    }
+};
+
+// With background spills, only the runs after the first one get a share of the memory budget.
+class ParallelSpillsMemoryBudget : public ScopedGlobalServiceContextForTest {
+public:
+    void run() {
+        unittest::TempDir tempDir("sorterTests");
+        const SortOptions opts = SortOptions()
+                                     .TempDir(tempDir.path())
+                                     .MaxMemoryUsageBytes(kMemLimit)
+                                     .ExtSortAllowed()
+                                     .SpillThreads(2);
+        std::shared_ptr<IWSorter> sorter(IWSorter::make(opts, IWComparator(ASC)));
+
+        int i = 0;
+        for (; i < (kMemLimit / kItemSize) * 3 / 4; i++)
+            sorter->add(i, -i);
+        ASSERT_EQ(sorter->numFiles(), 0);
+
+        for (; i <= kMemLimit / kItemSize; i++)
+            sorter->add(i, -i);
+        ASSERT_EQ(sorter->numFiles(), 1);
+
+        // Half of the budget is more than the share of a run.
+        for (int end = i + (kMemLimit / kItemSize) / 2; i < end; i++)
+            sorter->add(i, -i);
+        ASSERT_EQ(sorter->numFiles(), 2);
+
+        ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter->done()),
+                                    make_shared<IntIterator>(0, i));
+    }
+
+    enum Constants {
+        kMemLimit = 64 * 1024,
+        kItemSize = 2 * sizeof(IntWrapper),
+    };
+};
+
 template <long long Limit, bool Random = true>
 class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     typedef LotsOfDataLittleMemory<Random> Parent;
@@ -547,6 +624,9 @@ public:
         add<SorterTests::Dupes>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/false>>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/true>>();
+        add<SorterTests::LotsOfDataParallelSpills</*random=*/false>>();
+        add<SorterTests::LotsOfDataParallelSpills</*random=*/true>>();
+        add<SorterTests::ParallelSpillsMemoryBudget>();
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/false>>();     // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/true>>();      // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/false>>();   // fits in mem
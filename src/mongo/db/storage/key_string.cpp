@@ -35,6 +35,7 @@
 
 #include "mongo/db/storage/key_string.h"
 
+#include <algorithm>
 #include <cmath>
 #include <type_traits>
 #include <utility>
@@ -42,6 +43,7 @@
 #include "mongo/base/data_view.h"
 #include "mongo/platform/bits.h"
 #include "mongo/platform/strnlen.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/hex.h"
 #include "mongo/util/log.h"
 
@@ -384,6 +386,14 @@ void KeyString::_appendAllElementsForIndexing(const BSONObj& obj,
     _append(kEnd, false);
 }
 
+void KeyString::appendIndexKeyElement(const BSONElement& elem, bool invert) {
+    _appendBsonValue(elem, invert, NULL);
+}
+
+void KeyString::appendIndexKeyEnd() {
+    _append(kEnd, false);
+}
+
 void KeyString::appendRecordId(const RecordId& loc) {
     loc.withFormat([](RecordId::Null n) { invariant(false); },
                    [&](int64_t rid) { _appendRecordIdLong(rid); },
@@ -2212,6 +2222,44 @@ int KeyString::compare(const KeyString& other) const {
     return a < b ? -1 : 1;
 }
 
+KeyStringSet::Key& KeyStringSet::emplace(KeyString::Version version) {
+    if (_size == _keys.size()) {
+        _keys.push_back(stdx::make_unique<Key>(version));
+    } else {
+        Key& key = *_keys[_size];
+        key.keyString.reset(version);
+        key.keyString.resetToEmpty();
+        key.bsonSize = 0;
+    }
+    return *_keys[_size++];
+}
+
+void KeyStringSet::add(KeyString::Version version, const BSONObj& key, Ordering ord) {
+    Key& entry = emplace(version);
+    entry.keyString.resetToKey(key, ord);
+    entry.bsonSize = key.objsize();
+}
+
+void KeyStringSet::sortAndDedupe() {
+    const auto end = _keys.begin() + _size;
+    std::stable_sort(_keys.begin(), end, [](const auto& lhs, const auto& rhs) {
+        return lhs->keyString.compare(rhs->keyString) < 0;
+    });
+
+    // Swap rather than move the duplicates out so their buffers remain available for reuse.
+    size_t kept = 0;
+    for (size_t i = 0; i < _size; ++i) {
+        if (kept > 0 && _keys[kept - 1]->keyString.compare(_keys[i]->keyString) == 0) {
+            continue;
+        }
+        if (kept != i) {
+            std::swap(_keys[kept], _keys[i]);
+        }
+        ++kept;
+    }
+    _size = kept;
+}
+
 void KeyString::TypeBits::resetFromBuffer(BufReader* reader) {
     if (!reader->remaining()) {
         // This means AllZeros state was encoded as an empty buffer.
@@ -30,9 +30,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
+#include <memory>
 #include <utility>
+#include <vector>
 
+#include "mongo/base/data_type_endian.h"
+#include "mongo/base/data_view.h"
 #include "mongo/base/static_assert.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobj.h"
@@ -353,6 +359,14 @@ public:
     void appendRecordId(const RecordId& loc);
     void appendTypeBits(const TypeBits& bits);
 
+    /**
+     * Appends 'elem' as the next field of an index key, inverted if the field is descending.
+     * Calling appendIndexKeyEnd() after the last field produces the same encoding as resetToKey()
+     * with the fields gathered into a BSONObj.
+     */
+    void appendIndexKeyElement(const BSONElement& elem, bool invert);
+    void appendIndexKeyEnd();
+
     /**
      * Resets to an empty state.
      * Equivalent to but faster than *this = KeyString()
@@ -468,6 +482,120 @@ inline bool operator>=(const KeyString& lhs, const KeyString& rhs) {
     return lhs.compare(rhs) >= 0;
 }
 
+/**
+ * Normalized-key helpers for containers that compare many encoded keys, such as ordered maps and
+ * merges over KeyString bytes.
+ *
+ * The prefix of a key is its first kKeyStringPrefixBytes bytes read as a big-endian integer,
+ * padded with zero bytes when the key is shorter. Since no byte is less than the padding, prefix
+ * order agrees with memcmp() order whenever two prefixes differ, so a key that stores its prefix
+ * alongside its bytes settles most comparisons with a single integer compare and never touches
+ * the key buffer. Only equal prefixes fall back to comparing the bytes past them.
+ */
+const size_t kKeyStringPrefixBytes = sizeof(uint64_t);
+
+inline uint64_t keyStringPrefix(const char* data, size_t size) {
+    if (size >= kKeyStringPrefixBytes) {
+        return ConstDataView(data).read<BigEndian<uint64_t>>();
+    }
+    char padded[kKeyStringPrefixBytes] = {};
+    if (size > 0) {
+        std::memcpy(padded, data, size);
+    }
+    return ConstDataView(padded).read<BigEndian<uint64_t>>();
+}
+
+/**
+ * Compares two encoded keys as KeyString::compare() does, given their keyStringPrefix() values.
+ * Returns -1, 0 or 1.
+ */
+inline int compareKeyStrings(const char* lhs,
+                             size_t lhsSize,
+                             uint64_t lhsPrefix,
+                             const char* rhs,
+                             size_t rhsSize,
+                             uint64_t rhsPrefix) {
+    if (lhsPrefix != rhsPrefix) {
+        return lhsPrefix < rhsPrefix ? -1 : 1;
+    }
+
+    // Equal prefixes mean that the leading min(lhsSize, rhsSize) bytes are equal as well: a key
+    // shorter than the prefix matches the other key on all of its bytes and then on the padding.
+    const size_t common = std::min(lhsSize, rhsSize);
+    if (common > kKeyStringPrefixBytes) {
+        int cmp = std::memcmp(lhs + kKeyStringPrefixBytes,
+                              rhs + kKeyStringPrefixBytes,
+                              common - kKeyStringPrefixBytes);
+        if (cmp) {
+            return cmp < 0 ? -1 : 1;
+        }
+    }
+
+    if (lhsSize == rhsSize) {
+        return 0;
+    }
+    return lhsSize < rhsSize ? -1 : 1;
+}
+
+/**
+ * The index keys of a document, encoded as KeyStrings without a RecordId.
+ *
+ * Keys are appended in any order and then sorted with sortAndDedupe(), which drops the keys whose
+ * encoding equals that of an earlier one. Keys that compare equal, such as 1 and 1.0, are thereby
+ * indexed once, with the TypeBits of the first. The KeyStrings stay allocated across clear() so
+ * that a set reused for many documents rarely allocates.
+ */
+class KeyStringSet {
+public:
+    struct Key {
+        explicit Key(KeyString::Version version) : keyString(version) {}
+
+        KeyString keyString;
+        // objsize() of the key as a BSONObj, which limits on the size of index keys refer to.
+        int bsonSize = 0;
+    };
+
+    KeyStringSet() = default;
+    KeyStringSet(const KeyStringSet&) = delete;
+    KeyStringSet& operator=(const KeyStringSet&) = delete;
+
+    /**
+     * Returns an empty key of 'version' appended to the set.
+     */
+    Key& emplace(KeyString::Version version);
+
+    /**
+     * Appends the encoding of 'key', whose fields are ordered according to 'ord'.
+     */
+    void add(KeyString::Version version, const BSONObj& key, Ordering ord);
+
+    /**
+     * Sorts the keys in KeyString order and removes duplicates.
+     */
+    void sortAndDedupe();
+
+    void clear() {
+        _size = 0;
+    }
+
+    size_t size() const {
+        return _size;
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+
+    const Key& operator[](size_t i) const {
+        dassert(i < _size);
+        return *_keys[i];
+    }
+
+private:
+    // The first '_size' entries are in use; the others are kept for reuse.
+    std::vector<std::unique_ptr<Key>> _keys;
+    size_t _size = 0;
+};
+
 inline bool operator!=(const KeyString& lhs, const KeyString& rhs) {
     return !(lhs == rhs);
 }
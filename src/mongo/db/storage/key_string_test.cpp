@@ -955,6 +955,74 @@ TEST_F(KeyStringTest, AllPerm2Compare) {
     testPermutation(version, elements, orderings, false);
 }
 
+TEST(KeyStringPrefixTest, ComparesShortAndPaddedKeysLikeMemcmp) {
+    // Keys around the prefix length, including ones that differ only by trailing zero bytes that
+    // the padding of a shorter key cannot distinguish.
+    const std::vector<std::string> keys = {"",
+                                           std::string(1, '\0'),
+                                           std::string(2, '\0'),
+                                           "a",
+                                           std::string("a\0", 2),
+                                           std::string("a\0\0\0\0\0\0\0", 8),
+                                           std::string("a\0\0\0\0\0\0\0\0", 9),
+                                           "abcdefg",
+                                           "abcdefgh",
+                                           "abcdefghi",
+                                           "abcdefghj",
+                                           "abcdefgi",
+                                           "abcdefghijklmnopqrstuvwxyz",
+                                           "abcdefghijklmnopqrstuvwxzz",
+                                           std::string(8, '\xff'),
+                                           std::string(16, '\xff')};
+
+    for (auto&& lhs : keys) {
+        for (auto&& rhs : keys) {
+            KeyString lhsKs(KeyString::Version::V1);
+            lhsKs.resetFromBuffer(lhs.data(), lhs.size());
+            KeyString rhsKs(KeyString::Version::V1);
+            rhsKs.resetFromBuffer(rhs.data(), rhs.size());
+
+            ASSERT_EQ(lhsKs.compare(rhsKs),
+                      compareKeyStrings(lhs.data(),
+                                        lhs.size(),
+                                        keyStringPrefix(lhs.data(), lhs.size()),
+                                        rhs.data(),
+                                        rhs.size(),
+                                        keyStringPrefix(rhs.data(), rhs.size())))
+                << toHex(lhs.data(), lhs.size()) << " vs " << toHex(rhs.data(), rhs.size());
+        }
+    }
+}
+
+TEST_F(KeyStringTest, PrefixCompareAgreesWithCompare) {
+    std::vector<BSONObj> elements = thinElements(getInterestingElements(version), newSeed(), 500);
+
+    for (auto ordering : {ALL_ASCENDING, ONE_DESCENDING}) {
+        std::vector<std::unique_ptr<KeyString>> keys;
+        for (auto&& elem : elements) {
+            for (auto discriminator : {KeyString::kInclusive,
+                                       KeyString::kExclusiveBefore,
+                                       KeyString::kExclusiveAfter}) {
+                keys.push_back(
+                    stdx::make_unique<KeyString>(version, elem, ordering, discriminator));
+            }
+        }
+
+        for (auto&& lhs : keys) {
+            const uint64_t lhsPrefix = keyStringPrefix(lhs->getBuffer(), lhs->getSize());
+            for (auto&& rhs : keys) {
+                ASSERT_EQ(lhs->compare(*rhs),
+                          compareKeyStrings(lhs->getBuffer(),
+                                            lhs->getSize(),
+                                            lhsPrefix,
+                                            rhs->getBuffer(),
+                                            rhs->getSize(),
+                                            keyStringPrefix(rhs->getBuffer(), rhs->getSize())));
+            }
+        }
+    }
+}
+
 #define COMPARE_HELPER(LHS, RHS) (((LHS) < (RHS)) ? -1 : (((LHS) == (RHS)) ? 0 : 1))
 
 int compareLongToDouble(long long lhs, double rhs) {
@@ -81,6 +81,15 @@ public:
     virtual ~UpdateNotifier() {}
     virtual Status recordStoreGoingToUpdateInPlace(OperationContext* opCtx,
                                                    const RecordId& loc) = 0;
+
+    /**
+     * Returns false if the update being written is known to leave the keys of the index named
+     * 'indexName' unchanged, so a record store that maintains entries for that index itself may
+     * skip them.
+     */
+    virtual bool indexKeysMayChange(OperationContext* opCtx, StringData indexName) const {
+        return true;
+    }
 };
 
 /**
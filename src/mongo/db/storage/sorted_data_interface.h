@@ -35,6 +35,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/index_entry_comparison.h"
+#include "mongo/db/storage/key_string.h"
 
 #pragma once
 
@@ -114,6 +115,35 @@ public:
                          const RecordId& loc,
                          bool dupsAllowed) = 0;
 
+    /**
+     * Returns the KeyString version of the keys insertKeyString() and unindexKeyString() take, or
+     * boost::none if this index only takes keys as BSONObjs.
+     */
+    virtual boost::optional<KeyString::Version> acceptedKeyStringVersion() const {
+        return boost::none;
+    }
+
+    /**
+     * Like insert(), with the key already encoded as a KeyString, without a RecordId, in the
+     * version returned by acceptedKeyStringVersion() and the ordering of this index.
+     */
+    virtual Status insertKeyString(OperationContext* opCtx,
+                                   const KeyStringSet::Key& key,
+                                   const RecordId& loc,
+                                   bool dupsAllowed) {
+        MONGO_UNREACHABLE;
+    }
+
+    /**
+     * Like unindex(), with the key encoded as for insertKeyString().
+     */
+    virtual void unindexKeyString(OperationContext* opCtx,
+                                  const KeyStringSet::Key& key,
+                                  const RecordId& loc,
+                                  bool dupsAllowed) {
+        MONGO_UNREACHABLE;
+    }
+
     /**
      * Return ErrorCodes::DuplicateKey if 'key' already exists in 'this'
      * index at a RecordId other than 'loc', and Status::OK() otherwise.
@@ -194,6 +194,10 @@ UpdateNode::ApplyResult ModifierNode::applyToExistingElement(ApplyParams applyPa
         applyResult.indexesAffected = false;
     }
 
+    if (applyParams.modifiedPaths) {
+        applyParams.modifiedPaths->push_back(applyParams.pathTaken->dottedField().toString());
+    }
+
     if (applyParams.validateForStorage) {
         const uint32_t recursionLevel = applyParams.pathTaken->numParts();
         validateUpdate(
@@ -286,13 +290,17 @@ UpdateNode::ApplyResult ModifierNode::applyToNonexistentElement(ApplyParams appl
         // an index {"a.b": 1}, and we set "a.1.c" and implicitly create an array element in "a",
         // then we may need to add a null key to the index, even though "a.1.c" does not appear to
         // affect the index.
-        if (!applyParams.indexData ||
-            !applyParams.indexData->mightBeIndexed(applyParams.element.getType() != BSONType::Array
-                                                       ? fullPath
-                                                       : applyParams.pathTaken->dottedField())) {
+        StringData indexedPath = applyParams.element.getType() != BSONType::Array
+            ? StringData(fullPath)
+            : applyParams.pathTaken->dottedField();
+        if (!applyParams.indexData || !applyParams.indexData->mightBeIndexed(indexedPath)) {
             applyResult.indexesAffected = false;
         }
 
+        if (applyParams.modifiedPaths) {
+            applyParams.modifiedPaths->push_back(indexedPath.toString());
+        }
+
         if (applyParams.logBuilder) {
             logUpdate(applyParams.logBuilder, fullPath, newElement, ModifyResult::kCreated);
         }
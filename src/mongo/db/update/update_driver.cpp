@@ -262,6 +262,10 @@ Status UpdateDriver::update(StringData matchedField,
     applyParams.fromOplogApplication = _fromOplogApplication;
     applyParams.validateForStorage = validateForStorage;
     applyParams.indexData = _indexedFields;
+    _modifiedPaths.clear();
+    if (!_replacementMode) {
+        applyParams.modifiedPaths = &_modifiedPaths;
+    }
     if (_logOp && logOpRec) {
         applyParams.logBuilder = &logBuilder;
     }
@@ -301,6 +305,10 @@ bool UpdateDriver::modsAffectIndices() const {
     return _affectIndices;
 }
 
+const std::vector<std::string>* UpdateDriver::modifiedPaths() const {
+    return _replacementMode ? nullptr : &_modifiedPaths;
+}
+
 void UpdateDriver::refreshIndexKeys(const UpdateIndexData* indexedFields) {
     _indexedFields = indexedFields;
 }
@@ -110,6 +110,13 @@ public:
     static bool isDocReplacement(const BSONObj& updateExpr);
 
     bool modsAffectIndices() const;
+
+    /**
+     * Returns the paths modified by the last call to update(), in the form they were checked
+     * against the indexed fields, or nullptr if they aren't known because the update replaced the
+     * whole document.
+     */
+    const std::vector<std::string>* modifiedPaths() const;
     void refreshIndexKeys(const UpdateIndexData* indexedFields);
 
     bool logOp() const;
@@ -178,6 +185,9 @@ private:
     // at each call to update.
     bool _affectIndices = false;
 
+    // The paths modified by the last call to update(). Unused for replacement-style updates.
+    std::vector<std::string> _modifiedPaths;
+
     // Do any of the mods require positional match details when calling 'prepare'?
     bool _positional = false;
 
@@ -29,6 +29,7 @@
 #include "mongo/db/update/update_driver.h"
 
 
+#include <algorithm>
 #include <map>
 
 #include "mongo/base/owned_pointer_vector.h"
@@ -156,6 +157,58 @@ TEST(Collator, SetCollationUpdatesModifierInterfaces) {
     ASSERT_TRUE(modified);
 }
 
+TEST(ModifiedPaths, UpdateReportsPathsItModifies) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    UpdateDriver driver(expCtx);
+    std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+    ASSERT_OK(driver.parse(fromjson("{$set: {a: 1, 'b.c': 2}, $inc: {d: 1}, $unset: {e: 1}}"),
+                           arrayFilters));
+
+    UpdateIndexData indexData;
+    indexData.addPath("x");
+    driver.refreshIndexKeys(&indexData);
+
+    const bool validateForStorage = true;
+    const FieldRefSet emptyImmutablePaths;
+    mutablebson::Document doc(fromjson("{a: 1, b: {c: 0}, d: 5}"));
+    ASSERT_OK(driver.update(StringData(), &doc, validateForStorage, emptyImmutablePaths));
+    ASSERT_FALSE(driver.modsAffectIndices());
+
+    // The no-op $set of 'a' and $unset of the missing 'e' modify nothing.
+    ASSERT(driver.modifiedPaths());
+    std::vector<std::string> modifiedPaths = *driver.modifiedPaths();
+    std::sort(modifiedPaths.begin(), modifiedPaths.end());
+    ASSERT(modifiedPaths == std::vector<std::string>({"b.c", "d"}));
+}
+
+TEST(ModifiedPaths, ElementCreatedInArrayReportsTheArray) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    UpdateDriver driver(expCtx);
+    std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+    ASSERT_OK(driver.parse(fromjson("{$set: {'a.1.c': 1}}"), arrayFilters));
+
+    const bool validateForStorage = true;
+    const FieldRefSet emptyImmutablePaths;
+    mutablebson::Document doc(fromjson("{a: [{b: 1}]}"));
+    ASSERT_OK(driver.update(StringData(), &doc, validateForStorage, emptyImmutablePaths));
+
+    ASSERT(driver.modifiedPaths());
+    ASSERT(*driver.modifiedPaths() == std::vector<std::string>({"a"}));
+}
+
+TEST(ModifiedPaths, ReplacementDoesNotReportPaths) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    UpdateDriver driver(expCtx);
+    std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+    ASSERT_OK(driver.parse(fromjson("{a: 2}"), arrayFilters));
+
+    const bool validateForStorage = true;
+    const FieldRefSet emptyImmutablePaths;
+    mutablebson::Document doc(fromjson("{a: 1}"));
+    ASSERT_OK(driver.update(StringData(), &doc, validateForStorage, emptyImmutablePaths));
+    ASSERT_FALSE(driver.modifiedPaths());
+}
+
 //
 // Tests of creating a base for an upsert from a query document
 // $or, $and, $all get special handling, as does the _id field
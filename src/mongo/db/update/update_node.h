@@ -29,6 +29,8 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "mongo/bson/bsonelement.h"
 #include "mongo/bson/mutable/element.h"
@@ -119,6 +121,10 @@ public:
         // Used to determine whether indexes are affected.
         const UpdateIndexData* indexData = nullptr;
 
+        // If provided, UpdateNode::apply will add each path it modifies here, in the form it
+        // checks against 'indexData'.
+        std::vector<std::string>* modifiedPaths = nullptr;
+
         // If provided, UpdateNode::apply will log the update here.
         LogBuilder* logBuilder = nullptr;
     };
@@ -198,6 +198,26 @@ TEST_F(CursorManagerTest,
     }
 }
 
+/**
+ * Tests that cursor ids drawn from the per-thread generator stay unique within a cursor manager and
+ * that every registered cursor can be pinned again by its id.
+ */
+TEST_F(CursorManagerTest, CursorIdsFromCollectionCursorManagerShouldBeUnique) {
+    CursorManager* cursorManager = useCursorManager();
+    stdx::unordered_set<CursorId> cursorIds;
+    for (int i = 0; i < 1000; i++) {
+        auto cursorPin = makeCursor(_opCtx.get());
+        ASSERT_TRUE(cursorIds.insert(cursorPin.getCursor()->cursorid()).second);
+    }
+    ASSERT_EQ(1000UL, cursorManager->numCursors());
+
+    for (auto cursorId : cursorIds) {
+        auto cursorPin = cursorManager->pinCursor(_opCtx.get(), cursorId);
+        ASSERT_OK(cursorPin.getStatus());
+        ASSERT_EQ(cursorId, cursorPin.getValue().getCursor()->cursorid());
+    }
+}
+
 /**
  * Tests that invalidating a cursor without dropping the collection while the cursor is not in use
  * will keep the cursor registered. After being invalidated, pinning the cursor should take
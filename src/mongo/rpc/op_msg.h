@@ -165,6 +165,15 @@ public:
         skipHeaderAndFlags();
     }
 
+    /**
+     * Builds the message in 'buffer' rather than in a freshly allocated one. The buffer must not
+     * be shared; it is grown as needed.
+     */
+    explicit OpMsgBuilder(SharedBuffer buffer) : _buf(0) {
+        _buf.useSharedBuffer(std::move(buffer));
+        skipHeaderAndFlags();
+    }
+
     /**
      * See the documentation for DocSequenceBuilder below.
      */
@@ -31,6 +31,7 @@
 #include "mongo/rpc/op_msg.h"
 #include "mongo/rpc/reply_builder_interface.h"
 #include "mongo/rpc/reply_interface.h"
+#include "mongo/util/shared_buffer_pool.h"
 
 namespace mongo {
 namespace rpc {
@@ -55,6 +56,11 @@ private:
 
 class OpMsgReplyBuilder final : public rpc::ReplyBuilderInterface {
 public:
+    // Start from a pooled buffer sized after recent replies on this thread, so that large
+    // find/getMore batches neither malloc nor go through a chain of doubling reallocations.
+    OpMsgReplyBuilder()
+        : _builder(SharedBuffer::allocatePooled(ReplySizeEstimator::estimate())) {}
+
     ReplyBuilderInterface& setRawCommandReply(const BSONObj& reply) override {
         _builder.beginBody().appendElements(reply);
         return *this;
@@ -78,7 +84,9 @@ public:
         _builder.reset();
     }
     Message done() override {
-        return _builder.finish();
+        auto reply = _builder.finish();
+        ReplySizeEstimator::record(reply.size());
+        return reply;
     }
 
 private:
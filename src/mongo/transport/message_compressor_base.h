@@ -40,6 +40,8 @@ enum class MessageCompressor : uint8_t {
     kNoop = 0,
     kSnappy = 1,
     kZlib = 2,
+    kZstd = 3,
+    kZstdDictionary = 4,
     kExtended = 255,
 };
 
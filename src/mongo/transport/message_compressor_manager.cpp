@@ -38,6 +38,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/rpc/message.h"
 #include "mongo/transport/message_compressor_registry.h"
+#include "mongo/transport/message_compressor_zstd.h"
 #include "mongo/transport/session.h"
 #include "mongo/util/log.h"
 
@@ -105,6 +106,11 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
     LOG(3) << "Compressing message with " << compressor->getName();
 
     auto inputHeader = msg.header();
+    auto sampler = ZstdDictionarySampler::get();
+    if (sampler && msg.operation() == dbMsg) {
+        sampler->addSample(
+            ConstDataRange(inputHeader.data(), inputHeader.data() + inputHeader.dataLen()));
+    }
     size_t bufferSize = compressor->getMaxCompressedSize(msg.dataSize()) +
         CompressionHeader::size() + MsgData::MsgDataHeaderSize;
 
@@ -117,7 +123,7 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
         return {msg};
     }
 
-    auto outputMessageBuffer = SharedBuffer::allocate(bufferSize);
+    auto outputMessageBuffer = SharedBuffer::allocatePooled(bufferSize);
 
     MsgData::View outMessage(outputMessageBuffer.get());
     outMessage.setId(inputHeader.getId());
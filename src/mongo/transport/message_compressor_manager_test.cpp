@@ -38,9 +38,12 @@
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_snappy.h"
 #include "mongo/transport/message_compressor_zlib.h"
+#include "mongo/transport/message_compressor_zstd.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/log.h"
 
+#include <boost/filesystem/operations.hpp>
 #include <string>
 #include <vector>
 
@@ -233,6 +236,88 @@ TEST(ZlibMessageCompressor, Fidelity) {
     checkFidelity(testMessage, stdx::make_unique<ZlibMessageCompressor>());
 }
 
+TEST(ZstdMessageCompressor, Fidelity) {
+    auto testMessage = buildMessage();
+    checkFidelity(testMessage, stdx::make_unique<ZstdMessageCompressor>());
+}
+
+std::vector<std::string> buildDictionarySamples() {
+    std::vector<std::string> samples;
+    for (int i = 0; i < 1000; i++) {
+        auto obj = BSON("_id" << i * 7919 << "status"
+                              << "shipped"
+                              << "customer"
+                              << ("customer" + std::to_string(i % 37))
+                              << "amount"
+                              << (i * 13) % 1000);
+        samples.emplace_back(obj.objdata(), obj.objsize());
+    }
+    return samples;
+}
+
+std::unique_ptr<ZstdMessageCompressor> buildDictionaryCompressor() {
+    auto dictionary = assertOk(trainZstdDictionary(buildDictionarySamples(), 4096));
+    auto swCompressor = ZstdMessageCompressor::makeWithDictionary(std::move(dictionary));
+    ASSERT_OK(swCompressor.getStatus());
+    return std::move(swCompressor.getValue());
+}
+
+TEST(ZstdMessageCompressor, DictionaryFidelity) {
+    auto testMessage = buildMessage();
+    auto compressor = buildDictionaryCompressor();
+    ASSERT_EQ(compressor->getName(), "zstd_dict");
+    checkFidelity(testMessage, std::move(compressor));
+}
+
+TEST(ZstdMessageCompressor, DictionaryImprovesSmallMessages) {
+    auto sample = BSON("_id" << 424242 << "status"
+                             << "shipped"
+                             << "customer"
+                             << "customer12"
+                             << "amount"
+                             << 17);
+    ConstDataRange input(sample.objdata(), sample.objsize());
+
+    ZstdMessageCompressor plain;
+    auto dictCompressor = buildDictionaryCompressor();
+
+    std::vector<char> plainBuffer(plain.getMaxCompressedSize(input.length()));
+    std::vector<char> dictBuffer(dictCompressor->getMaxCompressedSize(input.length()));
+    auto plainSize =
+        assertOk(plain.compressData(input, DataRange(plainBuffer.data(), plainBuffer.size())));
+    auto dictSize = assertOk(
+        dictCompressor->compressData(input, DataRange(dictBuffer.data(), dictBuffer.size())));
+    ASSERT_LT(dictSize, plainSize);
+
+    // A peer without the dictionary must reject the frame rather than produce garbage.
+    std::vector<char> scratch(input.length());
+    ASSERT_NOT_OK(plain.decompressData(ConstDataRange(dictBuffer.data(), dictSize),
+                                       DataRange(scratch.data(), scratch.size())));
+}
+
+TEST(ZstdMessageCompressor, EmptyDictionary) {
+    ASSERT_NOT_OK(ZstdMessageCompressor::makeWithDictionary("").getStatus());
+}
+
+TEST(ZstdDictionarySampler, DestructionWaitsForTraining) {
+    unittest::TempDir tempDir("zstd_dictionary_sampler");
+    auto outputPath = tempDir.path() + "/dictionary";
+    auto samples = buildDictionarySamples();
+    {
+        ZstdDictionarySampler sampler(outputPath, samples.size(), 4096);
+        for (const auto& sample : samples) {
+            for (uint64_t i = 0; i < ZstdDictionarySampler::kSampleInterval; i++) {
+                sampler.addSample(ConstDataRange(sample.data(), sample.size()));
+            }
+        }
+        ASSERT_TRUE(sampler.isDone());
+    }
+
+    // The background training run must have finished by the time the sampler is gone.
+    ASSERT_TRUE(boost::filesystem::exists(outputPath));
+    ASSERT_GT(boost::filesystem::file_size(outputPath), 0U);
+}
+
 TEST(SnappyMessageCompressor, Overflow) {
     checkOverflow(stdx::make_unique<SnappyMessageCompressor>());
 }
@@ -241,6 +326,10 @@ TEST(ZlibMessageCompressor, Overflow) {
     checkOverflow(stdx::make_unique<ZlibMessageCompressor>());
 }
 
+TEST(ZstdMessageCompressor, Overflow) {
+    checkOverflow(stdx::make_unique<ZstdMessageCompressor>());
+}
+
 TEST(MessageCompressorManager, SERVER_28008) {
 
     // Create a client and server that will negotiate the same compressors,
@@ -35,6 +35,8 @@
 #include "mongo/transport/message_compressor_noop.h"
 #include "mongo/transport/message_compressor_snappy.h"
 #include "mongo/transport/message_compressor_zlib.h"
+#include "mongo/transport/message_compressor_zstd.h"
+#include "mongo/util/mongoutils/str.h"
 #include "mongo/util/options_parser/option_section.h"
 
 #include <boost/algorithm/string/classification.hpp>
@@ -54,6 +56,10 @@ StringData getMessageCompressorName(MessageCompressor id) {
             return "snappy"_sd;
         case MessageCompressor::kZlib:
             return "zlib"_sd;
+        case MessageCompressor::kZstd:
+            return "zstd"_sd;
+        case MessageCompressor::kZstdDictionary:
+            return "zstd_dict"_sd;
         default:
             fassert(40269, "Invalid message compressor ID");
     }
@@ -124,6 +130,56 @@ Status addMessageCompressionOptions(moe::OptionSection* options, bool forShell)
     } else {
         ret.setDefault(moe::Value(kDefaultConfigValue.toString()));
     }
+
+    auto& level =
+        options
+            ->addOptionChaining("net.compression.zstdCompressionLevel",
+                                "zstdCompressionLevel",
+                                moe::Int,
+                                "Compression level used by the zstd network message compressors")
+            .setDefault(moe::Value(ZstdCompressionParams::kDefaultLevel));
+
+    auto& dictionaryPath =
+        options
+            ->addOptionChaining("net.compression.zstdDictionaryPath",
+                                "zstdDictionaryPath",
+                                moe::String,
+                                "Path to a zstd dictionary used by the zstd_dict network message "
+                                "compressor")
+            .incompatibleWith("net.compression.zstdDictionaryTrainingPath");
+
+    auto& trainingPath =
+        options
+            ->addOptionChaining("net.compression.zstdDictionaryTrainingPath",
+                                "zstdDictionaryTrainingPath",
+                                moe::String,
+                                "Sample network messages and write a trained zstd dictionary "
+                                "to this path")
+            .incompatibleWith("net.compression.zstdDictionaryPath");
+
+    auto& trainingSamples =
+        options
+            ->addOptionChaining("net.compression.zstdDictionaryTrainingSamples",
+                                "zstdDictionaryTrainingSamples",
+                                moe::Int,
+                                "Number of network messages sampled to train a zstd dictionary")
+            .setDefault(moe::Value(ZstdCompressionParams::kDefaultDictionaryTrainingSamples));
+
+    auto& dictionarySize =
+        options
+            ->addOptionChaining("net.compression.zstdDictionarySize",
+                                "zstdDictionarySize",
+                                moe::Int,
+                                "Maximum size in bytes of a trained zstd dictionary")
+            .setDefault(moe::Value(ZstdCompressionParams::kDefaultDictionarySize));
+
+    if (forShell) {
+        level.hidden();
+        dictionaryPath.hidden();
+        trainingPath.hidden();
+        trainingSamples.hidden();
+        dictionarySize.hidden();
+    }
     return Status::OK();
 }
 
@@ -136,6 +192,45 @@ Status storeMessageCompressionOptions(const moe::Environment& params) {
         }
     }
 
+    if (params.count("net.compression.zstdCompressionLevel")) {
+        auto level = params["net.compression.zstdCompressionLevel"].as<int>();
+        if (level < getZstdMinCompressionLevel() || level > getZstdMaxCompressionLevel()) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "net.compression.zstdCompressionLevel must be between "
+                                  << getZstdMinCompressionLevel()
+                                  << " and "
+                                  << getZstdMaxCompressionLevel()};
+        }
+        zstdGlobalParams.level = level;
+    }
+
+    if (params.count("net.compression.zstdDictionaryPath")) {
+        zstdGlobalParams.dictionaryPath =
+            params["net.compression.zstdDictionaryPath"].as<std::string>();
+    }
+
+    if (params.count("net.compression.zstdDictionaryTrainingPath")) {
+        zstdGlobalParams.dictionaryTrainingPath =
+            params["net.compression.zstdDictionaryTrainingPath"].as<std::string>();
+    }
+
+    if (params.count("net.compression.zstdDictionaryTrainingSamples")) {
+        auto samples = params["net.compression.zstdDictionaryTrainingSamples"].as<int>();
+        if (samples <= 0) {
+            return {ErrorCodes::BadValue,
+                    "net.compression.zstdDictionaryTrainingSamples must be positive"};
+        }
+        zstdGlobalParams.dictionaryTrainingSamples = samples;
+    }
+
+    if (params.count("net.compression.zstdDictionarySize")) {
+        auto size = params["net.compression.zstdDictionarySize"].as<int>();
+        if (size <= 0) {
+            return {ErrorCodes::BadValue, "net.compression.zstdDictionarySize must be positive"};
+        }
+        zstdGlobalParams.dictionarySize = size;
+    }
+
     auto& compressorFactory = MessageCompressorRegistry::get();
     compressorFactory.setSupportedCompressors(std::move(restrict));
 
@@ -0,0 +1,356 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/message_compressor_zstd.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include "mongo/base/init.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/transport/message_compressor_registry.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+
+#include <zdict.h>
+#include <zstd.h>
+
+namespace mongo {
+
+ZstdCompressionParams zstdGlobalParams;
+
+namespace {
+
+struct ZstdContextDeleter {
+    void operator()(ZSTD_CCtx* ctx) const {
+        ZSTD_freeCCtx(ctx);
+    }
+    void operator()(ZSTD_DCtx* ctx) const {
+        ZSTD_freeDCtx(ctx);
+    }
+};
+
+// Contexts hold several hundred KB of working memory, so they are created once per thread
+// instead of once per message.
+thread_local std::unique_ptr<ZSTD_CCtx, ZstdContextDeleter> localCompressionContext;
+thread_local std::unique_ptr<ZSTD_DCtx, ZstdContextDeleter> localDecompressionContext;
+
+ZSTD_CCtx* getCompressionContext() {
+    if (!localCompressionContext) {
+        localCompressionContext.reset(ZSTD_createCCtx());
+        invariant(localCompressionContext);
+    }
+    return localCompressionContext.get();
+}
+
+ZSTD_DCtx* getDecompressionContext() {
+    if (!localDecompressionContext) {
+        localDecompressionContext.reset(ZSTD_createDCtx());
+        invariant(localDecompressionContext);
+    }
+    return localDecompressionContext.get();
+}
+
+StatusWith<std::string> readDictionaryFile(const std::string& path) {
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in) {
+        return {ErrorCodes::FileOpenFailed,
+                str::stream() << "Could not open zstd dictionary file " << path};
+    }
+    std::string content{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    if (in.bad()) {
+        return {ErrorCodes::FileStreamFailed,
+                str::stream() << "Could not read zstd dictionary file " << path};
+    }
+    return {std::move(content)};
+}
+
+Status writeDictionaryFile(const std::string& path, const std::string& content) {
+    // Write to a temporary file first so a concurrent restart never sees a partial dictionary.
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return {ErrorCodes::FileOpenFailed,
+                    str::stream() << "Could not open " << tmpPath << " for writing"};
+        }
+        out.write(content.data(), content.size());
+        if (!out) {
+            return {ErrorCodes::FileStreamFailed,
+                    str::stream() << "Could not write zstd dictionary to " << tmpPath};
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        return {ErrorCodes::FileRenameFailed,
+                str::stream() << "Could not rename " << tmpPath << " to " << path};
+    }
+    return Status::OK();
+}
+
+std::unique_ptr<ZstdDictionarySampler> globalSampler;
+
+}  // namespace
+
+/**
+ * Digested forms of a raw dictionary. Both are immutable once built and can be shared by all
+ * threads.
+ */
+class ZstdMessageCompressor::Dictionary {
+    MONGO_DISALLOW_COPYING(Dictionary);
+
+public:
+    Dictionary(ZSTD_CDict* cdict, ZSTD_DDict* ddict) : _cdict(cdict), _ddict(ddict) {}
+
+    ~Dictionary() {
+        ZSTD_freeCDict(_cdict);
+        ZSTD_freeDDict(_ddict);
+    }
+
+    const ZSTD_CDict* cdict() const {
+        return _cdict;
+    }
+
+    const ZSTD_DDict* ddict() const {
+        return _ddict;
+    }
+
+private:
+    ZSTD_CDict* const _cdict;
+    ZSTD_DDict* const _ddict;
+};
+
+int getZstdMinCompressionLevel() {
+    return ZSTD_minCLevel();
+}
+
+int getZstdMaxCompressionLevel() {
+    return ZSTD_maxCLevel();
+}
+
+ZstdMessageCompressor::ZstdMessageCompressor(int level)
+    : MessageCompressorBase(MessageCompressor::kZstd), _level(level) {}
+
+ZstdMessageCompressor::ZstdMessageCompressor(std::shared_ptr<const Dictionary> dictionary,
+                                             int level)
+    : MessageCompressorBase(MessageCompressor::kZstdDictionary),
+      _level(level),
+      _dictionary(std::move(dictionary)) {}
+
+ZstdMessageCompressor::~ZstdMessageCompressor() = default;
+
+StatusWith<std::unique_ptr<ZstdMessageCompressor>> ZstdMessageCompressor::makeWithDictionary(
+    std::string dictionary, int level) {
+    if (dictionary.empty()) {
+        return {ErrorCodes::BadValue, "zstd dictionary must not be empty"};
+    }
+
+    // Both digested dictionaries copy the raw content, so 'dictionary' need not outlive them.
+    auto cdict = ZSTD_createCDict(dictionary.data(), dictionary.size(), level);
+    auto ddict = ZSTD_createDDict(dictionary.data(), dictionary.size());
+    if (!cdict || !ddict) {
+        ZSTD_freeCDict(cdict);
+        ZSTD_freeDDict(ddict);
+        return {ErrorCodes::BadValue, "Could not load zstd dictionary"};
+    }
+
+    auto digested = std::make_shared<const Dictionary>(cdict, ddict);
+    return {std::unique_ptr<ZstdMessageCompressor>(
+        new ZstdMessageCompressor(std::move(digested), level))};
+}
+
+std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
+    return ZSTD_compressBound(inputSize);
+}
+
+StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
+                                                            DataRange output) {
+    auto ctx = getCompressionContext();
+    auto outPtr = const_cast<char*>(output.data());
+    size_t ret;
+    if (_dictionary) {
+        ret = ZSTD_compress_usingCDict(
+            ctx, outPtr, output.length(), input.data(), input.length(), _dictionary->cdict());
+    } else {
+        ret = ZSTD_compressCCtx(ctx, outPtr, output.length(), input.data(), input.length(), _level);
+    }
+
+    if (ZSTD_isError(ret)) {
+        return Status{ErrorCodes::BadValue,
+                      str::stream() << "Could not compress input: " << ZSTD_getErrorName(ret)};
+    }
+
+    counterHitCompress(input.length(), ret);
+    return {ret};
+}
+
+StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
+                                                              DataRange output) {
+    auto ctx = getDecompressionContext();
+    auto outPtr = const_cast<char*>(output.data());
+    size_t ret;
+    if (_dictionary) {
+        ret = ZSTD_decompress_usingDDict(
+            ctx, outPtr, output.length(), input.data(), input.length(), _dictionary->ddict());
+    } else {
+        ret = ZSTD_decompressDCtx(ctx, outPtr, output.length(), input.data(), input.length());
+    }
+
+    if (ZSTD_isError(ret)) {
+        return Status{ErrorCodes::BadValue,
+                      str::stream() << "Compressed message was invalid or corrupted: "
+                                    << ZSTD_getErrorName(ret)};
+    }
+
+    counterHitDecompress(input.length(), ret);
+    return {ret};
+}
+
+StatusWith<std::string> trainZstdDictionary(const std::vector<std::string>& samples,
+                                            size_t capacity) {
+    std::string samplesBuffer;
+    std::vector<size_t> sampleSizes;
+    sampleSizes.reserve(samples.size());
+    for (const auto& sample : samples) {
+        samplesBuffer.append(sample);
+        sampleSizes.push_back(sample.size());
+    }
+
+    std::string dictionary(capacity, '\0');
+    auto ret = ZDICT_trainFromBuffer(&dictionary[0],
+                                     dictionary.size(),
+                                     samplesBuffer.data(),
+                                     sampleSizes.data(),
+                                     static_cast<unsigned>(sampleSizes.size()));
+    if (ZDICT_isError(ret)) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "Could not train zstd dictionary from " << samples.size()
+                              << " samples: "
+                              << ZDICT_getErrorName(ret)};
+    }
+    dictionary.resize(ret);
+    return {std::move(dictionary)};
+}
+
+ZstdDictionarySampler::ZstdDictionarySampler(std::string outputPath,
+                                             size_t maxSamples,
+                                             size_t dictionarySize)
+    : _outputPath(std::move(outputPath)),
+      _maxSamples(maxSamples),
+      _dictionarySize(dictionarySize) {
+    _samples.reserve(_maxSamples);
+}
+
+ZstdDictionarySampler::~ZstdDictionarySampler() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (_trainer.joinable()) {
+        _trainer.join();
+    }
+}
+
+ZstdDictionarySampler* ZstdDictionarySampler::get() {
+    return globalSampler.get();
+}
+
+void ZstdDictionarySampler::set(std::unique_ptr<ZstdDictionarySampler> sampler) {
+    globalSampler = std::move(sampler);
+}
+
+void ZstdDictionarySampler::addSample(ConstDataRange payload) {
+    if (_done.load()) {
+        return;
+    }
+    if (_seen.fetchAndAdd(1) % kSampleInterval != 0) {
+        return;
+    }
+
+    std::vector<std::string> samples;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        if (_done.load()) {
+            return;
+        }
+        _samples.emplace_back(payload.data(), std::min(payload.length(), kMaxSampleBytes));
+        if (_samples.size() < _maxSamples) {
+            return;
+        }
+        _done.store(true);
+        samples.swap(_samples);
+
+        // Training takes seconds of CPU, keep it off the network threads. The thread stays
+        // joinable so that destroying the sampler waits for it instead of leaving it running
+        // against freed state.
+        _trainer = stdx::thread([ this, samples = std::move(samples) ]() mutable {
+            _trainAndWrite(std::move(samples));
+        });
+    }
+}
+
+void ZstdDictionarySampler::_trainAndWrite(std::vector<std::string> samples) {
+    log() << "Training zstd message dictionary from " << samples.size() << " sampled payloads";
+    auto swDictionary = trainZstdDictionary(samples, _dictionarySize);
+    if (!swDictionary.isOK()) {
+        warning() << swDictionary.getStatus();
+        return;
+    }
+
+    auto status = writeDictionaryFile(_outputPath, swDictionary.getValue());
+    if (!status.isOK()) {
+        warning() << "Could not save trained zstd dictionary: " << status;
+        return;
+    }
+    log() << "Wrote " << swDictionary.getValue().size() << " byte zstd message dictionary to "
+          << _outputPath;
+}
+
+MONGO_INITIALIZER_GENERAL(ZstdMessageCompressorInit,
+                          ("EndStartupOptionHandling"),
+                          ("AllCompressorsRegistered"))
+(InitializerContext* context) {
+    auto& compressorRegistry = MessageCompressorRegistry::get();
+    compressorRegistry.registerImplementation(
+        stdx::make_unique<ZstdMessageCompressor>(zstdGlobalParams.level));
+
+    if (!zstdGlobalParams.dictionaryPath.empty()) {
+        auto swDictionary = readDictionaryFile(zstdGlobalParams.dictionaryPath);
+        if (!swDictionary.isOK()) {
+            return swDictionary.getStatus();
+        }
+        auto swCompressor = ZstdMessageCompressor::makeWithDictionary(
+            std::move(swDictionary.getValue()), zstdGlobalParams.level);
+        if (!swCompressor.isOK()) {
+            return swCompressor.getStatus();
+        }
+        compressorRegistry.registerImplementation(std::move(swCompressor.getValue()));
+    }
+
+    if (!zstdGlobalParams.dictionaryTrainingPath.empty()) {
+        ZstdDictionarySampler::set(stdx::make_unique<ZstdDictionarySampler>(
+            zstdGlobalParams.dictionaryTrainingPath,
+            static_cast<size_t>(zstdGlobalParams.dictionaryTrainingSamples),
+            static_cast<size_t>(zstdGlobalParams.dictionarySize)));
+    }
+    return Status::OK();
+}
+
+}  // namespace mongo
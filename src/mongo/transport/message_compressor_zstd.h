@@ -0,0 +1,158 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/transport/message_compressor_base.h"
+
+namespace mongo {
+
+/**
+ * Startup configuration for the zstd message compressors. Populated by
+ * storeMessageCompressionOptions() before the compressors are registered.
+ */
+struct ZstdCompressionParams {
+    // Matches ZSTD_CLEVEL_DEFAULT.
+    static constexpr int kDefaultLevel = 3;
+    // Matches the default dictionary capacity used by "zstd --train".
+    static constexpr int kDefaultDictionarySize = 112640;
+    static constexpr int kDefaultDictionaryTrainingSamples = 2000;
+
+    int level = kDefaultLevel;
+
+    // When set, a "zstd_dict" compressor is registered that primes every frame with the
+    // dictionary stored in this file. Peers must load the same dictionary to negotiate it.
+    std::string dictionaryPath;
+
+    // When set, OP_MSG payloads passing through the compressor manager are sampled and a
+    // dictionary is trained from them and written to this file.
+    std::string dictionaryTrainingPath;
+    int dictionaryTrainingSamples = kDefaultDictionaryTrainingSamples;
+    int dictionarySize = kDefaultDictionarySize;
+};
+
+extern ZstdCompressionParams zstdGlobalParams;
+
+/**
+ * Returns the range of compression levels accepted by the linked zstd library.
+ */
+int getZstdMinCompressionLevel();
+int getZstdMaxCompressionLevel();
+
+class ZstdMessageCompressor final : public MessageCompressorBase {
+public:
+    class Dictionary;
+
+    explicit ZstdMessageCompressor(int level = ZstdCompressionParams::kDefaultLevel);
+    ~ZstdMessageCompressor();
+
+    /**
+     * Builds a compressor registered as "zstd_dict" which compresses and decompresses every
+     * message using the raw dictionary content in 'dictionary'.
+     */
+    static StatusWith<std::unique_ptr<ZstdMessageCompressor>> makeWithDictionary(
+        std::string dictionary, int level = ZstdCompressionParams::kDefaultLevel);
+
+    std::size_t getMaxCompressedSize(size_t inputSize) override;
+
+    StatusWith<std::size_t> compressData(ConstDataRange input, DataRange output) override;
+
+    StatusWith<std::size_t> decompressData(ConstDataRange input, DataRange output) override;
+
+    int getLevel() const {
+        return _level;
+    }
+
+private:
+    ZstdMessageCompressor(std::shared_ptr<const Dictionary> dictionary, int level);
+
+    const int _level;
+    const std::shared_ptr<const Dictionary> _dictionary;
+};
+
+/**
+ * Trains a zstd dictionary of at most 'capacity' bytes from 'samples'. Works best with a few
+ * thousand samples that together are around 100 times larger than 'capacity'.
+ */
+StatusWith<std::string> trainZstdDictionary(const std::vector<std::string>& samples,
+                                            size_t capacity);
+
+/**
+ * Collects a bounded sample of OP_MSG payloads and, once enough have been seen, trains a
+ * dictionary from them on a background thread and writes it to
+ * ZstdCompressionParams::dictionaryTrainingPath. The dictionary is picked up by pointing
+ * ZstdCompressionParams::dictionaryPath at that file on the next startup.
+ */
+class ZstdDictionarySampler {
+    MONGO_DISALLOW_COPYING(ZstdDictionarySampler);
+
+public:
+    // Only every kSampleInterval-th message is kept so that the sample spans a longer
+    // window of the workload.
+    static constexpr uint64_t kSampleInterval = 16;
+    // Dictionaries only help the first few KB of a frame, so longer payloads are truncated.
+    static constexpr size_t kMaxSampleBytes = 8 * 1024;
+
+    ZstdDictionarySampler(std::string outputPath, size_t maxSamples, size_t dictionarySize);
+
+    /**
+     * Waits for a training run that is still in progress.
+     */
+    ~ZstdDictionarySampler();
+
+    /**
+     * Returns the process-wide sampler, or nullptr if dictionary training is not configured.
+     */
+    static ZstdDictionarySampler* get();
+
+    /**
+     * Installs the process-wide sampler. Must be called from a single-threaded context
+     * (a MONGO_INITIALIZER).
+     */
+    static void set(std::unique_ptr<ZstdDictionarySampler> sampler);
+
+    void addSample(ConstDataRange payload);
+
+    bool isDone() const {
+        return _done.load();
+    }
+
+private:
+    void _trainAndWrite(std::vector<std::string> samples);
+
+    const std::string _outputPath;
+    const size_t _maxSamples;
+    const size_t _dictionarySize;
+
+    AtomicUInt64 _seen;
+    AtomicBool _done{false};
+
+    stdx::mutex _mutex;
+    std::vector<std::string> _samples;
+    stdx::thread _trainer;
+};
+
+}  // namespace mongo
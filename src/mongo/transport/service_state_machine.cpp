@@ -54,6 +54,24 @@
 #include "mongo/util/quick_exit.h"
 
 namespace mongo {
+
+/**
+ * Every ServiceStateMachine embeds its coroutine stack, so only a few idle ones are kept per
+ * thread. Sessions usually end on another thread than the one that accepted them; the surplus is
+ * parked in the depot for the next accepted connection.
+ */
+template <>
+struct ObjectPoolTraits<ServiceStateMachine> : DefaultObjectPoolTraits {
+    static constexpr size_t kMaxPoolSize = 4;
+    static constexpr size_t kMaxPoolBytes = kMaxPoolSize * sizeof(ServiceStateMachine);
+    static constexpr size_t kMaxObjectBytes = sizeof(ServiceStateMachine);
+    static constexpr size_t kMaxDepotSize = 64;
+
+    static size_t retainedBytes(const ServiceStateMachine& ssm) {
+        return sizeof(ServiceStateMachine);
+    }
+};
+
 namespace {
 // Set up proper headers for formatting an exhaust request, if we need to
 bool setExhaustMessage(Message* m, const DbResponse& dbresponse) {
@@ -267,6 +285,7 @@ void ServiceStateMachine::reset(ServiceContext* svcContext,
     _serviceContext = svcContext;
     _serviceExecutor = _serviceContext->getServiceExecutor();
     _sessionHandle = session;
+    _readAhead = boost::none;
     // _threadName = str::stream() << "conn" << _session()->id();
     _dbClient = svcContext->makeClient(_threadName, std::move(session), this);
     _dbClientPtr = _dbClient.get();
@@ -287,6 +306,12 @@ void ServiceStateMachine::_sourceMessage(ThreadGuard guard) {
     guard.release();
 
     auto sourceMsgImpl = [&] {
+        if (_readAhead) {
+            auto readAhead = std::move(*_readAhead);
+            _readAhead = boost::none;
+            return readAhead;
+        }
+
         if (_transportMode == transport::Mode::kSynchronous) {
             MONGO_IDLE_THREAD_BLOCK;
             return Future<Message>::makeReady(_session()->sourceMessage());
@@ -305,6 +330,16 @@ void ServiceStateMachine::_sourceMessage(ThreadGuard guard) {
     });
 }
 
+void ServiceStateMachine::_startReadAhead() {
+    if (_readAhead || !serverGlobalParams.pipelineReadAhead ||
+        _transportMode != transport::Mode::kAsynchronous || !_session()->supportsReadAhead()) {
+        return;
+    }
+
+    MONGO_LOG(1) << "ServiceStateMachine::_startReadAhead";
+    _readAhead.emplace(_session()->asyncSourceMessage());
+}
+
 void ServiceStateMachine::_sinkMessage(ThreadGuard guard, Message toSink) {
     MONGO_LOG(1) << "ServiceStateMachine::_sinkMessage";
     // Sink our response to the client
@@ -339,6 +374,7 @@ void ServiceStateMachine::_sourceCallback(Status status) {
 
     if (status.isOK()) {
         _state.store(State::Process);
+        _startReadAhead();
 
         // Since we know that we're going to process a message, call scheduleNext() immediately
         // to schedule the call to processMessage() on the serviceExecutor (or just unwind the
@@ -535,10 +571,12 @@ void ServiceStateMachine::_runNextInGuard(ThreadGuard guard) {
                             }
                         };
 
-                        _coroResume = _serviceExecutor->coroutineResumeFunctor(
-                            _threadGroupId.load(std::memory_order_relaxed), _resumeTask);
-                        _coroLongResume = _serviceExecutor->coroutineLongResumeFunctor(
-                            _threadGroupId.load(std::memory_order_relaxed), _resumeTask);
+                        _coroResume =
+                            _timedResumeFunctor(_serviceExecutor->coroutineResumeFunctor(
+                                _threadGroupId.load(std::memory_order_relaxed), _resumeTask));
+                        _coroLongResume =
+                            _timedResumeFunctor(_serviceExecutor->coroutineLongResumeFunctor(
+                                _threadGroupId.load(std::memory_order_relaxed), _resumeTask));
 
                         boost::context::stack_context sc = coroStackContext();
                         boost::context::preallocated prealloc(sc.sp, sc.size, sc);
@@ -549,9 +587,11 @@ void ServiceStateMachine::_runNextInGuard(ThreadGuard guard) {
                             [this, &guard](boost::context::continuation&& sink) {
                                 _coroYield = [this, &sink]() {
                                     MONGO_LOG(3) << "call yield";
+                                    const auto yieldedAt = coroClockMicros();
                                     _dbClient = Client::releaseCurrent();
                                     abortIfStackOverflow();
                                     sink = sink.resume();
+                                    _recordCoroutineWait(yieldedAt);
                                 };
                                 _processMessage(std::move(guard));
                                 abortIfStackOverflow();
@@ -617,6 +657,33 @@ void ServiceStateMachine::_runResumeProcess() {
     }
 }
 
+std::function<void()> ServiceStateMachine::_timedResumeFunctor(std::function<void()> resume) {
+    return [this, resume = std::move(resume)] {
+        _resumeRequestedAt.store(coroClockMicros(), std::memory_order_release);
+        resume();
+    };
+}
+
+void ServiceStateMachine::_recordCoroutineWait(int64_t yieldedAt) {
+    const auto runningAt = coroClockMicros();
+    if (!haveClient()) {
+        return;
+    }
+    auto opCtx = Client::getCurrent()->getOperationContext();
+    if (!opCtx) {
+        return;
+    }
+
+    // The resume may have been requested before the coroutine actually yielded, e.g. when the tx
+    // service finished the request right away or for a long resume.
+    const auto resumeRequestedAt = _resumeRequestedAt.load(std::memory_order_acquire);
+    const auto resumableAt = std::min(runningAt, std::max(yieldedAt, resumeRequestedAt));
+    auto& waitStats = opCtx->coroutineWaitStats();
+    waitStats.record(waitStats.waitType,
+                     Microseconds(resumableAt - yieldedAt),
+                     Microseconds(runningAt - resumableAt));
+}
+
 void ServiceStateMachine::start(Ownership ownershipModel) {
     MONGO_LOG(1) << "ServiceStateMachine::start";
     _scheduleNextWithGuard(ThreadGuard(this),
@@ -706,8 +773,10 @@ void ServiceStateMachine::setThreadGroupId(size_t id) {
 void ServiceStateMachine::migrateThreadGroup(uint16_t threadGroupId) {
     dassert(_owned.loadRelaxed() == Ownership::kOwned);
     _threadGroupId.store(threadGroupId, std::memory_order_relaxed);
-    _coroResume = _serviceExecutor->coroutineResumeFunctor(threadGroupId, _resumeTask);
-    _coroLongResume = _serviceExecutor->coroutineLongResumeFunctor(threadGroupId, _resumeTask);
+    _coroResume =
+        _timedResumeFunctor(_serviceExecutor->coroutineResumeFunctor(threadGroupId, _resumeTask));
+    _coroLongResume = _timedResumeFunctor(
+        _serviceExecutor->coroutineLongResumeFunctor(threadGroupId, _resumeTask));
     _migrating.store(true, std::memory_order_relaxed);
     _coroResume();
     _coroYield();
@@ -733,6 +802,14 @@ void ServiceStateMachine::_cleanupSession(ThreadGuard guard) {
 
     _inMessage.reset();
 
+    if (_readAhead) {
+        // Nobody is going to consume the next request. End the session so the outstanding read
+        // fails promptly, and keep the session alive until it has.
+        _session()->end();
+        std::move(*_readAhead).getAsync([session = _sessionHandle](StatusWith<Message>) {});
+        _readAhead = boost::none;
+    }
+
     // By ignoring the return value of Client::releaseCurrent() we destroy the session.
     // _dbClient is now nullptr and _dbClientPtr is invalid and should never be accessed.
     Client::releaseCurrent();
@@ -32,6 +32,7 @@
 #include <boost/context/continuation.hpp>
 #include <boost/context/continuation_fcontext.hpp>
 #include <boost/context/stack_context.hpp>
+#include <chrono>
 #include <functional>
 
 #include "boost/optional/optional.hpp"
@@ -212,6 +213,24 @@ private:
 
     void _runResumeProcess();
 
+    /*
+     * Wraps a coroutine resume functor so that it records when the coroutine became resumable.
+     */
+    std::function<void()> _timedResumeFunctor(std::function<void()> resume);
+
+    /*
+     * Called on the coroutine once it runs again after a yield at 'yieldedAt'. Splits the time it
+     * was suspended into waiting on the tx service and waiting in the ThreadGroup queue, and adds
+     * it to the current operation's CoroutineWaitStats.
+     */
+    void _recordCoroutineWait(int64_t yieldedAt);
+
+    static int64_t coroClockMicros() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
     /*
      * This function actually calls into the database and processes a request. It's broken out
      * into its own inline function for better readability.
@@ -231,6 +250,13 @@ private:
     void _sourceMessage(ThreadGuard guard);
     void _sinkMessage(ThreadGuard guard, Message toSink);
 
+    /*
+     * Starts sourcing the next Message from the client while the current one is processed, so
+     * that pipelined requests (e.g. a stream of moreToCome writes) are already parsed by the time
+     * the state machine returns to Source. The next _sourceMessage() consumes the result.
+     */
+    void _startReadAhead();
+
     /*
      * Releases all the resources associated with the session and call the cleanupHook.
      */
@@ -255,6 +281,7 @@ private:
     bool _inExhaust = false;
     boost::optional<MessageCompressorId> _compressorId;
     Message _inMessage;
+    boost::optional<Future<Message>> _readAhead;
 
     AtomicWord<Ownership> _owned{Ownership::kUnowned};
 #if MONGO_CONFIG_DEBUG_BUILD
@@ -325,6 +352,7 @@ private:
     std::function<void()> _coroLongResume;
     std::function<void()> _resumeTask;
     std::atomic<bool> _migrating{false};
+    std::atomic<int64_t> _resumeRequestedAt{0};
     std::atomic<uint16_t> _threadGroupId{0};
 };
 
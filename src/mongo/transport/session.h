@@ -116,6 +116,15 @@ public:
     virtual Future<void> asyncSinkMessage(Message message,
                                           const transport::BatonHandle& handle = nullptr) = 0;
 
+    /**
+     * Returns true if an asyncSourceMessage() may be left outstanding while Messages are sunk
+     * from another thread. Callers use this to read the next request while the current one is
+     * still being processed.
+     */
+    virtual bool supportsReadAhead() const {
+        return false;
+    }
+
     /**
      * Cancel any outstanding async operations. There is no way to cancel synchronous calls.
      * Futures will finish with an ErrorCodes::CallbackCancelled error if they haven't already
@@ -34,6 +34,7 @@
 #include "mongo/base/system_error.h"
 #include "mongo/config.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/transport/asio_utils.h"
 #include "mongo/transport/baton.h"
 #include "mongo/transport/transport_layer_asio.h"
@@ -158,6 +159,17 @@ public:
             });
     }
 
+    bool supportsReadAhead() const override {
+#ifdef MONGO_CONFIG_SSL
+        // A TLS stream shares its state between the read and write sides, and the first read
+        // may still upgrade the socket to TLS.
+        if (_sslSocket || !_ranHandshake.load()) {
+            return false;
+        }
+#endif
+        return _blockingMode == Async;
+    }
+
     void cancelAsyncOperations(const transport::BatonHandle& baton = nullptr) override {
         LOG(3) << "Cancelling outstanding I/O operations on connection to " << _remote;
         if (baton) {
@@ -232,7 +244,7 @@ protected:
             }
         };
         return doHandshake().then([this, target] {
-            _ranHandshake = true;
+            _ranHandshake.store(true);
 
             auto sslManager = getSSLManager();
             auto swPeerInfo = uassertStatusOK(sslManager->parseAndValidatePeerCertificate(
@@ -390,12 +402,12 @@ private:
 #ifdef MONGO_CONFIG_SSL
         if (_sslSocket) {
             return opportunisticRead(*_sslSocket, buffers, baton);
-        } else if (!_ranHandshake) {
+        } else if (!_ranHandshake.load()) {
             invariant(asio::buffer_size(buffers) >= sizeof(MSGHEADER::Value));
 
             return opportunisticRead(_socket, buffers, baton)
                 .then([this, buffers]() mutable {
-                    _ranHandshake = true;
+                    _ranHandshake.store(true);
                     return maybeHandshakeSSLForIngress(buffers);
                 })
                 .then([this, buffers, baton](bool needsRead) mutable {
@@ -414,7 +426,7 @@ private:
     Future<void> write(const ConstBufferSequence& buffers,
                        const transport::BatonHandle& baton = nullptr) {
 #ifdef MONGO_CONFIG_SSL
-        _ranHandshake = true;
+        _ranHandshake.store(true);
         if (_sslSocket) {
 #ifdef __linux__
             // We do some trickery in asio (see moreToSend), which appears to work well on linux,
@@ -704,7 +716,8 @@ private:
     GenericSocket _socket;
 #ifdef MONGO_CONFIG_SSL
     boost::optional<asio::ssl::stream<decltype(_socket)>> _sslSocket;
-    bool _ranHandshake = false;
+    // Read by supportsReadAhead() while a write may set it on another thread.
+    AtomicBool _ranHandshake{false};
 #endif
 
     TransportLayerASIO* const _tl;
@@ -28,7 +28,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <boost/intrusive_ptr.hpp>
+#include <cstring>
 
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/allocator.h"
@@ -51,6 +53,15 @@ public:
         return takeOwnership(mongoMalloc(sizeof(Holder) + bytes), bytes);
     }
 
+    /**
+     * Like allocate(), but rounds 'bytes' up to a SharedBufferPool size class and reuses memory
+     * cached by the calling thread. The memory goes back to the cache of whichever thread drops
+     * the last reference. Requests larger than the biggest size class fall back to allocate().
+     *
+     * Defined in shared_buffer_pool.cpp.
+     */
+    static SharedBuffer allocatePooled(size_t bytes);
+
     /**
      * Resizes the buffer, copying the current contents.
      *
@@ -62,6 +73,14 @@ public:
     void realloc(size_t size) {
         invariant(!_holder || !_holder->isShared());
 
+        if (_holder && _holder->_pooled) {
+            // Pooled memory has a fixed size class and cannot be handed to ::realloc().
+            auto tmp = SharedBuffer::allocatePooled(size);
+            memcpy(tmp.get(), get(), std::min<size_t>(size, capacity()));
+            swap(tmp);
+            return;
+        }
+
         const size_t realSize = size + sizeof(Holder);
         void* newPtr = mongoRealloc(_holder.get(), realSize);
 
@@ -99,8 +118,8 @@ public:
 private:
     class Holder {
     public:
-        explicit Holder(AtomicUInt32::WordType initial, size_t capacity)
-            : _refCount(initial), _capacity(capacity) {
+        explicit Holder(AtomicUInt32::WordType initial, size_t capacity, bool pooled = false)
+            : _refCount(initial), _capacity(capacity), _pooled(pooled) {
             invariant(capacity == _capacity);
         }
 
@@ -111,10 +130,7 @@ private:
 
         friend void intrusive_ptr_release(Holder* h) {
             if (h->_refCount.subtractAndFetch(1) == 0) {
-                // We placement new'ed a Holder in takeOwnership above,
-                // so we must destroy the object here.
-                h->~Holder();
-                free(h);
+                h->_destroy();
             }
         }
 
@@ -130,8 +146,25 @@ private:
             return _refCount.load() > 1;
         }
 
+        void _destroy() {
+            const bool pooled = _pooled;
+            const size_t capacity = _capacity;
+
+            // We placement new'ed a Holder in takeOwnership above,
+            // so we must destroy the object here.
+            this->~Holder();
+            if (pooled) {
+                SharedBuffer::releasePooled(this, capacity);
+            } else {
+                free(this);
+            }
+        }
+
         AtomicUInt32 _refCount;
-        uint32_t _capacity;
+        // Buffers are bounded by BufferMaxSize, so the top bit is free to tag pooled memory
+        // without growing the Holder prefix.
+        uint32_t _capacity : 31;
+        uint32_t _pooled : 1;
     };
 
     explicit SharedBuffer(Holder* holder) : _holder(holder, /*add_ref=*/false) {
@@ -146,14 +179,24 @@ private:
      * This class will call free(holderPrefixedData), so it must have been allocated in a way
      * that makes that valid.
      */
-    static SharedBuffer takeOwnership(void* holderPrefixedData, size_t capacity) {
+    static SharedBuffer takeOwnership(void* holderPrefixedData,
+                                      size_t capacity,
+                                      bool pooled = false) {
         // Initialize the refcount to 1 so we don't need to increment it in the constructor
         // (see private Holder* constructor above).
         //
         // TODO: Should dassert alignment of holderPrefixedData here if possible.
-        return SharedBuffer(new (holderPrefixedData) Holder(1U, capacity));
+        return SharedBuffer(new (holderPrefixedData) Holder(1U, capacity, pooled));
     }
 
+    /**
+     * Returns holder-prefixed memory obtained through allocatePooled() to the calling thread's
+     * SharedBufferPool cache. Defined in shared_buffer_pool.cpp.
+     */
+    static void releasePooled(void* holderPrefixedData, size_t capacity);
+
+    friend class SharedBufferPool;
+
     boost::intrusive_ptr<Holder> _holder;
 };
 
@@ -0,0 +1,190 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/shared_buffer_pool.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+namespace {
+
+AtomicUInt64 poolHits;
+AtomicUInt64 poolMisses;
+AtomicUInt64 poolReturned;
+AtomicUInt64 poolFreed;
+AtomicInt64 poolCachedBytes;
+
+// Set once the thread's ThreadCache is destroyed. Buffers can still be released after that by
+// the destructors of other thread_local objects, which then free them directly. A bool needs no
+// destruction, so it can be read until the thread exits.
+thread_local bool threadCacheDestroyed = false;
+
+class ThreadCache {
+public:
+    ~ThreadCache() {
+        threadCacheDestroyed = true;
+        clear();
+    }
+
+    void* pop(size_t sizeClass) {
+        auto& freeList = _freeLists[sizeClass];
+        if (freeList.empty()) {
+            return nullptr;
+        }
+        void* mem = freeList.back();
+        freeList.pop_back();
+        _cachedBytes -= SharedBufferPool::classSize(sizeClass);
+        poolCachedBytes.subtractAndFetch(SharedBufferPool::classSize(sizeClass));
+        return mem;
+    }
+
+    bool push(size_t sizeClass, void* mem) {
+        auto& freeList = _freeLists[sizeClass];
+        const size_t size = SharedBufferPool::classSize(sizeClass);
+        if ((freeList.size() + 1) * size > SharedBufferPool::kMaxCachedBytesPerClass ||
+            _cachedBytes + size > SharedBufferPool::kMaxCachedBytesPerThread) {
+            return false;
+        }
+        freeList.push_back(mem);
+        _cachedBytes += size;
+        poolCachedBytes.addAndFetch(size);
+        return true;
+    }
+
+    void clear() {
+        for (size_t sizeClass = 0; sizeClass < SharedBufferPool::kNumClasses; ++sizeClass) {
+            auto& freeList = _freeLists[sizeClass];
+            for (void* mem : freeList) {
+                free(mem);
+            }
+            poolCachedBytes.subtractAndFetch(SharedBufferPool::classSize(sizeClass) *
+                                             freeList.size());
+            freeList.clear();
+        }
+        _cachedBytes = 0;
+    }
+
+private:
+    std::array<std::vector<void*>, SharedBufferPool::kNumClasses> _freeLists;
+    size_t _cachedBytes = 0;
+};
+
+thread_local ThreadCache threadCache;
+
+// Replies on a thread tend to come in runs of similar size (e.g. a stream of getMores), so the
+// estimate follows growth immediately and decays slowly for replies close to it, to avoid
+// thrashing between classes.
+thread_local size_t replySizeEstimate = 0;
+
+}  // namespace
+
+size_t SharedBufferPool::sizeClassFor(size_t bytes) {
+    size_t sizeClass = 0;
+    size_t size = kMinClassSize;
+    while (size < bytes && sizeClass < kNumClasses) {
+        size <<= 1;
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+SharedBuffer SharedBufferPool::acquire(size_t bytes) {
+    const size_t sizeClass = sizeClassFor(bytes);
+    if (sizeClass >= kNumClasses) {
+        return SharedBuffer::allocate(bytes);
+    }
+
+    const size_t capacity = classSize(sizeClass);
+    void* mem = threadCacheDestroyed ? nullptr : threadCache.pop(sizeClass);
+    if (mem) {
+        poolHits.fetchAndAdd(1);
+    } else {
+        poolMisses.fetchAndAdd(1);
+        mem = mongoMalloc(sizeof(SharedBuffer::Holder) + capacity);
+    }
+    return SharedBuffer::takeOwnership(mem, capacity, true);
+}
+
+void SharedBufferPool::release(void* holderPrefixedData, size_t capacity) {
+    const size_t sizeClass = sizeClassFor(capacity);
+    dassert(sizeClass < kNumClasses && classSize(sizeClass) == capacity);
+    if (!threadCacheDestroyed && threadCache.push(sizeClass, holderPrefixedData)) {
+        poolReturned.fetchAndAdd(1);
+    } else {
+        poolFreed.fetchAndAdd(1);
+        free(holderPrefixedData);
+    }
+}
+
+void SharedBufferPool::clearThreadCache() {
+    if (!threadCacheDestroyed) {
+        threadCache.clear();
+    }
+}
+
+SharedBufferPool::Stats SharedBufferPool::getStats() {
+    Stats stats;
+    stats.hits = poolHits.load();
+    stats.misses = poolMisses.load();
+    stats.returned = poolReturned.load();
+    stats.freed = poolFreed.load();
+    stats.cachedBytes = poolCachedBytes.load();
+    return stats;
+}
+
+void SharedBufferPool::appendStats(BSONObjBuilder* bob) {
+    auto stats = getStats();
+    BSONObjBuilder section(bob->subobjStart("replyBufferPool"));
+    section.appendNumber("hits", static_cast<long long>(stats.hits));
+    section.appendNumber("misses", static_cast<long long>(stats.misses));
+    section.appendNumber("returned", static_cast<long long>(stats.returned));
+    section.appendNumber("freed", static_cast<long long>(stats.freed));
+    section.appendNumber("cachedBytes", static_cast<long long>(stats.cachedBytes));
+    section.doneFast();
+}
+
+size_t ReplySizeEstimator::estimate() {
+    return replySizeEstimate;
+}
+
+void ReplySizeEstimator::record(size_t replySize) {
+    replySize = std::min(replySize, kMaxEstimate);
+    if (replySize >= replySizeEstimate) {
+        replySizeEstimate = replySize;
+    } else if (replySize < replySizeEstimate / 4) {
+        replySizeEstimate = std::max(replySize, replySizeEstimate / 2);
+    } else {
+        replySizeEstimate -= (replySizeEstimate - replySize) / 8;
+    }
+}
+
+SharedBuffer SharedBuffer::allocatePooled(size_t bytes) {
+    return SharedBufferPool::acquire(bytes);
+}
+
+void SharedBuffer::releasePooled(void* holderPrefixedData, size_t capacity) {
+    SharedBufferPool::release(holderPrefixedData, capacity);
+}
+
+}  // namespace mongo
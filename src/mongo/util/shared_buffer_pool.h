@@ -0,0 +1,102 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "mongo/util/shared_buffer.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * Thread-local free lists of SharedBuffer memory in power-of-two size classes, used for
+ * short-lived buffers such as OP_MSG replies that would otherwise be malloc'ed, grown by
+ * doubling and freed on every request.
+ *
+ * Under the coroutine service executor each ThreadGroup is bound to one thread, so the cache
+ * of that thread acts as the ThreadGroup's pool. Memory is returned to the cache of whichever
+ * thread releases the last reference; every cache is bounded so that a burst of large replies
+ * does not pin memory on a thread.
+ */
+class SharedBufferPool {
+public:
+    static constexpr size_t kMinClassSize = 4 * 1024;
+    static constexpr size_t kMaxClassSize = 16 * 1024 * 1024;
+    static constexpr size_t kNumClasses = 13;  // 4KB, 8KB, ..., 16MB
+
+    // Upper bounds on the memory a single thread keeps cached, in one size class and in total.
+    // Buffers of the classes above kMaxCachedBytesPerClass are never cached; replies that large
+    // are rare and are better served by malloc than by pinning them on every thread.
+    static constexpr size_t kMaxCachedBytesPerClass = 4 * 1024 * 1024;
+    static constexpr size_t kMaxCachedBytesPerThread = 8 * 1024 * 1024;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t returned = 0;
+        uint64_t freed = 0;
+        int64_t cachedBytes = 0;
+    };
+
+    /**
+     * Returns the index of the smallest size class that holds 'bytes', or kNumClasses if
+     * 'bytes' is larger than kMaxClassSize.
+     */
+    static size_t sizeClassFor(size_t bytes);
+
+    static size_t classSize(size_t sizeClass) {
+        return kMinClassSize << sizeClass;
+    }
+
+    /**
+     * Frees every buffer cached by the calling thread.
+     */
+    static void clearThreadCache();
+
+    static Stats getStats();
+    static void appendStats(BSONObjBuilder* bob);
+
+private:
+    friend class SharedBuffer;
+
+    static SharedBuffer acquire(size_t bytes);
+    static void release(void* holderPrefixedData, size_t capacity);
+};
+
+/**
+ * Tracks the size of recent replies built on the calling thread so that reply builders can
+ * start with a buffer from the right size class instead of growing one by doubling.
+ *
+ * The estimate never exceeds kMaxEstimate, so a single huge reply cannot make the following
+ * small replies on the thread start from multi-megabyte buffers; replies above it grow from
+ * there. A reply far below the estimate halves it, so it recovers after a few requests.
+ */
+class ReplySizeEstimator {
+public:
+    static constexpr size_t kMaxEstimate = 1024 * 1024;
+
+    static size_t estimate();
+    static void record(size_t replySize);
+};
+
+}  // namespace mongo
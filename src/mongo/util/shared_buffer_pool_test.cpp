@@ -0,0 +1,204 @@
+/**
+ *    Copyright (C) 2025 EloqData Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the license:
+ *    1. GNU Affero General Public License, version 3, as published by the Free
+ *    Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <cstring>
+#include <vector>
+
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/shared_buffer_pool.h"
+
+namespace mongo {
+namespace {
+
+class SharedBufferPoolTest : public unittest::Test {
+protected:
+    void setUp() override {
+        SharedBufferPool::clearThreadCache();
+    }
+
+    void tearDown() override {
+        SharedBufferPool::clearThreadCache();
+    }
+};
+
+TEST_F(SharedBufferPoolTest, SizeClasses) {
+    ASSERT_EQ(SharedBufferPool::sizeClassFor(0), 0U);
+    ASSERT_EQ(SharedBufferPool::sizeClassFor(1), 0U);
+    ASSERT_EQ(SharedBufferPool::sizeClassFor(SharedBufferPool::kMinClassSize), 0U);
+    ASSERT_EQ(SharedBufferPool::sizeClassFor(SharedBufferPool::kMinClassSize + 1), 1U);
+    ASSERT_EQ(SharedBufferPool::sizeClassFor(SharedBufferPool::kMaxClassSize),
+              SharedBufferPool::kNumClasses - 1);
+    ASSERT_EQ(SharedBufferPool::sizeClassFor(SharedBufferPool::kMaxClassSize + 1),
+              SharedBufferPool::kNumClasses);
+    ASSERT_EQ(SharedBufferPool::classSize(SharedBufferPool::kNumClasses - 1),
+              SharedBufferPool::kMaxClassSize);
+}
+
+TEST_F(SharedBufferPoolTest, ReleasedBufferIsReused) {
+    auto before = SharedBufferPool::getStats();
+
+    const char* firstData;
+    {
+        auto buf = SharedBuffer::allocatePooled(1000);
+        ASSERT_EQ(buf.capacity(), SharedBufferPool::kMinClassSize);
+        firstData = buf.get();
+    }
+
+    auto buf = SharedBuffer::allocatePooled(2000);
+    ASSERT_EQ(buf.get(), firstData);
+
+    auto after = SharedBufferPool::getStats();
+    ASSERT_EQ(after.misses - before.misses, 1U);
+    ASSERT_EQ(after.hits - before.hits, 1U);
+    ASSERT_EQ(after.returned - before.returned, 1U);
+}
+
+TEST_F(SharedBufferPoolTest, SharedReferencesKeepBufferAlive) {
+    auto buf = SharedBuffer::allocatePooled(100);
+    std::strcpy(buf.get(), "pooled");
+    {
+        SharedBuffer copy = buf;
+        ASSERT_TRUE(copy.isShared());
+    }
+    ASSERT_FALSE(buf.isShared());
+
+    auto other = SharedBuffer::allocatePooled(100);
+    ASSERT_NOT_EQUALS(other.get(), buf.get());
+    ASSERT_EQ(std::string(buf.get()), "pooled");
+}
+
+TEST_F(SharedBufferPoolTest, ReallocPreservesContents) {
+    auto buf = SharedBuffer::allocatePooled(16);
+    std::memcpy(buf.get(), "0123456789abcdef", 16);
+
+    buf.realloc(3 * SharedBufferPool::kMinClassSize);
+    ASSERT_EQ(buf.capacity(), 4 * SharedBufferPool::kMinClassSize);
+    ASSERT_EQ(std::memcmp(buf.get(), "0123456789abcdef", 16), 0);
+}
+
+TEST_F(SharedBufferPoolTest, OversizedRequestsBypassPool) {
+    auto before = SharedBufferPool::getStats();
+    {
+        auto buf = SharedBuffer::allocatePooled(SharedBufferPool::kMaxClassSize + 1);
+        ASSERT_EQ(buf.capacity(), SharedBufferPool::kMaxClassSize + 1);
+    }
+    auto after = SharedBufferPool::getStats();
+    ASSERT_EQ(after.hits, before.hits);
+    ASSERT_EQ(after.misses, before.misses);
+    ASSERT_EQ(after.returned, before.returned);
+}
+
+TEST_F(SharedBufferPoolTest, PerClassCacheIsBounded) {
+    const size_t size = SharedBufferPool::kMaxCachedBytesPerClass / 2;
+    auto before = SharedBufferPool::getStats();
+    {
+        auto a = SharedBuffer::allocatePooled(size);
+        auto b = SharedBuffer::allocatePooled(size);
+        auto c = SharedBuffer::allocatePooled(size);
+    }
+    auto after = SharedBufferPool::getStats();
+    ASSERT_EQ(after.returned - before.returned, 2U);
+    ASSERT_EQ(after.freed - before.freed, 1U);
+}
+
+TEST_F(SharedBufferPoolTest, ClassesAbovePerClassBoundAreNotCached) {
+    auto before = SharedBufferPool::getStats();
+    { auto buf = SharedBuffer::allocatePooled(SharedBufferPool::kMaxClassSize); }
+    auto after = SharedBufferPool::getStats();
+    ASSERT_EQ(after.returned, before.returned);
+    ASSERT_EQ(after.freed - before.freed, 1U);
+}
+
+TEST_F(SharedBufferPoolTest, PerThreadCacheIsBounded) {
+    const size_t perClass = SharedBufferPool::kMaxCachedBytesPerClass;
+    auto before = SharedBufferPool::getStats();
+    {
+        // Fill two classes up to their own bound, which reaches the per-thread bound.
+        std::vector<SharedBuffer> buffers;
+        buffers.push_back(SharedBuffer::allocatePooled(perClass));
+        buffers.push_back(SharedBuffer::allocatePooled(perClass / 2));
+        buffers.push_back(SharedBuffer::allocatePooled(perClass / 2));
+        buffers.push_back(SharedBuffer::allocatePooled(perClass / 4));
+    }
+    auto after = SharedBufferPool::getStats();
+    static_assert(SharedBufferPool::kMaxCachedBytesPerThread ==
+                      2 * SharedBufferPool::kMaxCachedBytesPerClass,
+                  "test assumes the thread holds two full classes");
+    ASSERT_EQ(after.returned - before.returned, 3U);
+    ASSERT_EQ(after.freed - before.freed, 1U);
+}
+
+TEST_F(SharedBufferPoolTest, ClearThreadCacheReleasesMemory) {
+    { auto buf = SharedBuffer::allocatePooled(100); }
+    SharedBufferPool::clearThreadCache();
+
+    auto before = SharedBufferPool::getStats();
+    auto buf = SharedBuffer::allocatePooled(100);
+    auto after = SharedBufferPool::getStats();
+    ASSERT_EQ(after.misses - before.misses, 1U);
+    ASSERT_EQ(after.hits, before.hits);
+}
+
+TEST_F(SharedBufferPoolTest, ReleaseAfterThreadCacheIsDestroyedFreesBuffer) {
+    auto before = SharedBufferPool::getStats();
+
+    stdx::thread thread([] {
+        // Constructed before the thread cache, so destroyed after it when the thread exits.
+        thread_local SharedBuffer lateReleased;
+        lateReleased = SharedBuffer::allocatePooled(100);
+    });
+    thread.join();
+
+    auto after = SharedBufferPool::getStats();
+    ASSERT_EQ(after.freed - before.freed, 1U);
+    ASSERT_EQ(after.returned - before.returned, 0U);
+    ASSERT_EQ(after.cachedBytes, before.cachedBytes);
+}
+
+TEST(ReplySizeEstimatorTest, FollowsGrowthAndDecaysSlowly) {
+    ReplySizeEstimator::record(512 * 1024);
+    ASSERT_EQ(ReplySizeEstimator::estimate(), size_t(512 * 1024));
+
+    ReplySizeEstimator::record(256 * 1024);
+    auto decayed = ReplySizeEstimator::estimate();
+    ASSERT_LT(decayed, size_t(512 * 1024));
+    ASSERT_GT(decayed, size_t(256 * 1024));
+
+    ReplySizeEstimator::record(1024 * 1024);
+    ASSERT_EQ(ReplySizeEstimator::estimate(), size_t(1024 * 1024));
+}
+
+TEST(ReplySizeEstimatorTest, LargeReplyIsClampedAndSmallRepliesRecoverQuickly) {
+    ReplySizeEstimator::record(16 * 1024 * 1024);
+    ASSERT_EQ(ReplySizeEstimator::estimate(), ReplySizeEstimator::kMaxEstimate);
+
+    // Each tiny reply halves the estimate, so it is back to the smallest class within a few
+    // requests rather than after dozens.
+    int replies = 0;
+    while (ReplySizeEstimator::estimate() > SharedBufferPool::kMinClassSize) {
+        ReplySizeEstimator::record(200);
+        ++replies;
+    }
+    ASSERT_LTE(replies, 10);
+}
+
+}  // namespace
+}  // namespace mongo